@@ -6,6 +6,8 @@
 #include "dao/user_dao.h"
 #include "model/payment.h"
 #include "model/payment_order.h"
+#include "service/payment_item_cache.h"
+#include "util/id_generator.h"
 #include "core/logger.h"
 #include <string>
 #include <vector>
@@ -24,7 +26,7 @@ public:
         std::string user_id;           // 用户ID
         std::string payment_type;      // 待缴类型（水费/电费等）
         std::string item_id;           // 缴费项目ID
-        double amount;                 // 金额
+        Money amount;                  // 金额
         std::string status;            // 会话状态（waiting_type/waiting_confirm/completed）
         int64_t create_time;           // 创建时间
         int64_t expire_time;           // 过期时间（3分钟）
@@ -95,7 +97,8 @@ public:
     static std::string QueryUnpaidItemsByVoice(const std::string& user_id) {
         try {
             // 查询用户所有待缴费项目
-            std::vector<PaymentItem> unpaid_items = PaymentDao::QueryUserAllUnpaidItems(user_id);
+            PaymentItemCache::SnapshotPtr snapshot = PaymentService::LoadUserPaymentItems(user_id);
+            const std::vector<PaymentItem>& unpaid_items = snapshot->unpaid;
             
             if (unpaid_items.empty()) {
                 return "您当前没有待缴费用，真棒！";
@@ -146,7 +149,8 @@ private:
         }
 
         // 2. 查询用户待缴费项目
-        std::vector<PaymentItem> unpaid_items = PaymentDao::QueryUserAllUnpaidItems(user_id);
+        PaymentItemCache::SnapshotPtr snapshot = PaymentService::LoadUserPaymentItems(user_id);
+        const std::vector<PaymentItem>& unpaid_items = snapshot->unpaid;
         if (unpaid_items.empty()) {
             response.reply_text = "您当前没有待缴费用";
             response.next_action = "complete";
@@ -295,11 +299,7 @@ private:
      * 辅助函数：生成会话ID
      */
     static std::string GenerateSessionId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(100000, 999999);
-        return fmt::format("VOICE_PAY_SESSION{}{}", 
-            TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("VOICE_PAY_SESSION");
     }
 
     /**
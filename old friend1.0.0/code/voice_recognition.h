@@ -7,6 +7,7 @@
 #include <map>
 #include "util/http_client.h"
 #include "util/json_util.h"
+#include "util/money.h"
 #include "core/logger.h"
 
 /**
@@ -111,7 +112,7 @@ public:
     struct PaymentIntent {
         bool is_payment;               // 是否为支付意图
         std::string payment_type;      // 缴费类型（水费/电费/网费/话费）
-        double amount;                 // 金额（0表示未提及）
+        Money amount;                  // 金额（0表示未提及）
         bool is_confirm;               // 是否为确认指令
         std::string original_text;     // 原始文本
     };
@@ -119,7 +120,7 @@ public:
     static PaymentIntent ExtractPaymentIntent(const std::string& text) {
         PaymentIntent intent;
         intent.is_payment = false;
-        intent.amount = 0.0;
+        intent.amount = Money();
         intent.is_confirm = false;
         intent.original_text = text;
 
@@ -156,10 +157,8 @@ public:
         std::regex amount_regex(R"((\d+\.?\d*)\s*元)");
         std::smatch match;
         if (std::regex_search(text, match, amount_regex)) {
-            try {
-                intent.amount = std::stod(match[1]);
-            } catch (...) {
-                intent.amount = 0.0;
+            if (!Money::Parse(match[1].str(), intent.amount)) {
+                intent.amount = Money(); // 超过两位小数等无法精确表示的金额视为未提及
             }
         }
 
@@ -199,6 +199,31 @@ CREATE TABLE HOSPITAL_INFO (
     INDEX idx_status(status)
 ) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COMMENT='医院信息表';
 
+-- 挂号号源表（医院+科室+就诊日期）
+DROP TABLE IF EXISTS HOSPITAL_QUOTA;
+CREATE TABLE HOSPITAL_QUOTA (
+    hospital_id VARCHAR(50) NOT NULL COMMENT '医院ID',
+    department VARCHAR(50) NOT NULL COMMENT '科室',
+    reserve_date VARCHAR(20) NOT NULL COMMENT '就诊日期（yyyy-MM-dd）',
+    total_quota INT NOT NULL COMMENT '总号源',
+    used_quota INT DEFAULT 0 COMMENT '已预约数量',
+    PRIMARY KEY (hospital_id, department, reserve_date),
+    FOREIGN KEY (hospital_id) REFERENCES HOSPITAL_INFO(hospital_id) ON DELETE CASCADE,
+    INDEX idx_reserve_date(reserve_date)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COMMENT='挂号号源表';
+
+-- 分时段号源模板表（医院+科室的各就诊时段容量，按 sort_no 先后分配）
+DROP TABLE IF EXISTS HOSPITAL_SLOT_TEMPLATE;
+CREATE TABLE HOSPITAL_SLOT_TEMPLATE (
+    hospital_id VARCHAR(50) NOT NULL COMMENT '医院ID',
+    department VARCHAR(50) NOT NULL COMMENT '科室',
+    period VARCHAR(50) NOT NULL COMMENT '就诊时段（如 上午 8:00-9:00）',
+    capacity INT NOT NULL COMMENT '时段容量',
+    sort_no INT DEFAULT 0 COMMENT '时段顺序',
+    PRIMARY KEY (hospital_id, department, period),
+    FOREIGN KEY (hospital_id) REFERENCES HOSPITAL_INFO(hospital_id) ON DELETE CASCADE
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COMMENT='分时段号源模板表';
+
 -- 预约挂号表
 DROP TABLE IF EXISTS RESERVE_ORDER;
 CREATE TABLE RESERVE_ORDER (
@@ -208,13 +233,19 @@ CREATE TABLE RESERVE_ORDER (
     hospital_name VARCHAR(100) NOT NULL COMMENT '医院名称',
     department VARCHAR(50) NOT NULL COMMENT '科室',
     reserve_date VARCHAR(20) NOT NULL COMMENT '预约日期（yyyy-MM-dd）',
+    reserve_period VARCHAR(50) DEFAULT '' COMMENT '就诊时段',
     status VARCHAR(20) DEFAULT '已预约' COMMENT '状态',
     create_time BIGINT NOT NULL COMMENT '创建时间',
+    cancel_time BIGINT DEFAULT 0 COMMENT '取消时间',
+    cancel_reason VARCHAR(200) DEFAULT '' COMMENT '取消原因',
+    is_quota_recovered TINYINT DEFAULT 0 COMMENT '号源是否已归还（防止重复归还）',
     FOREIGN KEY (user_id) REFERENCES USER_BASE(user_id) ON DELETE CASCADE,
     FOREIGN KEY (hospital_id) REFERENCES HOSPITAL_INFO(hospital_id) ON DELETE CASCADE,
     INDEX idx_user_id(user_id),
     INDEX idx_hospital_id(hospital_id),
-    INDEX idx_reserve_date(reserve_date)
+    INDEX idx_reserve_date(reserve_date),
+    INDEX idx_slot(hospital_id, department, reserve_date, reserve_period),
+    INDEX idx_status_date(status, reserve_date, order_id)
 ) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COMMENT='预约挂号表';
 
 -- =====================================================
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <inttypes.h>
+#include "util/money.h"
 
 /**
  * 缴费项目模型：存储用户绑定的水电燃气等缴费账号及账单信息
@@ -15,7 +16,7 @@ struct PaymentItem {
     std::string account;        // 缴费账号（如水电表号，明文存储但前端脱敏显示）
 
     // 2. 账单信息
-    double amount = 0.0;        // 待缴金额（保留2位小数，单位：元）
+    Money amount;               // 待缴金额（定点数，精确到分）
     std::string status;         // 状态（欠费/已缴清，与服务层常量一致）
     std::string due_date;       // 缴费截止日期（格式：yyyy-mm-dd，如 "2025-12-10"）
     std::string bill_month;     // 账单所属月份（如 "2025-10"，便于按月份查询）
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <inttypes.h>
+#include "util/money.h"
 
 /**
  * 支付订单模型：存储缴费支付的全流程信息
@@ -16,7 +17,7 @@ struct PaymentOrder {
 
     // 2. 支付基础信息
     std::string item_type;      // 缴费类型（冗余存储，避免关联查询）
-    double amount = 0.0;        // 支付金额（与缴费项目金额一致，单位：元）
+    Money amount;               // 支付金额（与缴费项目金额一致，定点数，精确到分）
     std::string pay_type;       // 支付方式（仅支持wechat，适配老年人习惯）
 
     // 3. 订单状态（核心字段，控制流程）
@@ -0,0 +1,50 @@
+#ifndef RESERVE_QUOTA_MODEL_H
+#define RESERVE_QUOTA_MODEL_H
+
+#include <string>
+
+/**
+ * 挂号配额模型：按 医院 + 科室 + 就诊日期 维护号源（对应 HOSPITAL_QUOTA 表）
+ */
+struct ReserveQuota {
+    std::string hospital_id;        // 医院ID（关联 Hospital 模型的 id）
+    std::string department;         // 科室（如 "内科"）
+    std::string reserve_date;       // 就诊日期（格式：yyyy-mm-dd）
+    int total_quota = 0;            // 当日总号源（未单独配置时取医院 daily_quota）
+    int used_quota = 0;             // 已预约数量（对账时按有效预约订单重新统计）
+};
+
+/**
+ * 配额增量（写回数据库用，正数为占用、负数为释放）
+ */
+struct ReserveQuotaDelta {
+    std::string hospital_id;
+    std::string department;
+    std::string reserve_date;
+    int used_delta = 0;
+};
+
+/**
+ * 时段占用增量（与订单同一事务写回，按 医院 + 科室 + 日期 + 时段 汇总）
+ */
+struct ReserveSlotDelta {
+    std::string hospital_id;
+    std::string department;
+    std::string reserve_date;
+    std::string period;
+    int used_delta = 0;
+};
+
+/**
+ * 就诊时段号源（对应 HOSPITAL_SLOT_TEMPLATE 表的时段容量 + 有效预约订单按时段统计的占用数）
+ */
+struct ReserveSlot {
+    std::string hospital_id;
+    std::string department;
+    std::string reserve_date;       // 就诊日期（格式：yyyy-mm-dd）
+    std::string period;             // 时段（与 ReserveOrder::reserve_period 一致，如 "上午 8:00-9:00"）
+    int capacity = 0;               // 时段容量
+    int used = 0;                   // 已预约数量
+};
+
+#endif // RESERVE_QUOTA_MODEL_H
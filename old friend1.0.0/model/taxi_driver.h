@@ -0,0 +1,32 @@
+#ifndef TAXI_DRIVER_MODEL_H
+#define TAXI_DRIVER_MODEL_H
+
+#include <string>
+#include <inttypes.h>
+#include "taxi_location.h"
+
+/**
+ * 司机模型：存储司机身份、车辆及接单状态，派单引擎据此筛选可接单司机
+ */
+struct TaxiDriver {
+    // 1. 核心标识
+    std::string driver_id;       // 司机唯一ID
+    std::string driver_name;     // 司机姓名（脱敏，如 "张师傅"）
+    std::string license_plate;   // 车牌号（脱敏，如 "沪A****12"）
+    std::string driver_phone;    // 司机手机号
+
+    // 2. 接单状态（核心字段，只有空闲司机会进入派单索引）
+    enum class DriverStatus {
+        OFFLINE = 0,     // 离线（未出车）
+        AVAILABLE = 1,   // 空闲（可接单）
+        BUSY = 2         // 服务中（已派单/行程中）
+    };
+    DriverStatus status = DriverStatus::OFFLINE;
+
+    // 3. 位置信息（司机端定时上报）
+    TaxiLocation location;       // 最近一次上报位置
+    int64_t location_time = 0;   // 位置上报时间戳
+    int64_t update_time = 0;     // 最后更新时间戳
+};
+
+#endif // TAXI_DRIVER_MODEL_H
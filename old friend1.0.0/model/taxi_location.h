@@ -3,7 +3,7 @@
 
 #include <string>
 #include <cmath>
-#define M_PI 3.14
+#include "util/geo_util.h"
 /**
  * 地理位置模型：存储经纬度、详细地址，提供距离计算辅助函数
  */
@@ -25,15 +25,8 @@ struct TaxiLocation {
      * @return 直线距离（保留1位小数）
      */
     double CalculateDistanceTo(const TaxiLocation& target) const {
-        const double R = 6371.0; // 地球半径（km）
-        double dLat = (target.latitude - latitude) * M_PI / 180.0;
-        double dLon = (target.longitude - longitude) * M_PI / 180.0;
-        
-        double a = sin(dLat / 2) * sin(dLat / 2) +
-                   cos(latitude * M_PI / 180.0) * cos(target.latitude * M_PI / 180.0) *
-                   sin(dLon / 2) * sin(dLon / 2);
-        double c = 2 * atan2(sqrt(a), sqrt(1 - a));
-        return round(R * c * 10) / 10; // 保留1位小数，适配老年人认知习惯
+        // 保留1位小数，适配老年人认知习惯
+        return GeoUtil::RoundDistance(GeoUtil::HaversineKm(latitude, longitude, target.latitude, target.longitude));
     }
 
     /**
@@ -4,6 +4,7 @@
 #include <string>
 #include <inttypes.h>
 #include "taxi_location.h"
+#include "util/money.h"
 
 /**
  * 打车订单模型：存储订单全流程信息，支持状态流转和结算
@@ -41,12 +42,12 @@ struct TaxiOrder {
     // 5. 费用信息（结算用，适配老年人清晰对账）
     double distance = 0.0;       // 实际行驶距离（单位：km）
     int duration = 0;            // 实际行驶时长（单位：分钟）
-    double base_fee = 10.0;      // 起步价（单位：元）
-    double distance_fee = 0.0;   // 里程费（单位：元）
-    double time_fee = 0.0;       // 时长费（单位：元）
-    double extra_fee = 0.0;      // 附加费（如高速费、等候费，单位：元）
-    double discount_fee = 0.0;   // 优惠金额（单位：元）
-    double total_fee = 0.0;      // 总费用（单位：元，四舍五入保留2位小数）
+    Money base_fee = Money::FromYuan(10); // 起步价
+    Money distance_fee;          // 里程费（按米计，四舍五入到分）
+    Money time_fee;              // 时长费
+    Money extra_fee;             // 附加费（如高速费、等候费）
+    Money discount_fee;          // 优惠金额
+    Money total_fee;             // 总费用（各项精确相加）
     std::string pay_status = "未支付"; // 支付状态（未支付/已支付）
 
 
@@ -8,6 +8,7 @@
 #include "util/http_client.h"
 #include "util/json_util.h"
 #include "util/time_util.h"
+#include "util/id_generator.h"
 #include "dao/user_dao.h"
 #include "core/logger.h"
 #include <fmt/core.h>
@@ -398,11 +399,7 @@ private:
      * 生成会话ID
      */
     static std::string GenerateSessionId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(100000, 999999);
-        return fmt::format("CHAT_SESSION{}{}", 
-            TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("CHAT_SESSION");
     }
 
     /**
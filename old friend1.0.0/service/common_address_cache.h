@@ -0,0 +1,211 @@
+#ifndef COMMON_ADDRESS_CACHE_H
+#define COMMON_ADDRESS_CACHE_H
+
+#include "model/taxi.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <inttypes.h>
+
+/**
+ * 常用地址缓存统计
+ */
+struct CommonAddressCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t discarded_loads = 0;  // 加载期间发生失效而未写入缓存的结果
+    size_t users = 0;      // 当前缓存的用户数
+};
+
+/**
+ * 用户常用地址缓存：按用户缓存已排好序的地址列表（默认地址 → 优先级 → 最近使用倒序）
+ * - 列表为只读快照（shared_ptr），读方拿到后无需持锁；修改时复制一份调整后整体替换
+ * - 使用时间更新在缓存内增量维护；新增地址、取消默认地址使该用户缓存失效，下次读取重新查库
+ * - 加载与失效并发时（读旧数据期间发生写入）丢弃加载结果，不会把缺少新地址的列表写回缓存
+ * - 按用户分片加锁，每个分片独立 LRU，缓存用户数有上限
+ */
+class CommonAddressCache {
+public:
+    using AddressList = std::vector<TaxiCommonAddress>;
+    using AddressListPtr = std::shared_ptr<const AddressList>;
+
+    explicit CommonAddressCache(size_t max_users = 100000, size_t shard_count = 16)
+        : shards_(new Shard[shard_count]), shard_count_(shard_count),
+          max_users_per_shard_(std::max<size_t>(1, max_users / shard_count)) {}
+
+    CommonAddressCache(const CommonAddressCache&) = delete;
+    CommonAddressCache& operator=(const CommonAddressCache&) = delete;
+
+    /**
+     * 列表排序规则：默认地址 → 优先级（1最高）→ 最近使用时间（倒序）
+     */
+    static bool DisplayOrder(const TaxiCommonAddress& a, const TaxiCommonAddress& b) {
+        if (a.is_default != b.is_default) return a.is_default;
+        if (a.priority != b.priority) return a.priority < b.priority;
+        return a.last_use_time > b.last_use_time;
+    }
+
+    /**
+     * 读取用户的已排序地址列表
+     * @param load_ticket 未命中时写入加载凭证，查库后连同结果交给 Put
+     * @return 未缓存时返回空指针
+     */
+    AddressListPtr Get(const std::string& user_id, uint64_t& load_ticket) {
+        Shard& shard = ShardOf(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.users.find(user_id);
+        if (it == shard.users.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            load_ticket = shard.generation;
+            return nullptr;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_pos);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second.addrs;
+    }
+
+    /**
+     * 写入从数据库加载的完整列表（内部排序；自 Get 以来该分片发生过失效时只返回、不缓存）
+     */
+    AddressListPtr Put(const std::string& user_id, AddressList addrs, uint64_t load_ticket) {
+        std::sort(addrs.begin(), addrs.end(), DisplayOrder);
+        AddressListPtr list = std::make_shared<const AddressList>(std::move(addrs));
+        Shard& shard = ShardOf(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.generation != load_ticket) {
+            discarded_loads_.fetch_add(1, std::memory_order_relaxed);
+            return list;
+        }
+        auto it = shard.users.find(user_id);
+        if (it != shard.users.end()) {
+            it->second.addrs = list;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_pos);
+            return list;
+        }
+        shard.lru.push_front(user_id);
+        shard.users.emplace(user_id, Entry{list, shard.lru.begin()});
+        while (shard.users.size() > max_users_per_shard_) {
+            shard.users.erase(shard.lru.back());
+            shard.lru.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return list;
+    }
+
+    /**
+     * 新增地址已落库（失效而非增量插入：并发加载可能已读到该地址，增量插入会重复）
+     */
+    void OnAdded(const std::string& user_id, const TaxiCommonAddress&) {
+        Invalidate(user_id);
+    }
+
+    /**
+     * 用户全部默认地址已取消
+     */
+    void OnDefaultCleared(const std::string& user_id) {
+        Invalidate(user_id);
+    }
+
+    /**
+     * 地址被使用：更新最近使用时间并调整位置
+     */
+    void OnUsed(const std::string& user_id, const std::string& addr_id, int64_t last_use_time) {
+        Modify(user_id, [&](AddressList& addrs) {
+            auto it = std::find_if(addrs.begin(), addrs.end(),
+                [&addr_id](const TaxiCommonAddress& item) { return item.addr_id == addr_id; });
+            if (it == addrs.end() || it->last_use_time >= last_use_time) {
+                return;
+            }
+            TaxiCommonAddress used = *it;
+            used.last_use_time = last_use_time;
+            addrs.erase(it);
+            addrs.insert(std::upper_bound(addrs.begin(), addrs.end(), used, DisplayOrder), used);
+        });
+    }
+
+    /**
+     * 使某用户的缓存失效（地址被修改/删除或其他实例写入时调用）
+     */
+    void Invalidate(const std::string& user_id) {
+        Shard& shard = ShardOf(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ++shard.generation;  // 进行中的加载（可能读到写入前的数据）不再写入缓存
+        auto it = shard.users.find(user_id);
+        if (it != shard.users.end()) {
+            shard.lru.erase(it->second.lru_pos);
+            shard.users.erase(it);
+        }
+    }
+
+    void InvalidateAll() {
+        for (size_t i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            ++shards_[i].generation;
+            shards_[i].users.clear();
+            shards_[i].lru.clear();
+        }
+    }
+
+    CommonAddressCacheStats GetStats() const {
+        CommonAddressCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        stats.discarded_loads = discarded_loads_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            stats.users += shards_[i].users.size();
+        }
+        return stats;
+    }
+
+private:
+    struct Entry {
+        AddressListPtr addrs;
+        std::list<std::string>::iterator lru_pos;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> users;  // user_id → 已排序列表
+        std::list<std::string> lru;                    // 最近访问在前
+        uint64_t generation = 0;                       // 失效计数，用于识别加载期间的失效
+    };
+
+    Shard& ShardOf(const std::string& user_id) const {
+        return shards_[std::hash<std::string>{}(user_id) % shard_count_];
+    }
+
+    /**
+     * 复制当前列表、修改后替换（未缓存的用户不处理，下次读取时从数据库加载）
+     */
+    template <typename Mutator>
+    void Modify(const std::string& user_id, Mutator&& mutate) {
+        Shard& shard = ShardOf(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.users.find(user_id);
+        if (it == shard.users.end()) {
+            return;
+        }
+        AddressList addrs = *it->second.addrs;
+        mutate(addrs);
+        it->second.addrs = std::make_shared<const AddressList>(std::move(addrs));
+    }
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+    size_t max_users_per_shard_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> discarded_loads_{0};
+};
+
+#endif // COMMON_ADDRESS_CACHE_H
@@ -0,0 +1,247 @@
+#ifndef DRIVER_LOCATION_INDEX_H
+#define DRIVER_LOCATION_INDEX_H
+
+#include "util/geo_util.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * 司机位置索引：按经纬度网格（cell_deg 度见方）分桶存放空闲司机
+ * - 网格与司机表各自分片加锁，不同区域/不同司机的位置更新互不阻塞
+ * - 每个格子是只读快照（写时复制）：写入方复制所在格子（格内司机数量级）后替换指针，
+ *   读方只在取格子指针时短暂持有共享锁，距离计算与排序不持锁，派单查询不阻塞GPS写入
+ * - 半径查询只访问覆盖范围内的格子，耗时与附近司机数相关，与总司机数无关
+ * - 只有空闲司机在索引中；Remove 成功即视为“抢占”该司机，保证同一司机不会被并发派给两单
+ */
+class DriverLocationIndex {
+public:
+    /**
+     * 候选司机（按距离升序返回）
+     */
+    struct Candidate {
+        std::string driver_id;
+        double latitude = 0.0;
+        double longitude = 0.0;
+        double distance = 0.0; // 与查询点的距离（km）
+    };
+
+    explicit DriverLocationIndex(double cell_deg = 0.01, size_t shard_count = 64)
+        : cell_deg_(cell_deg),
+          cell_shards_(new CellShard[shard_count]),
+          driver_shards_(new DriverShard[shard_count]),
+          shard_count_(shard_count) {}
+
+    DriverLocationIndex(const DriverLocationIndex&) = delete;
+    DriverLocationIndex& operator=(const DriverLocationIndex&) = delete;
+
+    /**
+     * 写入/更新空闲司机位置（不存在则加入索引）
+     */
+    void UpdatePosition(const std::string& driver_id, double latitude, double longitude) {
+        Upsert(driver_id, latitude, longitude, true);
+    }
+
+    /**
+     * 仅更新已在索引中的司机位置（服务中/离线司机的GPS上报不会被加回索引）
+     * @return true=已更新，false=司机不在索引中
+     */
+    bool MoveIfPresent(const std::string& driver_id, double latitude, double longitude) {
+        return Upsert(driver_id, latitude, longitude, false);
+    }
+
+    /**
+     * 将司机移出索引（下线/被派单）
+     * @return true=本次调用移除了该司机（可用于抢占），false=司机本就不在索引中
+     */
+    bool Remove(const std::string& driver_id) {
+        DriverShard& ds = DriverShardOf(driver_id);
+        std::lock_guard<std::mutex> driver_lock(ds.mutex);
+        auto it = ds.driver_cell.find(driver_id);
+        if (it == ds.driver_cell.end()) {
+            return false;
+        }
+        EraseFromCell(it->second, driver_id);
+        ds.driver_cell.erase(it);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * 司机是否在索引中
+     */
+    bool Contains(const std::string& driver_id) const {
+        DriverShard& ds = DriverShardOf(driver_id);
+        std::lock_guard<std::mutex> driver_lock(ds.mutex);
+        return ds.driver_cell.count(driver_id) > 0;
+    }
+
+    /**
+     * 查询半径 radius_km 内的空闲司机（按距离升序，limit=0 表示不限数量）
+     */
+    std::vector<Candidate> QueryWithinRadius(double latitude, double longitude,
+                                             double radius_km, size_t limit = 0) const {
+        std::vector<Candidate> result;
+        if (radius_km <= 0) {
+            return result;
+        }
+        double dlat = radius_km / GeoUtil::kKmPerDegreeLat;
+        double edge_lat = std::min(89.0, std::fabs(latitude) + dlat);
+        double dlon = radius_km / GeoUtil::KmPerDegreeLon(edge_lat);
+
+        int row_begin = Row(latitude - dlat), row_end = Row(latitude + dlat);
+        int col_begin = Col(longitude - dlon), col_end = Col(longitude + dlon);
+        for (int row = row_begin; row <= row_end; ++row) {
+            for (int col = col_begin; col <= col_end; ++col) {
+                CellPtr cell = LoadCell(CellKey(row, col));
+                if (!cell) continue;
+                for (const auto& entry : *cell) {
+                    double dist = GeoUtil::HaversineKm(latitude, longitude, entry.latitude, entry.longitude);
+                    if (dist <= radius_km) {
+                        result.push_back(Candidate{entry.driver_id, entry.latitude, entry.longitude, dist});
+                    }
+                }
+            }
+        }
+
+        auto nearer = [](const Candidate& a, const Candidate& b) { return a.distance < b.distance; };
+        if (limit > 0 && result.size() > limit) {
+            std::partial_sort(result.begin(), result.begin() + limit, result.end(), nearer);
+            result.resize(limit);
+        } else {
+            std::sort(result.begin(), result.end(), nearer);
+        }
+        return result;
+    }
+
+    /**
+     * 当前索引中的空闲司机数
+     */
+    size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        std::string driver_id;
+        double latitude;
+        double longitude;
+    };
+
+    using Cell = std::vector<Entry>;
+    using CellPtr = std::shared_ptr<const Cell>;
+
+    struct CellShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint64_t, CellPtr> cells; // 格子 → 司机列表快照（只读，写入时整体替换）
+    };
+
+    struct DriverShard {
+        std::mutex mutex;
+        std::unordered_map<std::string, uint64_t> driver_cell;  // 司机 → 所在格子
+    };
+
+    int Row(double latitude) const { return static_cast<int>(std::floor(latitude / cell_deg_)); }
+    int Col(double longitude) const { return static_cast<int>(std::floor(longitude / cell_deg_)); }
+
+    static uint64_t CellKey(int row, int col) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32) | static_cast<uint32_t>(col);
+    }
+
+    CellShard& CellShardOf(uint64_t key) const {
+        return cell_shards_[(key * 0x9E3779B97F4A7C15ULL >> 32) % shard_count_];
+    }
+
+    DriverShard& DriverShardOf(const std::string& driver_id) const {
+        return driver_shards_[std::hash<std::string>{}(driver_id) % shard_count_];
+    }
+
+    /**
+     * 取格子当前快照（只在复制指针时持锁）
+     */
+    CellPtr LoadCell(uint64_t key) const {
+        const CellShard& cs = CellShardOf(key);
+        std::shared_lock<std::shared_mutex> cell_lock(cs.mutex);
+        auto it = cs.cells.find(key);
+        return it == cs.cells.end() ? nullptr : it->second;
+    }
+
+    /**
+     * 更新司机位置；insert_if_absent=false 时不在索引中的司机直接忽略
+     */
+    bool Upsert(const std::string& driver_id, double latitude, double longitude, bool insert_if_absent) {
+        uint64_t new_cell = CellKey(Row(latitude), Col(longitude));
+        DriverShard& ds = DriverShardOf(driver_id);
+        std::lock_guard<std::mutex> driver_lock(ds.mutex);
+
+        auto it = ds.driver_cell.find(driver_id);
+        if (it == ds.driver_cell.end() && !insert_if_absent) {
+            return false;
+        }
+        if (it != ds.driver_cell.end() && it->second == new_cell) {
+            // 同一格子内移动：复制格子后更新坐标（读方持有的旧快照不受影响）
+            CellShard& cs = CellShardOf(new_cell);
+            std::unique_lock<std::shared_mutex> cell_lock(cs.mutex);
+            CellPtr& cell = cs.cells[new_cell];
+            std::shared_ptr<Cell> next = cell ? std::make_shared<Cell>(*cell) : std::make_shared<Cell>();
+            for (auto& entry : *next) {
+                if (entry.driver_id == driver_id) {
+                    entry.latitude = latitude;
+                    entry.longitude = longitude;
+                    break;
+                }
+            }
+            cell = std::move(next);
+            return true;
+        }
+
+        if (it != ds.driver_cell.end()) {
+            EraseFromCell(it->second, driver_id);
+            it->second = new_cell;
+        } else {
+            ds.driver_cell.emplace(driver_id, new_cell);
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        CellShard& cs = CellShardOf(new_cell);
+        std::unique_lock<std::shared_mutex> cell_lock(cs.mutex);
+        CellPtr& cell = cs.cells[new_cell];
+        std::shared_ptr<Cell> next = cell ? std::make_shared<Cell>(*cell) : std::make_shared<Cell>();
+        next->push_back(Entry{driver_id, latitude, longitude});
+        cell = std::move(next);
+        return true;
+    }
+
+    // 调用方需持有该司机所在的司机分片锁
+    void EraseFromCell(uint64_t key, const std::string& driver_id) {
+        CellShard& cs = CellShardOf(key);
+        std::unique_lock<std::shared_mutex> cell_lock(cs.mutex);
+        auto it = cs.cells.find(key);
+        if (it == cs.cells.end()) return;
+        std::shared_ptr<Cell> next = std::make_shared<Cell>();
+        next->reserve(it->second->size());
+        for (const auto& entry : *it->second) {
+            if (entry.driver_id != driver_id) {
+                next->push_back(entry);
+            }
+        }
+        if (next->empty()) {
+            cs.cells.erase(it);
+        } else {
+            it->second = std::move(next);
+        }
+    }
+
+    double cell_deg_;                              // 网格边长（度，默认0.01°≈1.1km）
+    std::unique_ptr<CellShard[]> cell_shards_;     // 网格分片
+    std::unique_ptr<DriverShard[]> driver_shards_; // 司机分片
+    size_t shard_count_;
+    std::atomic<size_t> size_{0};
+};
+
+#endif // DRIVER_LOCATION_INDEX_H
@@ -0,0 +1,229 @@
+#ifndef DRIVER_POSITION_INGESTOR_H
+#define DRIVER_POSITION_INGESTOR_H
+
+#include "service/driver_location_index.h"
+#include "util/bounded_mpmc_queue.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <unordered_map>
+#include <functional>
+#include <inttypes.h>
+
+/**
+ * 司机GPS上报（一条）
+ */
+struct DriverPositionUpdate {
+    std::string driver_id;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    int64_t timestamp = 0;   // 司机端采集时间戳（用于丢弃乱序的旧位置）
+};
+
+/**
+ * GPS接入参数
+ */
+struct DriverIngestOptions {
+    size_t shard_count = 8;          // 分片数（每个分片一个无锁队列 + 一个消费线程）
+    size_t queue_capacity = 65536;   // 每个分片队列容量（满时丢弃，司机下一次上报会覆盖）
+    size_t max_batch = 4096;         // 消费线程单轮最多处理的上报条数
+    int idle_sleep_ms = 2;           // 队列为空时消费线程的休眠时间
+    int prune_interval_ms = 10000;   // 消费线程清理已离开索引的司机时间戳记录的间隔
+};
+
+/**
+ * GPS接入统计
+ */
+struct DriverIngestStats {
+    uint64_t accepted = 0;  // 成功入队
+    uint64_t dropped = 0;   // 队列满被丢弃
+    uint64_t applied = 0;   // 已应用（写入派单索引）
+    uint64_t stale = 0;     // 时间戳不新于已有位置，被忽略
+    uint64_t tracked = 0;   // 消费线程记录最新时间戳的司机数（只含仍在派单索引中的司机）
+};
+
+/**
+ * 司机GPS高频接入管道：批量上报 → 按司机分片的无锁队列 → 分片消费线程合并后批量应用
+ * - 上报方只做无锁入队，不访问DAO、不等待索引锁
+ * - 消费线程按司机合并同一批次内的多次上报，只把最新位置写入派单索引（只移动已在索引中的空闲司机）
+ * - 派单索引的格子为写时复制快照，派单查询读快照，不阻塞本管道的写入；每轮只处理本批涉及的司机，
+ *   耗时与批量大小相关，与车队规模无关
+ * - 乱序过滤用的“司机 → 最新时间戳”只保留仍在索引中的司机：上报时发现司机已离开索引（被派单、下线）即删除，
+ *   离开后不再上报的司机由消费线程按 prune_interval_ms 定期清理；重新进入索引后的首次上报直接应用
+ */
+class DriverPositionIngestor {
+public:
+    explicit DriverPositionIngestor(DriverLocationIndex* index, DriverIngestOptions options = DriverIngestOptions())
+        : index_(index), options_(options) {
+        for (size_t i = 0; i < options_.shard_count; ++i) {
+            shards_.emplace_back(new Shard(options_.queue_capacity));
+        }
+    }
+
+    ~DriverPositionIngestor() { Stop(); }
+
+    DriverPositionIngestor(const DriverPositionIngestor&) = delete;
+    DriverPositionIngestor& operator=(const DriverPositionIngestor&) = delete;
+
+    /**
+     * 启动分片消费线程
+     */
+    void Start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            workers_.emplace_back([this, i] { ShardLoop(*shards_[i]); });
+        }
+    }
+
+    /**
+     * 停止消费线程（停止前把队列中剩余上报全部处理完）
+     */
+    void Stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+        for (auto& shard : shards_) {
+            while (DrainShard(*shard) > 0) {
+            }
+        }
+    }
+
+    /**
+     * 批量接收GPS上报（无锁入队）
+     * @return 成功入队的条数
+     */
+    size_t Ingest(const std::vector<DriverPositionUpdate>& batch) {
+        size_t accepted = 0;
+        for (const auto& update : batch) {
+            Shard& shard = *shards_[std::hash<std::string>{}(update.driver_id) % shards_.size()];
+            if (shard.queue.TryPush(update)) {
+                ++accepted;
+            }
+        }
+        accepted_.fetch_add(accepted, std::memory_order_relaxed);
+        dropped_.fetch_add(batch.size() - accepted, std::memory_order_relaxed);
+        return accepted;
+    }
+
+    DriverIngestStats GetStats() const {
+        DriverIngestStats stats;
+        stats.accepted = accepted_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        stats.applied = applied_.load(std::memory_order_relaxed);
+        stats.stale = stale_.load(std::memory_order_relaxed);
+        stats.tracked = tracked_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Shard {
+        explicit Shard(size_t capacity) : queue(capacity) {}
+        BoundedMpmcQueue<DriverPositionUpdate> queue;           // 上报队列（多生产者）
+        std::unordered_map<std::string, int64_t> last_applied;  // 消费线程私有：司机 → 已应用的最新时间戳
+    };
+
+    void ShardLoop(Shard& shard) {
+        auto next_prune = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.prune_interval_ms);
+        while (running_.load(std::memory_order_relaxed)) {
+            if (DrainShard(shard) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(options_.idle_sleep_ms));
+            }
+            if (std::chrono::steady_clock::now() >= next_prune) {
+                PruneShard(shard);
+                next_prune = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.prune_interval_ms);
+            }
+        }
+    }
+
+    /**
+     * 删除已离开派单索引的司机的时间戳记录
+     */
+    void PruneShard(Shard& shard) {
+        if (index_ == nullptr) {
+            return;
+        }
+        size_t pruned = 0;
+        for (auto it = shard.last_applied.begin(); it != shard.last_applied.end();) {
+            if (index_->Contains(it->first)) {
+                ++it;
+            } else {
+                it = shard.last_applied.erase(it);
+                ++pruned;
+            }
+        }
+        tracked_.fetch_sub(pruned, std::memory_order_relaxed);
+    }
+
+    /**
+     * 处理一个分片的一批上报：按司机合并 → 过滤旧位置 → 更新派单索引
+     * @return 本轮出队的条数（0 表示队列已空）
+     */
+    size_t DrainShard(Shard& shard) {
+        std::unordered_map<std::string, DriverPositionUpdate> latest;
+        DriverPositionUpdate update;
+        size_t popped = 0;
+        uint64_t stale = 0;
+        while (popped < options_.max_batch && shard.queue.TryPop(update)) {
+            ++popped;
+            auto& slot = latest[update.driver_id];
+            if (slot.driver_id.empty() || update.timestamp >= slot.timestamp) {
+                slot = update;
+            } else {
+                ++stale;
+            }
+        }
+        if (popped == 0) {
+            return 0;
+        }
+
+        size_t applied = 0;
+        for (auto& item : latest) {
+            auto it = shard.last_applied.find(item.first);
+            if (it != shard.last_applied.end() && it->second >= item.second.timestamp) {
+                ++stale;
+                continue;
+            }
+            bool present = index_ == nullptr ||
+                           index_->MoveIfPresent(item.first, item.second.latitude, item.second.longitude);
+            if (present) {
+                if (it == shard.last_applied.end()) {
+                    shard.last_applied.emplace(item.first, item.second.timestamp);
+                    tracked_.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    it->second = item.second.timestamp;
+                }
+            } else if (it != shard.last_applied.end()) {
+                shard.last_applied.erase(it);
+                tracked_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            ++applied;
+        }
+
+        applied_.fetch_add(applied, std::memory_order_relaxed);
+        stale_.fetch_add(stale, std::memory_order_relaxed);
+        return popped;
+    }
+
+    DriverLocationIndex* index_;                 // 派单索引（可为空，仅用于测试接入吞吐）
+    DriverIngestOptions options_;                // 接入参数
+    std::vector<std::unique_ptr<Shard>> shards_; // 分片
+    std::vector<std::thread> workers_;           // 分片消费线程
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> applied_{0};
+    std::atomic<uint64_t> stale_{0};
+    std::atomic<uint64_t> tracked_{0};
+};
+
+#endif // DRIVER_POSITION_INGESTOR_H
@@ -6,6 +6,7 @@
 #include "dao/user_dao.h"
 #include "dao/emergency_dao.h"
 #include "util/time_util.h"
+#include "util/id_generator.h"
 #include "core/logger.h"
 #include <fmt/core.h>
 
@@ -347,20 +348,14 @@ private:
      * 生成日志ID
      */
     static std::string GenerateLogId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("CALL_LOG{}{}", TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("CALL_LOG");
     }
 
     /**
      * 生成联系人ID
      */
     static std::string GenerateContactId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("CONTACT{}{}", TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("CONTACT");
     }
 
     /**
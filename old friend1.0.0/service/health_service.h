@@ -7,6 +7,7 @@
 #include "dao/device_dao.h"
 #include "dao/user_dao.h"
 #include "util/time_util.h"
+#include "util/id_generator.h"
 #include "core/logger.h"
 #include <fmt/core.h>
 
@@ -412,20 +413,14 @@ private:
      * 生成日志ID
      */
     static std::string GenerateLogId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("HEALTH_LOG{}{}", TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("HEALTH_LOG");
     }
 
     /**
      * 生成绑定ID
      */
     static std::string GenerateBindId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("DEVICE_BIND{}{}", TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("DEVICE_BIND");
     }
 };
 
@@ -3,23 +3,31 @@
 #include "model/hospital.h"
 #include "model/reserve_order.h"
 #include "util/time_util.h"
+#include "util/id_generator.h"
+#include "service/hospital_catalog.h"
+#include "service/hospital_search.h"
+#include "service/order_expiry_scheduler.h"
+#include "service/reserve_quota_engine.h"
+#include "service/reserve_admission_gate.h"
+#include "service/reserve_order_committer.h"
+#include "service/reserve_slot_inventory.h"
+#include "service/reserve_expiry_sweeper.h"
 //#include "config/config_parser.h"
 #include <stdexcept>
 #include<vector>
 #include<algorithm>
-#include <random>
 #include<thread>
 #include<fmt/core.h>
-#define M_PI 3.14
+#include <memory>
+#include <ctime>
+#include <cstdio>
+#include <mutex>
 class HospitalService {
 public:
-    // 1. 获取所有科室（从数据库加载，支持缓存）
-    static std::vector<std::string> GetAllDepartments() {
-        static std::vector<std::string> cache;
-        if (cache.empty()) {
-            cache = HospitalDao::QueryAllDepartments();
-        }
-        return cache;
+    // 1. 获取所有科室（来自医院目录快照，不拷贝；返回的指针持有快照）
+    static std::shared_ptr<const std::vector<std::string>> GetAllDepartments() {
+        auto catalog = Catalog().Snapshot();
+        return std::shared_ptr<const std::vector<std::string>>(catalog, &catalog->departments);
     }
 
     // 2. 根据科室+地理位置筛选医院（按距离排序）
@@ -28,36 +36,164 @@ public:
         if (department.empty()) {
             throw std::invalid_argument("科室不能为空");
         }
-        // 数据库查询符合条件的医院
-        auto hospitals = HospitalDao::QueryHospitalsByDepartment(department);
-        std::vector<HospitalDTO> result;
-        for (const auto& hosp : hospitals) {
-            HospitalDTO dto;
-            dto.id = hosp.id;
-            dto.name = hosp.name;
-            dto.address = hosp.address;
-            dto.phone = hosp.phone;
+        // 科室倒排索引中的医院，按 (距离, 下标) 排序后再构造DTO
+        auto catalog = Catalog().Snapshot();
+        HospitalRows rows = catalog->RowsOf(department);
+        const GeoPointArray& points = catalog->PointsOf(department);
+        std::vector<std::pair<double, uint32_t>> order;
+        order.reserve(rows.size());
+        for (uint32_t i = 0; i < rows.size(); ++i) {
             // 计算距离（简化：经纬度直线距离，单位km）
-            dto.distance = CalculateDistance(latitude, longitude, hosp.latitude, hosp.longitude);
-            dto.status = hosp.available_quota > 0 ? "可预约" : "约满";
-            dto.available_quota = hosp.available_quota;
-            result.push_back(dto);
+            order.emplace_back(CalculateDistance(latitude, longitude, points.latitude[i], points.longitude[i]), i);
         }
         // 按距离升序排序
-        std::sort(result.begin(), result.end(), [](const HospitalDTO& a, const HospitalDTO& b) {
-            return a.distance < b.distance;
-        });
+        std::stable_sort(order.begin(), order.end(),
+            [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) {
+                return a.first < b.first;
+            });
+        std::vector<HospitalDTO> result;
+        result.reserve(order.size());
+        for (const auto& item : order) {
+            result.push_back(BuildHospitalDTO(catalog->At(rows[item.second]), item.first));
+        }
+        return result;
+    }
+
+    // 2.0 分页查询科室内的医院（按距离升序，只为本页构造DTO）
+    static HospitalSearchPage SearchHospitals(
+        const std::string& department, double latitude, double longitude,
+        const HospitalSearchOptions& options = HospitalSearchOptions()) {
+        if (department.empty()) {
+            throw std::invalid_argument("科室不能为空");
+        }
+        if (options.limit == 0 || options.limit > 100) {
+            throw std::invalid_argument("每页条数应在 1-100 之间");
+        }
+        auto catalog = Catalog().Snapshot();
+        std::vector<HospitalSearchHit> hits;
+        HospitalSearchPage page;
+        HospitalQuotaPredicate has_quota = QuotaPredicate(*catalog, department, options.reserve_date);
+        if (!has_quota) {
+            has_quota = [&catalog](uint32_t row) { return catalog->AvailableQuotaOf(row) > 0; };
+        }
+        page.total = HospitalSearcher::Search(catalog->RowsOf(department), catalog->PointsOf(department),
+                                              latitude, longitude, options,
+                                              [&catalog](uint32_t row) { return catalog->IdOf(row); },
+                                              hits, page.next_cursor, has_quota);
+        page.items.reserve(hits.size());
+        for (const auto& hit : hits) {
+            page.items.push_back(BuildHospitalDTO(catalog->At(hit.row), GeoUtil::RoundDistance(hit.distance)));
+        }
+        return page;
+    }
+
+    // 2.0.1 多条件筛选医院（等级、类型、老年友好、服务状态、有号源、正在门诊），按距离分页
+    static HospitalSearchPage FilterHospitals(
+        double latitude, double longitude, const HospitalFilter& filter,
+        const HospitalSearchOptions& options = HospitalSearchOptions()) {
+        if (options.limit == 0 || options.limit > 100) {
+            throw std::invalid_argument("每页条数应在 1-100 之间");
+        }
+        auto catalog = Catalog().Snapshot();
+        std::vector<HospitalSearchHit> hits;
+        HospitalSearchPage page;
+        page.total = catalog->filter_table.Search(filter, latitude, longitude, options,
+            [&catalog](uint32_t row) { return catalog->IdOf(row); }, hits, page.next_cursor,
+            QuotaPredicate(*catalog, filter.department, options.reserve_date));
+        page.items.reserve(hits.size());
+        for (const auto& hit : hits) {
+            page.items.push_back(BuildHospitalDTO(catalog->At(hit.row), GeoUtil::RoundDistance(hit.distance)));
+        }
+        return page;
+    }
+
+    // 2.0.2 医院在指定时刻（秒级时间戳）是否门诊（门诊时间无法识别时返回 false）
+    static bool IsHospitalOpenAt(const std::string& hospital_id, int64_t timestamp) {
+        auto catalog = Catalog().Snapshot();
+        uint32_t row = 0;
+        if (!catalog->FindRow(hospital_id, row)) {
+            throw std::runtime_error("医院不存在");
+        }
+        return catalog->filter_table.OpeningHoursAt(row).IsOpenAt(timestamp);
+    }
+
+    // 2.0.3 医院下一次开始门诊的时间（正在门诊返回 timestamp；门诊时间无法识别返回 -1）
+    static int64_t GetNextOpeningTime(const std::string& hospital_id, int64_t timestamp) {
+        auto catalog = Catalog().Snapshot();
+        uint32_t row = 0;
+        if (!catalog->FindRow(hospital_id, row)) {
+            throw std::runtime_error("医院不存在");
+        }
+        return catalog->filter_table.OpeningHoursAt(row).NextOpeningTime(timestamp);
+    }
+
+    // 2.1 刷新医院目录（科室列表、倒排索引与地理索引一并重建；医院信息变更后调用）
+    static bool RefreshCatalog() {
+        return Catalog().Refresh();
+    }
+
+    // 2.1.1 初始化医院目录：优先从二进制目录文件加载（多实例滚动发布时避免全部回源数据库），失败时从数据库加载
+    static void InitCatalog(const std::string& catalog_file = "") {
+        if (catalog_file.empty() || !Catalog().LoadFromFile(catalog_file)) {
+            Catalog().Refresh();
+        }
+    }
+
+    // 2.1.2 从数据库重新加载医院目录并导出为二进制目录文件（离线构建，供 InitCatalog 使用）
+    static void ExportCatalogFile(const std::string& path) {
+        if (!Catalog().Refresh()) {
+            throw std::runtime_error("医院目录加载失败");
+        }
+        Catalog().ExportToFile(path);
+    }
+
+    // 2.2 查询科室内距离最近的 k 家医院（走地理索引）
+    static std::vector<HospitalDTO> GetNearestHospitals(
+        const std::string& department, double latitude, double longitude, size_t k) {
+        if (department.empty()) {
+            throw std::invalid_argument("科室不能为空");
+        }
+        auto catalog = Catalog().Snapshot();
+        std::vector<HospitalDTO> result;
+        for (const auto& hit : catalog->geo_index->QueryNearest(department, latitude, longitude, k)) {
+            result.push_back(BuildHospitalDTO(catalog->At(hit.row), GeoUtil::RoundDistance(hit.distance)));
+        }
         return result;
     }
 
-    // 3. 预约挂号（核心业务：校验→扣减配额→创建订单）
+    // 2.3 查询科室内半径 radius_km 范围内的医院（按距离升序）
+    static std::vector<HospitalDTO> GetHospitalsWithinRadius(
+        const std::string& department, double latitude, double longitude, double radius_km) {
+        if (department.empty()) {
+            throw std::invalid_argument("科室不能为空");
+        }
+        auto catalog = Catalog().Snapshot();
+        std::vector<HospitalDTO> result;
+        for (const auto& hit : catalog->geo_index->QueryWithinRadius(department, latitude, longitude, radius_km)) {
+            result.push_back(BuildHospitalDTO(catalog->At(hit.row), GeoUtil::RoundDistance(hit.distance)));
+        }
+        return result;
+    }
+
+    // 3. 预约挂号（核心业务：校验→扣减配额→占用时段→创建订单）
+    // reserve_period 为空时分配当天第一个有空位的时段
     static ReserveOrderDTO CreateReserveOrder(
         const std::string& user_id, const std::string& hospital_id, 
-        const std::string& department, const std::string& reserve_date) {
+        const std::string& department, const std::string& reserve_date,
+        const std::string& reserve_period = "") {
         // 校验参数
         if (user_id.empty() || hospital_id.empty() || reserve_date.empty()) {
             throw std::invalid_argument("必填参数缺失");
         }
+        // 抢号准入：号源已全部发出令牌时直接返回，不访问数据库；其余请求按到达顺序排队
+        ReserveAdmissionGate::Ticket ticket;
+        AdmissionResult admission = ReserveAdmissionGate::GetInstance().Enter(hospital_id, department, reserve_date, ticket);
+        if (admission == AdmissionResult::SOLD_OUT) {
+            throw std::runtime_error("已满");
+        }
+        if (admission == AdmissionResult::BUSY) {
+            throw std::runtime_error("当前预约人数较多，请稍后再试");
+        }
         /*
         该部分功能为校验用户，修改为自己的校验接口
         */
@@ -65,23 +201,40 @@ public:
         if (user.id.empty()) {
             throw std::runtime_error("用户不存在");
         }
-        // 校验医院及科室配额
-        auto hospital = HospitalDao::QueryHospitalById(hospital_id);
+        // 校验医院（目录快照中没有的新医院回源查询）
+        auto catalog = Catalog().Snapshot();
+        const Hospital* cached = catalog->FindHospital(hospital_id);
+        Hospital hospital = cached ? Hospital() : HospitalDao::QueryHospitalById(hospital_id);
+        if (cached) {
+            hospital.id = cached->id;
+            hospital.name = cached->name;
+        }
         if (hospital.id.empty()) {
             throw std::runtime_error("医院不存在");
         }
-        if (hospital.available_quota <= 0) {
-            throw std::runtime_error("已满");
-        }
         // 校验日期格式（yyyy-mm-dd）和有效性（不能是过去日期）
         if (!TimeUtil::GetInstance().IsValidDateFormat(reserve_date) || TimeUtil::GetInstance().CompareDate(reserve_date, TimeUtil::GetInstance().GetCurrentDate()) < 0) {
             throw std::runtime_error("预约日期无效");
         }
-        // 扣减医院预约配额（数据库事务：确保扣减和订单创建原子性）
-        bool quota_updated = HospitalDao::DecreaseAvailableQuota(hospital_id, 1);
-        if (!quota_updated) {
-            throw std::runtime_error("预约失败，请重试");
+        // 内存中原子占用号源（医院+科室+日期），号源增量随订单组提交落库
+        QuotaAcquireResult quota_result = QuotaEngine().TryAcquire(hospital_id, department, reserve_date, false);
+        if (quota_result == QuotaAcquireResult::SOLD_OUT) {
+            throw std::runtime_error("已满");
+        }
+        if (quota_result == QuotaAcquireResult::UNKNOWN) {
+            throw std::runtime_error("该科室暂不提供预约");
+        }
+        ticket.MarkQuotaAcquired();
+        // 占用就诊时段（未配置分时段号源的科室沿用用户填写的时段）
+        std::string period = reserve_period;
+        SlotClaimResult slot_result = reserve_period.empty()
+            ? SlotInventory().ClaimFirstFree(hospital_id, department, reserve_date, period)
+            : SlotInventory().Claim(hospital_id, department, reserve_date, reserve_period);
+        if (slot_result == SlotClaimResult::FULL || slot_result == SlotClaimResult::UNKNOWN_PERIOD) {
+            QuotaEngine().Release(hospital_id, department, reserve_date, false);
+            throw std::runtime_error(slot_result == SlotClaimResult::FULL ? "该时段已满" : "预约时段无效");
         }
+        bool slotted = slot_result == SlotClaimResult::OK;
         // 创建预约订单
         ReserveOrder order;
         order.order_id = GenerateOrderId();
@@ -90,43 +243,237 @@ public:
         order.hospital_name = hospital.name;
         order.department = department;
         order.reserve_date = reserve_date;
-        order.create_time = TimeUtil::GetInstance().GetCurrentTimestamp();
+        order.reserve_period = period;
+        order.create_time = TimeUtil::GetCurrentTimestamp();
         order.status = "已预约";
-        // 保存订单到数据库
-        HospitalDao::SaveReserveOrder(order);
+        // 组提交：订单与号源增量在同一事务内批量落库，事务内以数据库号源为准校验，等待本单提交完成（失败时归还号源和时段）
+        ReserveCommitResult commit_result = OrderCommitter().Submit(order, slotted).get();
+        if (commit_result != ReserveCommitResult::COMMITTED) {
+            QuotaEngine().Release(hospital_id, department, reserve_date, false);
+            if (slotted) SlotInventory().Release(hospital_id, department, reserve_date, period);
+            if (commit_result == ReserveCommitResult::SLOT_FULL) {
+                // 其他实例已约满该时段：按数据库重新加载本实例的时段占用
+                SlotInventory().Refresh(hospital_id, department, reserve_date);
+                throw std::runtime_error("该时段已满");
+            }
+            if (commit_result == ReserveCommitResult::QUOTA_EXCEEDED) {
+                // 其他实例已约满：按数据库重新加载本实例的剩余号源，后续请求在准入层直接返回
+                QuotaEngine().Refresh(hospital_id, department, reserve_date);
+                throw std::runtime_error("已满");
+            }
+            throw std::runtime_error("预约失败，请重试");
+        }
+        // 登记就诊日结束后自动过期
+        OrderExpiryScheduler::GetInstance().Schedule(OrderExpiryKind::RESERVE_ORDER, order.order_id,
+            ReserveDateExpireTime(order.reserve_date));
         // 构造返回DTO
         ReserveOrderDTO dto;
         dto.order_id = order.order_id;
         dto.hospital_name = order.hospital_name;
         dto.department = order.department;
         dto.reserve_date = order.reserve_date;
+        dto.reserve_period = order.reserve_period;
         dto.status = order.status;
         dto.create_time = TimeUtil::GetInstance().TimestampToStr(order.create_time);
         return dto;
     }
 
+    // 4. 取消预约：号源归还到原日期和原时段
+    static void CancelReserveOrder(const std::string& user_id, const std::string& order_id,
+                                   const std::string& cancel_reason = "") {
+        if (user_id.empty() || order_id.empty()) {
+            throw std::invalid_argument("必填参数缺失");
+        }
+        auto order = HospitalDao::QueryReserveOrderById(order_id);
+        if (order.order_id.empty() || order.user_id != user_id) {
+            throw std::runtime_error("订单不存在");
+        }
+        // 条件更新：仅“待就诊”且号源未恢复的订单置为“已取消”，并标记 is_quota_recovered，
+        // 重复取消或与过期处理并发时只有一方成功，号源不会重复归还
+        if (!HospitalDao::CancelReserveOrder(order_id, TimeUtil::GetCurrentTimestamp(), cancel_reason)) {
+            throw std::runtime_error("订单状态不允许取消");
+        }
+        QuotaEngine().Release(order.hospital_id, order.department, order.reserve_date);
+        if (!order.reserve_period.empty()) {
+            SlotInventory().Release(order.hospital_id, order.department, order.reserve_date, order.reserve_period);
+        }
+        OrderExpiryScheduler::GetInstance().Cancel(OrderExpiryKind::RESERVE_ORDER, order_id);
+    }
+
+    // 5. 查询剩余号源不少于 min_free 的就诊时段（按时段先后排列）
+    static std::vector<ReserveSlotView> QueryReserveSlots(const std::string& hospital_id,
+                                                          const std::string& department,
+                                                          const std::string& reserve_date, int min_free = 1) {
+        if (hospital_id.empty() || reserve_date.empty()) {
+            throw std::invalid_argument("必填参数缺失");
+        }
+        return SlotInventory().SlotsWithAtLeast(hospital_id, department, reserve_date, min_free);
+    }
+
+    // 6. 注册预约订单到期处理，启动到期调度线程与过期扫描（服务启动时调用一次）
+    // - 本进程创建的订单由定时器在就诊日次日零点过期
+    // - 停机期间积压及其他实例的订单由过期扫描按 (reserve_date, order_id) 分批处理，启动后立即执行一轮
+    // 两条路径走同一个条件更新事务，号源只归还一次
+    static void InitOrderExpiry() {
+        IdGenerator::Init(); // 订单号发号器启动检查：NODE_ID 非法时启动失败，而不是在首次下单时
+        OrderExpiryScheduler::GetInstance().SetHandler(OrderExpiryKind::RESERVE_ORDER,
+            [](const std::vector<std::string>& order_ids) {
+                ExpireReserveOrders(order_ids, TimeUtil::GetCurrentTimestamp());
+            });
+        OrderExpiryScheduler::GetInstance().Start();
+        ExpirySweeper().Start([] { return TimeUtil::GetCurrentTimestamp(); });
+    }
+
+    // 7. 挂号配额对账：写回未落库的增量后，以有效预约订单统计重建内存配额和时段占用（服务启动时调用一次）
+    static void InitReserveQuota() {
+        ReserveQuotaEngine& engine = QuotaEngine();
+        engine.Flush();
+        std::string today = TimeUtil::GetInstance().GetCurrentDate();
+        engine.Reconcile(HospitalDao::QueryReserveQuotaSnapshot(today));
+        // 按 (医院, 科室, 日期) 分组、组内按模板 sort_no 排列
+        SlotInventory().Reconcile(HospitalDao::QueryReserveSlotSnapshot(today));
+    }
+
 private:
+    // 配额引擎（首次使用时设置加载/写回回调并启动写回线程）
+    // 按配额引擎判断某科室某日是否还有号（未指定科室或日期时返回空，调用方退回目录中的近似值）
+    // 引擎中尚未加载的键不为查询去访问数据库，按目录中的 available_quota 近似判断
+    // 返回的判断引用 catalog，只能在本次查询内使用
+    static HospitalQuotaPredicate QuotaPredicate(const HospitalCatalogSnapshot& catalog,
+                                                 const std::string& department, const std::string& reserve_date) {
+        if (department.empty() || reserve_date.empty()) {
+            return nullptr;
+        }
+        return [&catalog, department, reserve_date](uint32_t row) {
+            int remaining = QuotaEngine().Remaining(std::string(catalog.IdOf(row)), department, reserve_date);
+            return remaining >= 0 ? remaining > 0 : catalog.AvailableQuotaOf(row) > 0;
+        };
+    }
+
+    static ReserveQuotaEngine& QuotaEngine() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            ReserveQuotaEngine::GetInstance().Configure(
+                // 按需加载：HOSPITAL_QUOTA 无记录时由 DAO 按医院 daily_quota 初始化
+                [](const std::string& hospital_id, const std::string& department,
+                   const std::string& reserve_date, ReserveQuota& out) {
+                    return HospitalDao::LoadReserveQuota(hospital_id, department, reserve_date, out);
+                },
+                // 批量写回：HOSPITAL_QUOTA.used_quota += delta，并同步扣减 HOSPITAL_INFO.available_quota
+                [](const std::vector<ReserveQuotaDelta>& deltas) {
+                    return HospitalDao::ApplyReserveQuotaDeltas(deltas);
+                });
+            // 写回线程同时淘汰就诊日已过的配额计数器与时段库存
+            ReserveQuotaEngine::GetInstance().Start(
+                [] { return TimeUtil::GetInstance().GetCurrentDate(); },
+                [](const std::string& today) { SlotInventory().EvictBefore(today); });
+        });
+        return ReserveQuotaEngine::GetInstance();
+    }
+
+    // 时段号源库存（首次使用时设置加载回调）
+    static ReserveSlotInventory& SlotInventory() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            // 按需加载：HOSPITAL_SLOT_TEMPLATE 各时段容量 + RESERVE_ORDER 有效订单按时段计数，无模板返回 false
+            ReserveSlotInventory::GetInstance().Configure(
+                [](const std::string& hospital_id, const std::string& department,
+                   const std::string& reserve_date, std::vector<ReserveSlot>& out) {
+                    return HospitalDao::LoadReserveSlots(hospital_id, department, reserve_date, out);
+                });
+        });
+        return ReserveSlotInventory::GetInstance();
+    }
+
+    // 预约订单组提交器（首次使用时启动）
+    static ReserveOrderCommitter& OrderCommitter() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            // 一个事务：批量插入 RESERVE_ORDER + HOSPITAL_QUOTA.used_quota 累加 + HOSPITAL_INFO.available_quota 扣减；
+            // 累加为条件更新 SET used_quota = used_quota + ? WHERE ... AND used_quota + ? <= total_quota，
+            // 任一键影响行数为 0 时回滚并返回 QUOTA_EXCEEDED（多实例合计不超卖）；
+            // 时段增量锁定 HOSPITAL_SLOT_TEMPLATE 对应时段行（FOR UPDATE），校验该时段有效订单数 + 增量 <= 容量，
+            // 超出时回滚并返回 SLOT_FULL（多实例合计不超出时段容量）；
+            // 回滚前执行完全部增量，把影响行数为 0 / 超出容量的下标写入 overflow，组提交器只拆出这些键的订单
+            ReserveOrderCommitter::GetInstance().Start(
+                [](const std::vector<ReserveOrder>& orders, const std::vector<ReserveQuotaDelta>& deltas,
+                   const std::vector<ReserveSlotDelta>& slot_deltas, ReserveCommitOverflow& overflow) {
+                    return HospitalDao::SaveReserveOrdersWithQuota(orders, deltas, slot_deltas, overflow);
+                });
+        });
+        return ReserveOrderCommitter::GetInstance();
+    }
+
+    // 预约过期扫描（首次使用时设置扫描/过期回调）
+    static ReserveExpirySweeper& ExpirySweeper() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            ReserveExpirySweeper::GetInstance().Configure(
+                // 键集分页：status = 待就诊 AND reserve_date < before_date AND (reserve_date, order_id) > 游标，走 idx_status_date
+                [](const std::string& before_date, const std::string& after_date, const std::string& after_order_id,
+                   size_t limit, std::vector<ReserveOrderKey>& out) {
+                    return HospitalDao::ScanExpiredReserveOrders(before_date, after_date, after_order_id, limit, out);
+                },
+                [](const std::vector<std::string>& order_ids, int64_t now) {
+                    return ExpireReserveOrders(order_ids, now);
+                },
+                [] { return TimeUtil::GetInstance().GetCurrentDate(); });
+        });
+        return ReserveExpirySweeper::GetInstance();
+    }
+
+    // 辅助函数：批量过期并归还号源
+    // 一个事务：SELECT ... FOR UPDATE 锁定仍为“待就诊”且 is_quota_recovered = 0 的订单，置为“已过期”并标记
+    // is_quota_recovered，再按 (医院, 科室, 日期) GROUP BY 汇总后一次性扣回 HOSPITAL_QUOTA.used_quota、
+    // 加回 HOSPITAL_INFO.available_quota；返回实际过期的订单数，失败返回 -1
+    static int64_t ExpireReserveOrders(const std::vector<std::string>& order_ids, int64_t now) {
+        return HospitalDao::ExpireReserveOrdersWithQuota(order_ids, now);
+    }
+
+    // 辅助函数：预约日期（yyyy-mm-dd）的次日零点，即预约过期时间
+    static int64_t ReserveDateExpireTime(const std::string& reserve_date) {
+        std::tm tm = {};
+        if (std::sscanf(reserve_date.c_str(), "%d-%d-%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday) != 3) {
+            return TimeUtil::GetCurrentTimestamp();
+        }
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+        tm.tm_mday += 1;
+        tm.tm_isdst = -1;
+        return static_cast<int64_t>(std::mktime(&tm));
+    }
+
+    // 医院目录（首次使用时设置加载回调，之后每 5 分钟自动刷新）
+    static HospitalCatalog& Catalog() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            HospitalCatalog::GetInstance().Configure([] { return HospitalDao::QueryAllHospitals(); });
+            HospitalCatalog::GetInstance().StartAutoRefresh();
+        });
+        return HospitalCatalog::GetInstance();
+    }
+
+    // 辅助函数：医院模型 → 列表DTO
+    static HospitalDTO BuildHospitalDTO(const Hospital& hosp, double distance) {
+        HospitalDTO dto;
+        dto.id = hosp.id;
+        dto.name = hosp.name;
+        dto.address = hosp.address;
+        dto.phone = hosp.phone;
+        dto.distance = distance;
+        dto.status = hosp.available_quota > 0 ? "可预约" : "约满";
+        dto.available_quota = hosp.available_quota;
+        return dto;
+    }
+
     // 辅助函数：计算经纬度直线距离（Haversine公式）
     static double CalculateDistance(double lat1, double lon1, double lat2, double lon2) {
-        const double R = 6371.0; // 地球半径（km）
-        double dLat = (lat2 - lat1) * M_PI / 180.0;
-        double dLon = (lon2 - lon1) * M_PI / 180.0;
-        double a = sin(dLat / 2) * sin(dLat / 2) +
-                   cos(lat1 * M_PI / 180.0) * cos(lat2 * M_PI / 180.0) *
-                   sin(dLon / 2) * sin(dLon / 2);
-        double c = 2 * atan2(sqrt(a), sqrt(1 - a));
-        return round(R * c * 10) / 10; // 保留1位小数
+        return GeoUtil::RoundDistance(GeoUtil::HaversineKm(lat1, lon1, lat2, lon2)); // 保留1位小数
     }
 
-    // 辅助函数：生成唯一订单号（用户ID+时间戳+随机数）
+    // 辅助函数：生成唯一订单号（64 位ID 的十进制形式）
     static std::string GenerateOrderId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("{}{}{}", 
-            TimeUtil::GetInstance().GetCurrentTimestamp(), 
-            dis(gen), 
-            std::hash<std::thread::id>{}(std::this_thread::get_id()) % 1000);
+        return IdGenerator::GetInstance().NextString();
     }
 };
 
@@ -141,11 +488,18 @@ struct HospitalDTO {
     int available_quota; // 剩余配额
 };
 
+struct HospitalSearchPage {
+    std::vector<HospitalDTO> items;  // 本页医院（按距离升序）
+    std::string next_cursor;         // 下一页游标（为空表示没有下一页）
+    size_t total = 0;                // 当前游标之后满足条件的医院数
+};
+
 struct ReserveOrderDTO {
     std::string order_id;
     std::string hospital_name;
     std::string department;
     std::string reserve_date;
+    std::string reserve_period; // 就诊时段
     std::string status;
     std::string create_time;
 };
\ No newline at end of file
@@ -0,0 +1,394 @@
+#ifndef HOSPITAL_CATALOG_H
+#define HOSPITAL_CATALOG_H
+
+#include "model/hospital.h"
+#include "util/geo_batch.h"
+#include "service/hospital_geo_index.h"
+#include "service/hospital_catalog_file.h"
+#include "service/hospital_filter_table.h"
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <ctime>
+#include <unordered_map>
+#include <string_view>
+#include <utility>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 医院目录快照：一次加载的 HOSPITAL_INFO 全量数据及其索引，构建完成后只读
+ * - 数据库加载：医院保存在 hospitals 中
+ * - 文件加载：快照在存活期间一直持有文件映射，ID 查找与科室倒排直接引用映射中的数据；
+ *   Hospital 对象只在首次被访问（构造DTO、下单校验）时从映射还原并缓存，冷启动不需要把全部医院读出来
+ * 两种来源对外接口一致，行号即医院在 hospitals 或文件中的下标，地理索引、筛选表与分页查询都按行号工作
+ */
+struct HospitalCatalogSnapshot {
+    uint64_t version = 0;                     // 快照版本（每次刷新递增）
+    int64_t load_time = 0;                    // 加载时间（秒级时间戳）
+    std::vector<Hospital> hospitals;          // 数据库加载的全部医院（文件加载时为空）
+    std::shared_ptr<const MappedHospitalCatalog> file;                           // 文件加载时的映射
+    std::vector<std::string> departments;     // 全部科室（去重、排序）
+    std::vector<uint32_t> postings;           // 数据库加载时的科室倒排表（各科室按 departments 顺序连续存放）
+    std::unordered_map<std::string, HospitalRows> by_department;                 // 科室 → 行号（指向 postings 或映射）
+    std::unordered_map<std::string, GeoPointArray> department_points;            // 科室 → 坐标（与倒排顺序一致）
+    std::unordered_map<std::string_view, uint32_t> by_id;                        // 医院ID → 行号（视图指向 hospitals 或映射）
+    std::shared_ptr<const HospitalGeoIndex> geo_index;                           // 按科室的地理索引
+    HospitalFilterTable filter_table;                                            // 多条件筛选表
+    // 文件加载时各行医院的科室（departments 下标），第 row 行为 row_departments[row_department_begin[row], [row + 1])
+    std::vector<uint32_t> row_department_begin;
+    std::vector<uint32_t> row_departments;
+    mutable std::unique_ptr<std::atomic<const Hospital*>[]> materialized;       // 文件加载时已还原的医院
+
+    HospitalCatalogSnapshot() = default;
+    HospitalCatalogSnapshot(const HospitalCatalogSnapshot&) = delete; // 索引指向 hospitals 与映射内部，禁止拷贝
+    HospitalCatalogSnapshot& operator=(const HospitalCatalogSnapshot&) = delete;
+
+    ~HospitalCatalogSnapshot() {
+        if (materialized) {
+            for (size_t row = 0; row < Size(); ++row) {
+                delete materialized[row].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t Size() const { return file ? file->HospitalCount() : hospitals.size(); }
+
+    /**
+     * 第 row 行的医院（文件加载时首次访问从映射还原，并发首访只保留一份）
+     */
+    const Hospital& At(uint32_t row) const {
+        if (!file) {
+            return hospitals[row];
+        }
+        const Hospital* hosp = materialized[row].load(std::memory_order_acquire);
+        if (hosp != nullptr) {
+            return *hosp;
+        }
+        std::unique_ptr<Hospital> fresh(new Hospital(file->ToHospital(row)));
+        for (uint32_t k = row_department_begin[row]; k < row_department_begin[row + 1]; ++k) {
+            fresh->departments.push_back(departments[row_departments[k]]);
+        }
+        const Hospital* expected = nullptr;
+        if (materialized[row].compare_exchange_strong(expected, fresh.get(), std::memory_order_acq_rel)) {
+            return *fresh.release();
+        }
+        return *expected;
+    }
+
+    std::string_view IdOf(uint32_t row) const {
+        return file ? file->Field(row, hospital_catalog_file::ID) : std::string_view(hospitals[row].id);
+    }
+
+    int AvailableQuotaOf(uint32_t row) const {
+        return file ? file->AvailableQuota(row) : hospitals[row].available_quota;
+    }
+
+    bool FindRow(std::string_view hospital_id, uint32_t& row) const {
+        auto it = by_id.find(hospital_id);
+        if (it == by_id.end()) {
+            return false;
+        }
+        row = it->second;
+        return true;
+    }
+
+    const Hospital* FindHospital(const std::string& hospital_id) const {
+        uint32_t row = 0;
+        return FindRow(hospital_id, row) ? &At(row) : nullptr;
+    }
+
+    HospitalRows RowsOf(const std::string& department) const {
+        auto it = by_department.find(department);
+        return it == by_department.end() ? HospitalRows() : it->second;
+    }
+
+    const GeoPointArray& PointsOf(const std::string& department) const {
+        static const GeoPointArray empty;
+        auto it = department_points.find(department);
+        return it == department_points.end() ? empty : it->second;
+    }
+};
+
+/**
+ * 医院目录缓存：医院与科室信息的只读快照（RCU 方式发布）
+ * - 读者通过 atomic_load 拿到当前快照的 shared_ptr，之后的访问不加锁、不拷贝数据
+ * - 刷新时在后台构建新快照，再用 atomic_store 整体替换；旧快照在最后一个读者释放后析构
+ * - 支持按需刷新（医院信息变更后调用 Refresh）与定时刷新（StartAutoRefresh）
+ * - 冷启动可从二进制目录文件加载（LoadFromFile），不访问数据库、不解析 JSON，也不把医院逐个还原为对象：
+ *   快照持有映射并直接从中提供 ID 查找与科室倒排，映射随快照一起释放
+ */
+class HospitalCatalog {
+public:
+    // 加载全部医院（departments 已由 JSON 列解析）
+    using Loader = std::function<std::vector<Hospital>()>;
+
+    static HospitalCatalog& GetInstance() {
+        static HospitalCatalog instance;
+        return instance;
+    }
+
+    HospitalCatalog(const HospitalCatalog&) = delete;
+    HospitalCatalog& operator=(const HospitalCatalog&) = delete;
+
+    /**
+     * 设置加载回调与地理索引网格大小（启动时调用一次）
+     */
+    void Configure(Loader loader, double cell_deg = 0.02) {
+        std::lock_guard<std::mutex> lock(refresh_mutex_);
+        loader_ = std::move(loader);
+        cell_deg_ = cell_deg;
+    }
+
+    /**
+     * 当前快照（尚未加载时同步加载一次；加载失败返回空快照）
+     */
+    std::shared_ptr<const HospitalCatalogSnapshot> Snapshot() {
+        auto snapshot = std::atomic_load(&snapshot_);
+        if (!snapshot) {
+            Refresh();
+            snapshot = std::atomic_load(&snapshot_);
+        }
+        return snapshot;
+    }
+
+    /**
+     * 重新加载并发布新快照（并发调用时串行执行）
+     * @return 是否加载成功（失败时保留旧快照）
+     */
+    bool Refresh() {
+        std::lock_guard<std::mutex> lock(refresh_mutex_);
+        std::vector<Hospital> hospitals;
+        try {
+            if (!loader_) {
+                throw std::runtime_error("未设置加载回调");
+            }
+            hospitals = loader_();
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("医院目录加载失败，error={}", e.what());
+            if (!std::atomic_load(&snapshot_)) {
+                // 首次加载失败时发布空快照，避免每个读者都去访问数据库
+                std::atomic_store(&snapshot_, Build({}, 0));
+            }
+            return false;
+        }
+        auto snapshot = Build(std::move(hospitals), ++version_);
+        SPDLOG_INFO("医院目录已刷新，version={}, hospitals={}, departments={}",
+                    snapshot->version, snapshot->Size(), snapshot->departments.size());
+        std::atomic_store(&snapshot_, std::move(snapshot));
+        return true;
+    }
+
+    /**
+     * 从二进制目录文件发布快照（冷启动用，之后由定时刷新回到数据库）
+     * 省去数据库往返、departments 列的 JSON 解析与全部 Hospital 对象的构造；只在内存中构建数值索引
+     * （坐标、筛选表编码列），字符串字段在查询时从映射读取
+     * @return 是否加载成功（失败时保留现有快照）
+     */
+    bool LoadFromFile(const std::string& path) {
+        std::lock_guard<std::mutex> lock(refresh_mutex_);
+        std::shared_ptr<const MappedHospitalCatalog> file;
+        try {
+            file = std::make_shared<const MappedHospitalCatalog>(path);
+        } catch (const std::exception& e) {
+            SPDLOG_WARN("医院目录文件加载失败，path={}, error={}", path, e.what());
+            return false;
+        }
+        version_ = std::max(version_ + 1, file->CatalogVersion());
+        auto snapshot = BuildFromFile(std::move(file), version_);
+        SPDLOG_INFO("医院目录已从文件加载，path={}, version={}, hospitals={}",
+                    path, snapshot->version, snapshot->Size());
+        std::atomic_store(&snapshot_, std::move(snapshot));
+        return true;
+    }
+
+    /**
+     * 把当前快照写成二进制目录文件（供其他实例冷启动使用）
+     */
+    void ExportToFile(const std::string& path) {
+        auto snapshot = Snapshot();
+        if (!snapshot->file) {
+            HospitalCatalogFileWriter::Write(path, snapshot->hospitals, snapshot->version);
+            return;
+        }
+        std::vector<Hospital> hospitals;
+        hospitals.reserve(snapshot->Size());
+        for (uint32_t row = 0; row < snapshot->Size(); ++row) {
+            hospitals.push_back(snapshot->At(row));
+        }
+        HospitalCatalogFileWriter::Write(path, hospitals, snapshot->version);
+    }
+
+    /**
+     * 启动定时刷新线程
+     */
+    void StartAutoRefresh(int interval_ms = 300000) {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        if (running_) {
+            return;
+        }
+        running_ = true;
+        worker_ = std::thread([this, interval_ms] {
+            std::unique_lock<std::mutex> lock(stop_mutex_);
+            while (!stop_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms), [this] { return !running_; })) {
+                lock.unlock();
+                Refresh();
+                lock.lock();
+            }
+        });
+    }
+
+    void StopAutoRefresh() {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        stop_cv_.notify_all();
+        worker_.join();
+    }
+
+    uint64_t Version() const {
+        auto snapshot = std::atomic_load(&snapshot_);
+        return snapshot ? snapshot->version : 0;
+    }
+
+private:
+    HospitalCatalog() = default;
+    ~HospitalCatalog() { StopAutoRefresh(); }
+
+    std::shared_ptr<const HospitalCatalogSnapshot> Build(std::vector<Hospital> hospitals, uint64_t version) const {
+        auto snapshot = std::make_shared<HospitalCatalogSnapshot>();
+        snapshot->version = version;
+        snapshot->load_time = static_cast<int64_t>(std::time(nullptr));
+        snapshot->hospitals = std::move(hospitals);
+
+        std::unordered_map<std::string, std::vector<uint32_t>> dept_rows;
+        for (uint32_t row = 0; row < snapshot->hospitals.size(); ++row) {
+            const Hospital& hosp = snapshot->hospitals[row];
+            snapshot->by_id[hosp.id] = row;
+            for (const auto& department : hosp.departments) {
+                auto& list = dept_rows[department];
+                if (list.empty() || list.back() != row) { // 同一医院重复填写的科室只计一次
+                    list.push_back(row);
+                }
+            }
+        }
+        for (const auto& item : dept_rows) {
+            snapshot->departments.push_back(item.first);
+        }
+        std::sort(snapshot->departments.begin(), snapshot->departments.end());
+        std::vector<size_t> begins;
+        for (const auto& department : snapshot->departments) {
+            const auto& list = dept_rows[department];
+            begins.push_back(snapshot->postings.size());
+            snapshot->postings.insert(snapshot->postings.end(), list.begin(), list.end());
+        }
+        for (size_t d = 0; d < snapshot->departments.size(); ++d) {
+            snapshot->by_department[snapshot->departments[d]] =
+                HospitalRows(snapshot->postings.data() + begins[d], dept_rows[snapshot->departments[d]].size());
+        }
+
+        const std::vector<Hospital>& rows = snapshot->hospitals;
+        snapshot->filter_table = HospitalFilterTable(rows.size(),
+            [&rows](size_t i) { return HospitalFilterRow::Of(rows[i]); });
+        BuildDepartmentIndexes(*snapshot,
+            [&rows](uint32_t row) { return std::make_pair(rows[row].latitude, rows[row].longitude); });
+        return snapshot;
+    }
+
+    /**
+     * 基于文件映射构建快照：ID 与科室倒排引用映射，只在内存中生成数值索引
+     */
+    std::shared_ptr<const HospitalCatalogSnapshot> BuildFromFile(std::shared_ptr<const MappedHospitalCatalog> file,
+                                                                 uint64_t version) const {
+        using namespace hospital_catalog_file;
+        auto snapshot = std::make_shared<HospitalCatalogSnapshot>();
+        snapshot->version = version;
+        snapshot->load_time = static_cast<int64_t>(std::time(nullptr));
+        const MappedHospitalCatalog& mapped = *file;
+        const uint32_t n = mapped.HospitalCount();
+
+        snapshot->by_id.reserve(n);
+        for (uint32_t row = 0; row < n; ++row) {
+            snapshot->by_id[mapped.Field(row, ID)] = row;
+        }
+        // 科室目录在文件中已按名称排序；同时按倒排表统计每行的科室（还原 Hospital 时使用）
+        snapshot->row_department_begin.assign(static_cast<size_t>(n) + 1, 0);
+        for (uint32_t d = 0; d < mapped.DepartmentCount(); ++d) {
+            snapshot->departments.emplace_back(mapped.DepartmentName(d));
+            uint32_t count = 0;
+            const uint32_t* rows = mapped.PostingsAt(d, count);
+            snapshot->by_department[snapshot->departments.back()] = HospitalRows(rows, count);
+            for (uint32_t k = 0; k < count; ++k) {
+                ++snapshot->row_department_begin[rows[k] + 1];
+            }
+        }
+        for (uint32_t row = 0; row < n; ++row) {
+            snapshot->row_department_begin[row + 1] += snapshot->row_department_begin[row];
+        }
+        snapshot->row_departments.resize(snapshot->row_department_begin[n]);
+        std::vector<uint32_t> fill(snapshot->row_department_begin.begin(), snapshot->row_department_begin.end() - 1);
+        for (uint32_t d = 0; d < mapped.DepartmentCount(); ++d) {
+            uint32_t count = 0;
+            const uint32_t* rows = mapped.PostingsAt(d, count);
+            for (uint32_t k = 0; k < count; ++k) {
+                snapshot->row_departments[fill[rows[k]]++] = d;
+            }
+        }
+        snapshot->materialized.reset(new std::atomic<const Hospital*>[n]());
+
+        snapshot->filter_table = HospitalFilterTable(n, [&mapped](size_t i) {
+            uint32_t row = static_cast<uint32_t>(i);
+            return HospitalFilterRow{mapped.Field(row, LEVEL), mapped.Field(row, TYPE), mapped.Field(row, STATUS),
+                                     mapped.Field(row, OPENING_HOURS), mapped.IsElderlyFriendly(row),
+                                     mapped.AvailableQuota(row), mapped.Latitude(row), mapped.Longitude(row)};
+        });
+        BuildDepartmentIndexes(*snapshot,
+            [&mapped](uint32_t row) { return std::make_pair(mapped.Latitude(row), mapped.Longitude(row)); });
+        snapshot->file = std::move(file);
+        return snapshot;
+    }
+
+    /**
+     * 按科室倒排表生成坐标数组、地理索引与筛选表科室位图（两种加载方式共用）
+     * @param position_at 行号 → (纬度, 经度)
+     */
+    template <typename PositionAt>
+    void BuildDepartmentIndexes(HospitalCatalogSnapshot& snapshot, PositionAt position_at) const {
+        auto geo_index = std::make_shared<HospitalGeoIndex>(cell_deg_);
+        for (const auto& item : snapshot.by_department) {
+            GeoPointArray& points = snapshot.department_points[item.first];
+            points.Reserve(item.second.size());
+            for (uint32_t row : item.second) {
+                auto position = position_at(row);
+                points.Add(position.first, position.second);
+            }
+            geo_index->AddDepartment(item.first, std::vector<uint32_t>(item.second.begin(), item.second.end()), points);
+            snapshot.filter_table.AddDepartment(item.first, item.second);
+        }
+        snapshot.geo_index = std::move(geo_index);
+    }
+
+    std::shared_ptr<const HospitalCatalogSnapshot> snapshot_;   // 通过 atomic_load/atomic_store 访问
+
+    std::mutex refresh_mutex_;
+    Loader loader_;
+    double cell_deg_ = 0.02;
+    uint64_t version_ = 0;
+
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool running_ = false;
+    std::thread worker_;
+};
+
+#endif // HOSPITAL_CATALOG_H
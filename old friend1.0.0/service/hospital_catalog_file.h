@@ -0,0 +1,453 @@
+#ifndef HOSPITAL_CATALOG_FILE_H
+#define HOSPITAL_CATALOG_FILE_H
+
+#include "model/hospital.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * 医院目录二进制文件格式（小端、各段 8 字节对齐）
+ * [Header]
+ * [数值列]     latitude[n] longitude[n]（double），daily_quota[n] available_quota[n] advance_days[n] flags[n]（int32）
+ * [字符串引用] StrRef[kStringFields][n]，按字段分列
+ * [可预约日期] ListRef[n] + StrRef[...]
+ * [科室目录]   DeptEntry[m]，按科室名排序
+ * [倒排表]     uint32 医院下标，每个科室一段，段内按医院下标升序
+ * [字符串表]   所有字符串顺序存放（不以 0 结尾）
+ */
+namespace hospital_catalog_file {
+
+constexpr char kMagic[8] = {'H', 'C', 'A', 'T', 'B', 'I', 'N', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+
+// 字符串列（顺序即文件中的列顺序，只能在末尾追加并升级 kFormatVersion）
+enum StringField : uint32_t {
+    ID = 0, NAME, LEVEL, TYPE, STATUS, ADDRESS, PHONE, EMERGENCY_PHONE, ELDERLY_SERVICE, OPENING_HOURS,
+    kStringFields
+};
+
+constexpr uint32_t kFlagElderlyFriendly = 1u;
+
+struct StrRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct ListRef {
+    uint32_t begin;
+    uint32_t count;
+};
+
+struct DeptEntry {
+    StrRef name;
+    ListRef postings;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t hospital_count;
+    uint64_t catalog_version;       // 目录版本（构建方指定，通常取数据变更序号或构建时间）
+    int64_t build_time;
+    uint32_t department_count;
+    uint32_t day_ref_count;
+    uint64_t latitude_off;
+    uint64_t longitude_off;
+    uint64_t ints_off;              // 4 个 int32 列依次存放
+    uint64_t strings_off;           // StrRef[kStringFields][n]
+    uint64_t day_lists_off;
+    uint64_t day_refs_off;
+    uint64_t depts_off;
+    uint64_t postings_off;
+    uint64_t postings_count;
+    uint64_t string_table_off;
+    uint64_t string_table_size;
+    uint64_t file_size;
+    uint64_t checksum;              // Header 之后全部字节的 FNV-1a
+};
+
+inline uint64_t Fnv1a(const unsigned char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline uint64_t Align8(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+} // namespace hospital_catalog_file
+
+/**
+ * 医院目录文件构建（离线工具或运维接口调用，从数据库导出后写入）
+ * 先写临时文件再 rename，正在映射旧文件的进程不受影响
+ */
+class HospitalCatalogFileWriter {
+public:
+    static void Write(const std::string& path, const std::vector<Hospital>& hospitals, uint64_t catalog_version) {
+        using namespace hospital_catalog_file;
+        const uint32_t n = static_cast<uint32_t>(hospitals.size());
+
+        std::string strings;
+        auto intern = [&strings](const std::string& value) {
+            if (strings.size() + value.size() > UINT32_MAX) {
+                throw std::runtime_error("医院目录字符串表超过 4GB");
+            }
+            StrRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+            strings.append(value);
+            return ref;
+        };
+
+        std::vector<double> latitude(n), longitude(n);
+        std::vector<int32_t> ints(4 * static_cast<size_t>(n));
+        std::vector<StrRef> string_cols(kStringFields * static_cast<size_t>(n));
+        std::vector<ListRef> day_lists(n);
+        std::vector<StrRef> day_refs;
+        std::map<std::string, std::vector<uint32_t>> postings; // 有序：科室目录按名称排序
+        for (uint32_t i = 0; i < n; ++i) {
+            const Hospital& hosp = hospitals[i];
+            latitude[i] = hosp.latitude;
+            longitude[i] = hosp.longitude;
+            ints[i] = hosp.daily_quota;
+            ints[n + i] = hosp.available_quota;
+            ints[2 * n + i] = hosp.advance_days;
+            ints[3 * n + i] = hosp.is_elderly_friendly ? kFlagElderlyFriendly : 0;
+            const std::string* fields[kStringFields] = {
+                &hosp.id, &hosp.name, &hosp.level, &hosp.type, &hosp.status, &hosp.address, &hosp.phone,
+                &hosp.emergency_phone, &hosp.elderly_service, &hosp.opening_hours};
+            for (uint32_t f = 0; f < kStringFields; ++f) {
+                string_cols[f * n + i] = intern(*fields[f]);
+            }
+            day_lists[i] = ListRef{static_cast<uint32_t>(day_refs.size()), static_cast<uint32_t>(hosp.reserve_days.size())};
+            for (const auto& day : hosp.reserve_days) {
+                day_refs.push_back(intern(day));
+            }
+            for (const auto& department : hosp.departments) {
+                auto& list = postings[department];
+                if (list.empty() || list.back() != i) list.push_back(i);
+            }
+        }
+
+        std::vector<DeptEntry> depts;
+        std::vector<uint32_t> posting_data;
+        for (const auto& item : postings) {
+            DeptEntry entry;
+            entry.name = intern(item.first);
+            entry.postings = ListRef{static_cast<uint32_t>(posting_data.size()), static_cast<uint32_t>(item.second.size())};
+            posting_data.insert(posting_data.end(), item.second.begin(), item.second.end());
+            depts.push_back(entry);
+        }
+
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.format_version = kFormatVersion;
+        header.hospital_count = n;
+        header.catalog_version = catalog_version;
+        header.build_time = static_cast<int64_t>(std::time(nullptr));
+        header.department_count = static_cast<uint32_t>(depts.size());
+        header.day_ref_count = static_cast<uint32_t>(day_refs.size());
+
+        std::string body;
+        uint64_t base = Align8(sizeof(Header));
+        auto append = [&body, base](const void* data, size_t size) {
+            body.resize(Align8(base + body.size()) - base, '\0');
+            uint64_t offset = base + body.size();
+            body.append(static_cast<const char*>(data), size);
+            return offset;
+        };
+        header.latitude_off = append(latitude.data(), latitude.size() * sizeof(double));
+        header.longitude_off = append(longitude.data(), longitude.size() * sizeof(double));
+        header.ints_off = append(ints.data(), ints.size() * sizeof(int32_t));
+        header.strings_off = append(string_cols.data(), string_cols.size() * sizeof(StrRef));
+        header.day_lists_off = append(day_lists.data(), day_lists.size() * sizeof(ListRef));
+        header.day_refs_off = append(day_refs.data(), day_refs.size() * sizeof(StrRef));
+        header.depts_off = append(depts.data(), depts.size() * sizeof(DeptEntry));
+        header.postings_off = append(posting_data.data(), posting_data.size() * sizeof(uint32_t));
+        header.postings_count = posting_data.size();
+        header.string_table_off = append(strings.data(), strings.size());
+        header.string_table_size = strings.size();
+        header.file_size = base + body.size();
+        header.checksum = Fnv1a(reinterpret_cast<const unsigned char*>(body.data()), body.size());
+
+        std::string tmp_path = path + ".tmp";
+        FILE* file = std::fopen(tmp_path.c_str(), "wb");
+        if (file == nullptr) {
+            throw std::runtime_error("无法写入医院目录文件：" + tmp_path);
+        }
+        char padding[8] = {0};
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  std::fwrite(padding, 1, base - sizeof(header), file) == base - sizeof(header) &&
+                  std::fwrite(body.data(), 1, body.size(), file) == body.size();
+        ok = std::fflush(file) == 0 && ok;
+        ok = fsync(fileno(file)) == 0 && ok;
+        std::fclose(file);
+        if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("医院目录文件写入失败：" + path);
+        }
+    }
+};
+
+/**
+ * 只读映射的医院目录文件：打开即可按下标读取字段、按科室读取倒排表，字段按需从映射中读取（零拷贝）
+ * 文件在对象生命周期内保持映射；返回的 string_view 与指针在对象析构前有效
+ * 打开时校验各段边界以及所有字符串引用、日期列表、倒排表下标，损坏的文件不会导致越界读取
+ */
+class MappedHospitalCatalog {
+public:
+    /**
+     * @param verify_checksum 是否校验全文件校验和（会读入全部页面，默认只做结构校验）
+     */
+    explicit MappedHospitalCatalog(const std::string& path, bool verify_checksum = false) {
+        using namespace hospital_catalog_file;
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("无法打开医院目录文件：" + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw std::runtime_error("医院目录文件格式错误：" + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            throw std::runtime_error("医院目录文件映射失败：" + path);
+        }
+        base_ = static_cast<const unsigned char*>(addr);
+        header_ = reinterpret_cast<const Header*>(base_);
+        try {
+            Validate(verify_checksum);
+        } catch (...) {
+            ::munmap(const_cast<unsigned char*>(base_), size_);
+            throw;
+        }
+        latitude_ = At<double>(header_->latitude_off);
+        longitude_ = At<double>(header_->longitude_off);
+        ints_ = At<int32_t>(header_->ints_off);
+        strings_ = At<StrRef>(header_->strings_off);
+        day_lists_ = At<ListRef>(header_->day_lists_off);
+        day_refs_ = At<StrRef>(header_->day_refs_off);
+        depts_ = At<DeptEntry>(header_->depts_off);
+        postings_ = At<uint32_t>(header_->postings_off);
+        string_table_ = reinterpret_cast<const char*>(base_ + header_->string_table_off);
+    }
+
+    ~MappedHospitalCatalog() {
+        if (base_ != nullptr) {
+            ::munmap(const_cast<unsigned char*>(base_), size_);
+        }
+    }
+
+    MappedHospitalCatalog(const MappedHospitalCatalog&) = delete;
+    MappedHospitalCatalog& operator=(const MappedHospitalCatalog&) = delete;
+
+    uint64_t CatalogVersion() const { return header_->catalog_version; }
+    int64_t BuildTime() const { return header_->build_time; }
+    uint32_t HospitalCount() const { return header_->hospital_count; }
+    uint32_t DepartmentCount() const { return header_->department_count; }
+
+    double Latitude(uint32_t i) const { return latitude_[i]; }
+    double Longitude(uint32_t i) const { return longitude_[i]; }
+    int32_t DailyQuota(uint32_t i) const { return ints_[i]; }
+    int32_t AvailableQuota(uint32_t i) const { return ints_[header_->hospital_count + i]; }
+    int32_t AdvanceDays(uint32_t i) const { return ints_[2 * header_->hospital_count + i]; }
+    bool IsElderlyFriendly(uint32_t i) const {
+        return (ints_[3 * header_->hospital_count + i] & hospital_catalog_file::kFlagElderlyFriendly) != 0;
+    }
+
+    std::string_view Field(uint32_t i, hospital_catalog_file::StringField field) const {
+        return View(strings_[static_cast<size_t>(field) * header_->hospital_count + i]);
+    }
+
+    std::string_view DepartmentName(uint32_t d) const { return View(depts_[d].name); }
+
+    /**
+     * 科室倒排表（医院下标，升序）；科室不存在时返回 count = 0
+     */
+    const uint32_t* Postings(std::string_view department, uint32_t& count) const {
+        const hospital_catalog_file::DeptEntry* begin = depts_;
+        const hospital_catalog_file::DeptEntry* end = depts_ + header_->department_count;
+        auto it = std::lower_bound(begin, end, department,
+            [this](const hospital_catalog_file::DeptEntry& entry, std::string_view name) {
+                return View(entry.name) < name;
+            });
+        if (it == end || View(it->name) != department) {
+            count = 0;
+            return postings_;
+        }
+        count = it->postings.count;
+        return postings_ + it->postings.begin;
+    }
+
+    /**
+     * 第 d 个科室（按名称排序）的倒排表
+     */
+    const uint32_t* PostingsAt(uint32_t d, uint32_t& count) const {
+        count = depts_[d].postings.count;
+        return postings_ + depts_[d].postings.begin;
+    }
+
+    /**
+     * 还原第 i 家医院（不含 departments，科室由调用方按倒排表填写）
+     */
+    Hospital ToHospital(uint32_t i) const {
+        using namespace hospital_catalog_file;
+        Hospital hosp;
+        std::string* fields[kStringFields] = {
+            &hosp.id, &hosp.name, &hosp.level, &hosp.type, &hosp.status, &hosp.address, &hosp.phone,
+            &hosp.emergency_phone, &hosp.elderly_service, &hosp.opening_hours};
+        for (uint32_t f = 0; f < kStringFields; ++f) {
+            fields[f]->assign(Field(i, static_cast<StringField>(f)));
+        }
+        hosp.latitude = Latitude(i);
+        hosp.longitude = Longitude(i);
+        hosp.daily_quota = DailyQuota(i);
+        hosp.available_quota = AvailableQuota(i);
+        hosp.advance_days = AdvanceDays(i);
+        hosp.is_elderly_friendly = IsElderlyFriendly(i);
+        const ListRef& days = day_lists_[i];
+        hosp.reserve_days.reserve(days.count);
+        for (uint32_t k = 0; k < days.count; ++k) {
+            hosp.reserve_days.emplace_back(View(day_refs_[days.begin + k]));
+        }
+        return hosp;
+    }
+
+    /**
+     * 还原全部医院（导出与校验用）
+     */
+    std::vector<Hospital> ToHospitals() const {
+        const uint32_t n = header_->hospital_count;
+        std::vector<Hospital> hospitals;
+        hospitals.reserve(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            hospitals.push_back(ToHospital(i));
+        }
+        for (uint32_t d = 0; d < header_->department_count; ++d) {
+            std::string name(View(depts_[d].name));
+            const hospital_catalog_file::ListRef& list = depts_[d].postings;
+            for (uint32_t k = 0; k < list.count; ++k) {
+                hospitals[postings_[list.begin + k]].departments.push_back(name);
+            }
+        }
+        return hospitals;
+    }
+
+private:
+    template <typename T>
+    const T* At(uint64_t offset) const { return reinterpret_cast<const T*>(base_ + offset); }
+
+    std::string_view View(const hospital_catalog_file::StrRef& ref) const {
+        return std::string_view(string_table_ + ref.offset, ref.length);
+    }
+
+    void CheckRange(uint64_t offset, uint64_t bytes) const {
+        if (offset % 8 != 0 || offset > size_ || bytes > size_ - offset) {
+            throw std::runtime_error("医院目录文件已损坏");
+        }
+    }
+
+    void Validate(bool verify_checksum) const {
+        using namespace hospital_catalog_file;
+        if (std::memcmp(header_->magic, kMagic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error("不是医院目录文件");
+        }
+        if (header_->format_version != kFormatVersion) {
+            throw std::runtime_error("医院目录文件版本不兼容");
+        }
+        if (header_->file_size != size_) {
+            throw std::runtime_error("医院目录文件不完整");
+        }
+        const uint64_t n = header_->hospital_count;
+        CheckRange(header_->latitude_off, n * sizeof(double));
+        CheckRange(header_->longitude_off, n * sizeof(double));
+        CheckRange(header_->ints_off, 4 * n * sizeof(int32_t));
+        CheckRange(header_->strings_off, kStringFields * n * sizeof(StrRef));
+        CheckRange(header_->day_lists_off, n * sizeof(ListRef));
+        CheckRange(header_->day_refs_off, header_->day_ref_count * sizeof(StrRef));
+        CheckRange(header_->depts_off, header_->department_count * sizeof(DeptEntry));
+        CheckRange(header_->postings_off, header_->postings_count * sizeof(uint32_t));
+        if (header_->string_table_off > size_ || header_->string_table_size > size_ - header_->string_table_off) {
+            throw std::runtime_error("医院目录文件已损坏");
+        }
+
+        // 引用校验：字符串引用不超出字符串表，日期列表不超出日期引用，倒排表下标小于医院数
+        const uint64_t table_size = header_->string_table_size;
+        auto check_str = [table_size](const StrRef& ref) {
+            if (static_cast<uint64_t>(ref.offset) + ref.length > table_size) {
+                throw std::runtime_error("医院目录文件已损坏（字符串引用越界）");
+            }
+        };
+        const StrRef* strings = At<StrRef>(header_->strings_off);
+        for (uint64_t k = 0; k < kStringFields * n; ++k) {
+            check_str(strings[k]);
+        }
+        const StrRef* day_refs = At<StrRef>(header_->day_refs_off);
+        for (uint32_t k = 0; k < header_->day_ref_count; ++k) {
+            check_str(day_refs[k]);
+        }
+        const ListRef* day_lists = At<ListRef>(header_->day_lists_off);
+        for (uint64_t i = 0; i < n; ++i) {
+            if (static_cast<uint64_t>(day_lists[i].begin) + day_lists[i].count > header_->day_ref_count) {
+                throw std::runtime_error("医院目录文件已损坏（日期列表越界）");
+            }
+        }
+        const DeptEntry* depts = At<DeptEntry>(header_->depts_off);
+        const char* table = reinterpret_cast<const char*>(base_ + header_->string_table_off);
+        for (uint32_t d = 0; d < header_->department_count; ++d) {
+            check_str(depts[d].name);
+            if (static_cast<uint64_t>(depts[d].postings.begin) + depts[d].postings.count > header_->postings_count) {
+                throw std::runtime_error("医院目录文件已损坏（倒排表越界）");
+            }
+            // Postings 按科室名二分查找，要求严格升序
+            if (d > 0 && std::string_view(table + depts[d - 1].name.offset, depts[d - 1].name.length) >=
+                             std::string_view(table + depts[d].name.offset, depts[d].name.length)) {
+                throw std::runtime_error("医院目录文件已损坏（科室目录未排序）");
+            }
+        }
+        const uint32_t* postings = At<uint32_t>(header_->postings_off);
+        for (uint64_t k = 0; k < header_->postings_count; ++k) {
+            if (postings[k] >= n) {
+                throw std::runtime_error("医院目录文件已损坏（倒排表下标越界）");
+            }
+        }
+
+        if (verify_checksum) {
+            uint64_t body = Align8(sizeof(Header));
+            if (Fnv1a(base_ + body, size_ - body) != header_->checksum) {
+                throw std::runtime_error("医院目录文件校验和不匹配");
+            }
+        }
+    }
+
+    const unsigned char* base_ = nullptr;
+    size_t size_ = 0;
+    const hospital_catalog_file::Header* header_ = nullptr;
+    const double* latitude_ = nullptr;
+    const double* longitude_ = nullptr;
+    const int32_t* ints_ = nullptr;
+    const hospital_catalog_file::StrRef* strings_ = nullptr;
+    const hospital_catalog_file::ListRef* day_lists_ = nullptr;
+    const hospital_catalog_file::StrRef* day_refs_ = nullptr;
+    const hospital_catalog_file::DeptEntry* depts_ = nullptr;
+    const uint32_t* postings_ = nullptr;
+    const char* string_table_ = nullptr;
+};
+
+#endif // HOSPITAL_CATALOG_FILE_H
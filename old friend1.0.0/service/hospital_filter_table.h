@@ -0,0 +1,462 @@
+#ifndef HOSPITAL_FILTER_TABLE_H
+#define HOSPITAL_FILTER_TABLE_H
+
+#include "model/hospital.h"
+#include "util/geo_util.h"
+#include "util/geo_batch.h"
+#include "util/opening_hours.h"
+#include "service/hospital_search.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * 医院多条件筛选参数（各条件之间为“且”，同一条件内多个取值为“或”，空表示不限）
+ */
+struct HospitalFilter {
+    std::string department;              // 科室
+    std::vector<std::string> levels;     // 医院等级（如 "三级甲等"）
+    std::vector<std::string> types;      // 医院类型（如 "综合医院"）
+    std::vector<std::string> statuses;   // 服务状态（如 "enabled"）
+    bool elderly_friendly_only = false;  // 只看老年友好医院
+    bool available_only = false;         // 只看有剩余号源的医院（近似判断，见 HospitalSearchOptions::available_only）
+    int64_t open_at = 0;                 // >0 时只看该时刻（秒级时间戳）正在门诊的医院
+};
+
+/**
+ * 筛选表构建时读取的单行字段（字符串为视图，只需在构建期间有效）
+ */
+struct HospitalFilterRow {
+    std::string_view level;
+    std::string_view type;
+    std::string_view status;
+    std::string_view opening_hours;
+    bool elderly_friendly = false;
+    int available_quota = 0;
+    double latitude = 0.0;
+    double longitude = 0.0;
+
+    static HospitalFilterRow Of(const Hospital& hosp) {
+        return HospitalFilterRow{hosp.level, hosp.type, hosp.status, hosp.opening_hours,
+                                 hosp.is_elderly_friendly, hosp.available_quota, hosp.latitude, hosp.longitude};
+    }
+};
+
+/**
+ * 医院筛选表：全部医院按列存放（结构数组），供多条件筛选 + 按距离排序
+ * - level/type/status 字典编码为 1 字节整数（0 保留给补齐行），布尔条件合并为 1 字节标志位
+ * - 条件在编码上逐列比较，每 64 行得到一个位图字；x86-64 下用 AVX2/SSE2 一次比较 32/16 行
+ * - 科室条件为预先建好的位图，与其余条件按字相与
+ * - 门诊时间按文本去重后编译为周内区间，每行只存编号；“正在门诊”每次查询先对各编号判断一次，再按行查表
+ * - “有号源”标志位取自构建时目录中的 available_quota（医院级、随目录刷新），只是近似；
+ *   需要按日期的实时号源时由 Search 的 has_quota 在通过距离与游标过滤的行上逐行判断
+ * - 行号与目录快照的行号一致；构建后只读，可并发查询
+ * 每列最多编码 254 个不同取值（等级/类型/状态实际只有十余种），超出的取值无法作为筛选条件
+ */
+class HospitalFilterTable {
+public:
+    enum class Kernel {
+        SCALAR = 0,
+        SSE2 = 1,
+        AVX2 = 2
+    };
+
+    HospitalFilterTable() = default;
+
+    /**
+     * 按行构建（字段从目录快照或映射文件中按行读取，不需要 Hospital 对象）
+     * @param row_at 行号 → HospitalFilterRow；科室位图随后由 AddDepartment 写入
+     */
+    template <typename RowAt>
+    HospitalFilterTable(size_t rows, RowAt row_at) {
+        rows_ = rows;
+        size_t padded = (rows_ + 63) / 64 * 64;
+        level_.assign(padded, 0);
+        type_.assign(padded, 0);
+        status_.assign(padded, 0);
+        flags_.assign(padded, 0);
+        all_rows_.assign(padded / 64, 0);
+        schedule_.assign(padded, 0);
+        points_.Reserve(rows_);
+        std::unordered_map<std::string, uint32_t> schedule_ids;  // 门诊时间文本 → 编号
+        for (size_t i = 0; i < rows_; ++i) {
+            const HospitalFilterRow row = row_at(i);
+            level_[i] = level_dict_.Encode(row.level);
+            type_[i] = type_dict_.Encode(row.type);
+            status_[i] = status_dict_.Encode(row.status);
+            flags_[i] = static_cast<uint8_t>((row.elderly_friendly ? kFlagElderlyFriendly : 0) |
+                                             (row.available_quota > 0 ? kFlagAvailable : 0));
+            auto schedule = schedule_ids.emplace(std::string(row.opening_hours), static_cast<uint32_t>(schedules_.size()));
+            if (schedule.second) {
+                schedules_.push_back(OpeningHours::Compile(schedule.first->first));
+            }
+            schedule_[i] = schedule.first->second;
+            points_.Add(row.latitude, row.longitude);
+            all_rows_[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+
+    explicit HospitalFilterTable(const std::vector<Hospital>& hospitals)
+        : HospitalFilterTable(hospitals.size(), [&hospitals](size_t i) { return HospitalFilterRow::Of(hospitals[i]); }) {
+        for (uint32_t i = 0; i < hospitals.size(); ++i) {
+            for (const auto& department : hospitals[i].departments) {
+                auto& bits = department_rows_[department];
+                if (bits.empty()) bits.assign(all_rows_.size(), 0);
+                bits[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+    /**
+     * 写入科室位图（构建阶段调用，rows 为该科室的行号）
+     */
+    void AddDepartment(const std::string& department, HospitalRows rows) {
+        auto& bits = department_rows_[department];
+        bits.assign(all_rows_.size(), 0);
+        for (uint32_t row : rows) {
+            bits[row / 64] |= uint64_t(1) << (row % 64);
+        }
+    }
+
+    size_t Size() const { return rows_; }
+
+    /**
+     * 计算满足条件的行（位图，每字 64 行）
+     * @return 命中行数
+     */
+    size_t Match(const HospitalFilter& filter, std::vector<uint64_t>& bits) const {
+        return MatchWith(ActiveKernel(), filter, bits);
+    }
+
+    /**
+     * 指定实现筛选（用于结果校验与性能对比；CPU 不支持时退化为可用的最高实现）
+     */
+    size_t MatchWith(Kernel kernel, const HospitalFilter& filter, std::vector<uint64_t>& bits) const {
+        if (filter.department.empty()) {
+            bits = all_rows_;
+        } else {
+            auto it = department_rows_.find(filter.department);
+            if (it == department_rows_.end()) {
+                bits.assign(all_rows_.size(), 0);
+                return 0;
+            }
+            bits = it->second;
+        }
+
+        Predicate pred;
+        if (!AddColumn(pred, level_, level_dict_, filter.levels) ||
+            !AddColumn(pred, type_, type_dict_, filter.types) ||
+            !AddColumn(pred, status_, status_dict_, filter.statuses)) {
+            std::fill(bits.begin(), bits.end(), 0); // 取值不存在，结果为空
+            return 0;
+        }
+        pred.required_flags = static_cast<uint8_t>((filter.elderly_friendly_only ? kFlagElderlyFriendly : 0) |
+                                                    (filter.available_only ? kFlagAvailable : 0));
+
+        Kernel best = ActiveKernel();
+        Scan(kernel > best ? best : kernel, pred, bits);
+        if (filter.open_at > 0) {
+            int minute = OpeningHours::MinuteOfWeek(filter.open_at);
+            std::vector<uint8_t> open(schedules_.size());
+            for (size_t k = 0; k < schedules_.size(); ++k) {
+                open[k] = schedules_[k].IsOpenAtMinute(minute) ? 1 : 0;
+            }
+            for (size_t w = 0; w < bits.size(); ++w) {
+                uint64_t word = bits[w];
+                while (word != 0) {
+                    int bit = __builtin_ctzll(word);
+                    word &= word - 1;
+                    if (!open[schedule_[w * 64 + bit]]) {
+                        bits[w] &= ~(uint64_t(1) << bit);
+                    }
+                }
+            }
+        }
+        size_t count = 0;
+        for (uint64_t word : bits) {
+            count += static_cast<size_t>(__builtin_popcountll(word));
+        }
+        return count;
+    }
+
+    /**
+     * 多条件筛选后按距离分页
+     * @param id_at 行号 → 医院ID（std::string_view，只在距离相等与生成游标时调用）
+     * @param has_quota 设置时 available_only 改为逐行调用它判断（不使用构建时的近似标志位）
+     * @return 满足全部条件、位于游标之后的医院总数
+     */
+    template <typename IdAt>
+    size_t Search(const HospitalFilter& filter, double latitude, double longitude,
+                  const HospitalSearchOptions& options, IdAt id_at,
+                  std::vector<HospitalSearchHit>& hits, std::string& next_cursor,
+                  const HospitalQuotaPredicate& has_quota = nullptr) const {
+        std::vector<uint64_t> bits;
+        size_t count = 0;
+        HospitalQuotaPredicate quota;
+        if (filter.available_only && has_quota) {
+            // 实时号源在距离与游标过滤之后由 collector 逐行判断，位图只按其余条件筛选
+            HospitalFilter rest = filter;
+            rest.available_only = false;
+            count = Match(rest, bits);
+            quota = has_quota;
+        } else {
+            count = Match(filter, bits);
+        }
+        HospitalSearcher::PageCollector<IdAt> collector(options, id_at, std::move(quota));
+        // 命中较多时整表批量求距离；命中很少时逐行计算更省（同一查询各页命中数相同，走同一分支，游标比较一致）
+        std::vector<double> distances;
+        bool dense = count * 32 >= rows_;
+        if (dense && count > 0) {
+            GeoBatch::DistancesKm(latitude, longitude, points_, distances);
+        }
+        for (size_t w = 0; w < bits.size(); ++w) {
+            uint64_t word = bits[w];
+            while (word != 0) {
+                uint32_t row = static_cast<uint32_t>(w * 64 + __builtin_ctzll(word));
+                word &= word - 1;
+                collector.Offer(dense ? distances[row]
+                    : GeoUtil::HaversineKm(latitude, longitude, points_.latitude[row], points_.longitude[row]), row);
+            }
+        }
+        return collector.Finish(hits, next_cursor);
+    }
+
+    /**
+     * 编译后的门诊时间（行号即目录快照行号）
+     */
+    const OpeningHours& OpeningHoursAt(size_t row) const { return schedules_[schedule_[row]]; }
+
+    /**
+     * 某列的全部取值（按编码顺序，用于前端筛选项）
+     */
+    const std::vector<std::string>& Levels() const { return level_dict_.values; }
+    const std::vector<std::string>& Types() const { return type_dict_.values; }
+    const std::vector<std::string>& Statuses() const { return status_dict_.values; }
+
+    static Kernel ActiveKernel() {
+#ifdef GEO_BATCH_X86
+        static const Kernel kernel = __builtin_cpu_supports("avx2") ? Kernel::AVX2 : Kernel::SSE2;
+        return kernel;
+#else
+        return Kernel::SCALAR;
+#endif
+    }
+
+private:
+    static constexpr uint8_t kFlagElderlyFriendly = 1;
+    static constexpr uint8_t kFlagAvailable = 2;
+    static constexpr uint8_t kOverflowCode = 255;   // 超出 254 个取值后共用的编码
+    static constexpr int kMaxSimdCodes = 8;         // 单列超过该取值数时改用查表
+
+    // 字典：取值 → 编码（1..254），超出部分编码为 kOverflowCode
+    struct Dictionary {
+        std::vector<std::string> values;                 // values[code - 1]
+        std::unordered_map<std::string, uint8_t> codes;
+
+        uint8_t Encode(std::string_view value) {
+            std::string key(value);
+            auto it = codes.find(key);
+            if (it != codes.end()) return it->second;
+            if (values.size() + 1 >= kOverflowCode) return kOverflowCode;
+            values.push_back(key);
+            uint8_t code = static_cast<uint8_t>(values.size());
+            codes.emplace(std::move(key), code);
+            return code;
+        }
+
+        bool Find(const std::string& value, uint8_t& code) const {
+            auto it = codes.find(value);
+            if (it != codes.end()) {
+                code = it->second;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    struct Column {
+        const uint8_t* data = nullptr;
+        uint8_t codes[kMaxSimdCodes] = {0};
+        int code_count = 0;
+        bool use_lut = false;
+        bool lut[256] = {false};
+    };
+
+    struct Predicate {
+        Column columns[3];
+        int column_count = 0;
+        uint8_t required_flags = 0;
+    };
+
+    /**
+     * 把某列的取值条件加入谓词（没有条件时跳过）；全部取值都不存在时返回 false
+     * 不在字典中的取值（含超出编码上限的）不可能命中，直接忽略
+     */
+    static bool AddColumn(Predicate& pred, const std::vector<uint8_t>& data, const Dictionary& dict,
+                          const std::vector<std::string>& values) {
+        if (values.empty()) {
+            return true;
+        }
+        Column& column = pred.columns[pred.column_count];
+        column = Column();
+        column.data = data.data();
+        for (const auto& value : values) {
+            uint8_t code = 0;
+            if (!dict.Find(value, code) || column.lut[code]) continue;
+            column.lut[code] = true;
+            if (column.code_count < kMaxSimdCodes) {
+                column.codes[column.code_count] = code;
+            }
+            ++column.code_count;
+        }
+        if (column.code_count == 0) {
+            return false;
+        }
+        column.use_lut = column.code_count > kMaxSimdCodes;
+        ++pred.column_count;
+        return true;
+    }
+
+    void Scan(Kernel kernel, const Predicate& pred, std::vector<uint64_t>& bits) const {
+        if (pred.column_count == 0 && pred.required_flags == 0) {
+            return;
+        }
+        switch (kernel) {
+#ifdef GEO_BATCH_X86
+            case Kernel::AVX2: ScanAvx2(pred, bits); return;
+            case Kernel::SSE2: ScanSse2(pred, bits); return;
+#endif
+            default: ScanScalar(pred, bits); return;
+        }
+    }
+
+    static uint64_t ColumnWordScalar(const Column& column, size_t row) {
+        uint64_t mask = 0;
+        for (int i = 0; i < 64; ++i) {
+            mask |= uint64_t(column.lut[column.data[row + i]]) << i;
+        }
+        return mask;
+    }
+
+    static uint64_t FlagsWordScalar(const uint8_t* flags, uint8_t required, size_t row) {
+        uint64_t mask = 0;
+        for (int i = 0; i < 64; ++i) {
+            mask |= uint64_t((flags[row + i] & required) == required) << i;
+        }
+        return mask;
+    }
+
+    void ScanScalar(const Predicate& pred, std::vector<uint64_t>& bits) const {
+        for (size_t w = 0; w < bits.size(); ++w) {
+            uint64_t word = bits[w];
+            for (int c = 0; c < pred.column_count && word != 0; ++c) {
+                word &= ColumnWordScalar(pred.columns[c], w * 64);
+            }
+            if (word != 0 && pred.required_flags != 0) {
+                word &= FlagsWordScalar(flags_.data(), pred.required_flags, w * 64);
+            }
+            bits[w] = word;
+        }
+    }
+
+#ifdef GEO_BATCH_X86
+    static uint64_t ColumnWordSse2(const Column& column, size_t row) {
+        if (column.use_lut) return ColumnWordScalar(column, row);
+        uint64_t mask = 0;
+        for (int part = 0; part < 4; ++part) {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column.data + row + part * 16));
+            __m128i hit = _mm_setzero_si128();
+            for (int i = 0; i < column.code_count; ++i) {
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi8(values, _mm_set1_epi8(static_cast<char>(column.codes[i]))));
+            }
+            mask |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(hit)) & 0xFFFFu) << (part * 16);
+        }
+        return mask;
+    }
+
+    static uint64_t FlagsWordSse2(const uint8_t* flags, uint8_t required, size_t row) {
+        const __m128i req = _mm_set1_epi8(static_cast<char>(required));
+        uint64_t mask = 0;
+        for (int part = 0; part < 4; ++part) {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + row + part * 16));
+            __m128i hit = _mm_cmpeq_epi8(_mm_and_si128(values, req), req);
+            mask |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(hit)) & 0xFFFFu) << (part * 16);
+        }
+        return mask;
+    }
+
+    void ScanSse2(const Predicate& pred, std::vector<uint64_t>& bits) const {
+        for (size_t w = 0; w < bits.size(); ++w) {
+            uint64_t word = bits[w];
+            for (int c = 0; c < pred.column_count && word != 0; ++c) {
+                word &= ColumnWordSse2(pred.columns[c], w * 64);
+            }
+            if (word != 0 && pred.required_flags != 0) {
+                word &= FlagsWordSse2(flags_.data(), pred.required_flags, w * 64);
+            }
+            bits[w] = word;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static uint64_t ColumnWordAvx2(const Column& column, size_t row) {
+        if (column.use_lut) return ColumnWordScalar(column, row);
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column.data + row));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column.data + row + 32));
+        __m256i hit_lo = _mm256_setzero_si256();
+        __m256i hit_hi = _mm256_setzero_si256();
+        for (int i = 0; i < column.code_count; ++i) {
+            __m256i code = _mm256_set1_epi8(static_cast<char>(column.codes[i]));
+            hit_lo = _mm256_or_si256(hit_lo, _mm256_cmpeq_epi8(lo, code));
+            hit_hi = _mm256_or_si256(hit_hi, _mm256_cmpeq_epi8(hi, code));
+        }
+        return uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hit_lo))) |
+               (uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hit_hi))) << 32);
+    }
+
+    __attribute__((target("avx2")))
+    static uint64_t FlagsWordAvx2(const uint8_t* flags, uint8_t required, size_t row) {
+        const __m256i req = _mm256_set1_epi8(static_cast<char>(required));
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + row));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + row + 32));
+        __m256i hit_lo = _mm256_cmpeq_epi8(_mm256_and_si256(lo, req), req);
+        __m256i hit_hi = _mm256_cmpeq_epi8(_mm256_and_si256(hi, req), req);
+        return uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hit_lo))) |
+               (uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hit_hi))) << 32);
+    }
+
+    __attribute__((target("avx2")))
+    void ScanAvx2(const Predicate& pred, std::vector<uint64_t>& bits) const {
+        for (size_t w = 0; w < bits.size(); ++w) {
+            uint64_t word = bits[w];
+            for (int c = 0; c < pred.column_count && word != 0; ++c) {
+                word &= ColumnWordAvx2(pred.columns[c], w * 64);
+            }
+            if (word != 0 && pred.required_flags != 0) {
+                word &= FlagsWordAvx2(flags_.data(), pred.required_flags, w * 64);
+            }
+            bits[w] = word;
+        }
+    }
+#endif
+
+    size_t rows_ = 0;
+    std::vector<uint8_t> level_;
+    std::vector<uint8_t> type_;
+    std::vector<uint8_t> status_;
+    std::vector<uint8_t> flags_;
+    std::vector<uint64_t> all_rows_;                                        // 有效行（不含补齐行）
+    std::unordered_map<std::string, std::vector<uint64_t>> department_rows_; // 科室 → 行位图
+    std::vector<uint32_t> schedule_;                                         // 行 → 门诊时间编号
+    std::vector<OpeningHours> schedules_;                                    // 编号 → 编译后的门诊时间
+    GeoPointArray points_;
+    Dictionary level_dict_;
+    Dictionary type_dict_;
+    Dictionary status_dict_;
+};
+
+#endif // HOSPITAL_FILTER_TABLE_H
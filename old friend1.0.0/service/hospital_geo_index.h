@@ -0,0 +1,244 @@
+#ifndef HOSPITAL_GEO_INDEX_H
+#define HOSPITAL_GEO_INDEX_H
+
+#include "util/geo_util.h"
+#include "util/geo_batch.h"
+#include <string>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * 医院地理索引：按科室划分的经纬度网格索引（每个格子约 cell_deg 度见方）
+ * 支持 k 近邻与半径范围查询，只访问原点附近的格子，避免“全量计算距离 + 全量排序”
+ * 同一格子的医院连续存放，坐标以结构数组保存，格内距离由 GeoBatch 批量计算；
+ * 索引只保存快照行号与坐标，不复制医院数据（一家医院开设多个科室也只在快照中存一份）
+ * 索引构建完成后只读，可被多个线程并发查询；刷新时整体重建后替换
+ */
+class HospitalGeoIndex {
+public:
+    /**
+     * 查询命中结果（row 为目录快照中的行号，由调用方换成医院）
+     */
+    struct Hit {
+        uint32_t row = 0;
+        double distance = 0.0; // 与查询点的距离（km，未取整）
+    };
+
+    explicit HospitalGeoIndex(double cell_deg = 0.02) : cell_deg_(cell_deg) {}
+
+    /**
+     * 写入某科室的医院（构建阶段调用，重复调用会覆盖该科室）
+     * @param rows   该科室医院在目录快照中的行号
+     * @param points 与 rows 一一对应的坐标
+     */
+    void AddDepartment(const std::string& department, const std::vector<uint32_t>& rows, const GeoPointArray& points) {
+        if (rows.size() != points.Size()) {
+            throw std::invalid_argument("行号与坐标数量不一致");
+        }
+        // 按格子排序，使同一格子的医院在数组中连续
+        std::vector<std::pair<uint64_t, uint32_t>> order(rows.size());
+        for (uint32_t i = 0; i < rows.size(); ++i) {
+            order[i] = {CellKey(Row(points.latitude[i]), Col(points.longitude[i])), i};
+        }
+        std::stable_sort(order.begin(), order.end(),
+            [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) {
+                return a.first < b.first;
+            });
+
+        DeptGrid grid;
+        grid.rows.reserve(rows.size());
+        grid.points.Reserve(rows.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            uint32_t src = order[i].second;
+            double latitude = points.latitude[src];
+            double longitude = points.longitude[src];
+            auto range = grid.cells.emplace(order[i].first, std::make_pair(i, i)).first;
+            range->second.second = i + 1;
+            int row = Row(latitude);
+            int col = Col(longitude);
+            grid.min_row = std::min(grid.min_row, row);
+            grid.max_row = std::max(grid.max_row, row);
+            grid.min_col = std::min(grid.min_col, col);
+            grid.max_col = std::max(grid.max_col, col);
+            grid.max_abs_lat = std::max(grid.max_abs_lat, std::fabs(latitude));
+            // 直接搬运已换算好的球面坐标，不重复计算三角函数
+            grid.points.latitude.push_back(latitude);
+            grid.points.longitude.push_back(longitude);
+            grid.points.x.push_back(points.x[src]);
+            grid.points.y.push_back(points.y[src]);
+            grid.points.z.push_back(points.z[src]);
+            grid.rows.push_back(rows[src]);
+        }
+        grids_[department] = std::move(grid);
+    }
+
+    /**
+     * 查询距离最近的 k 家医院（按距离升序）
+     */
+    std::vector<Hit> QueryNearest(const std::string& department,
+                                  double latitude, double longitude, size_t k) const {
+        std::vector<Hit> result;
+        const DeptGrid* grid = FindGrid(department);
+        if (grid == nullptr || grid->rows.empty() || k == 0) {
+            return result;
+        }
+
+        std::vector<double> distances; // 格内批量距离缓冲
+        auto farther = [](const Hit& a, const Hit& b) { return a.distance < b.distance; };
+        std::priority_queue<Hit, std::vector<Hit>, decltype(farther)> heap(farther); // 大顶堆，堆顶为当前第k近
+
+        int r0 = Row(latitude);
+        int c0 = Col(longitude);
+        // 跳过原点与网格范围之间的空圈
+        int first_ring = std::max({grid->min_row - r0, r0 - grid->max_row,
+                                   grid->min_col - c0, c0 - grid->max_col, 0});
+        int last_ring = std::max({r0 - grid->min_row, grid->max_row - r0,
+                                  c0 - grid->min_col, grid->max_col - c0});
+        // 每度对应公里数的下界（取参与比较的最高纬度，经度方向最短）
+        double km_per_deg = std::min(GeoUtil::kKmPerDegreeLat,
+            GeoUtil::KmPerDegreeLon(std::max(grid->max_abs_lat, std::fabs(latitude))));
+
+        for (int ring = first_ring; ring <= last_ring; ++ring) {
+            if (heap.size() == k && ring > 0) {
+                // 第 ring 圈中的点与原点至少相差 (ring-1) 个格子
+                double lower_bound = (ring - 1) * cell_deg_ * km_per_deg;
+                if (heap.top().distance <= lower_bound) {
+                    break;
+                }
+            }
+            VisitRing(*grid, r0, c0, ring, [&](uint32_t begin, uint32_t end) {
+                distances.resize(end - begin);
+                GeoBatch::DistancesKm(latitude, longitude, grid->points, begin, end, distances.data());
+                for (uint32_t idx = begin; idx < end; ++idx) {
+                    double dist = distances[idx - begin];
+                    if (heap.size() < k) {
+                        heap.push(Hit{grid->rows[idx], dist});
+                    } else if (dist < heap.top().distance) {
+                        heap.pop();
+                        heap.push(Hit{grid->rows[idx], dist});
+                    }
+                }
+            });
+        }
+
+        result.resize(heap.size());
+        for (size_t i = result.size(); i > 0; --i) {
+            result[i - 1] = heap.top();
+            heap.pop();
+        }
+        return result;
+    }
+
+    /**
+     * 查询半径 radius_km 范围内的医院（按距离升序）
+     */
+    std::vector<Hit> QueryWithinRadius(const std::string& department,
+                                       double latitude, double longitude, double radius_km) const {
+        std::vector<Hit> result;
+        const DeptGrid* grid = FindGrid(department);
+        if (grid == nullptr || grid->rows.empty() || radius_km <= 0) {
+            return result;
+        }
+
+        double dlat = radius_km / GeoUtil::kKmPerDegreeLat;
+        double edge_lat = std::min(89.0, std::fabs(latitude) + dlat);
+        double dlon = radius_km / GeoUtil::KmPerDegreeLon(edge_lat);
+
+        int row_begin = std::max(Row(latitude - dlat), grid->min_row);
+        int row_end = std::min(Row(latitude + dlat), grid->max_row);
+        int col_begin = std::max(Col(longitude - dlon), grid->min_col);
+        int col_end = std::min(Col(longitude + dlon), grid->max_col);
+
+        std::vector<double> distances; // 格内批量距离缓冲
+        for (int row = row_begin; row <= row_end; ++row) {
+            for (int col = col_begin; col <= col_end; ++col) {
+                VisitCell(*grid, row, col, [&](uint32_t begin, uint32_t end) {
+                    distances.resize(end - begin);
+                    GeoBatch::DistancesKm(latitude, longitude, grid->points, begin, end, distances.data());
+                    for (uint32_t idx = begin; idx < end; ++idx) {
+                        if (distances[idx - begin] <= radius_km) {
+                            result.push_back(Hit{grid->rows[idx], distances[idx - begin]});
+                        }
+                    }
+                });
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [](const Hit& a, const Hit& b) {
+            return a.distance < b.distance;
+        });
+        return result;
+    }
+
+    size_t DepartmentCount() const { return grids_.size(); }
+
+private:
+    struct DeptGrid {
+        std::vector<uint32_t> rows;                                   // 该科室医院的快照行号（按格子排序）
+        GeoPointArray points;                                         // 与 rows 一一对应的坐标（结构数组）
+        std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> cells; // 格子 → 医院下标区间 [begin, end)
+        int min_row = INT32_MAX;
+        int max_row = INT32_MIN;
+        int min_col = INT32_MAX;
+        int max_col = INT32_MIN;
+        double max_abs_lat = 0.0;
+    };
+
+    const DeptGrid* FindGrid(const std::string& department) const {
+        auto it = grids_.find(department);
+        return it == grids_.end() ? nullptr : &it->second;
+    }
+
+    int Row(double latitude) const { return static_cast<int>(std::floor(latitude / cell_deg_)); }
+    int Col(double longitude) const { return static_cast<int>(std::floor(longitude / cell_deg_)); }
+
+    static uint64_t CellKey(int row, int col) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32) | static_cast<uint32_t>(col);
+    }
+
+    template <typename Visitor>
+    static void VisitCell(const DeptGrid& grid, int row, int col, Visitor&& visit) {
+        auto it = grid.cells.find(CellKey(row, col));
+        if (it == grid.cells.end()) {
+            return;
+        }
+        visit(it->second.first, it->second.second);
+    }
+
+    /**
+     * 遍历以 (r0, c0) 为中心、切比雪夫距离为 ring 的一圈格子（裁剪到网格范围内）
+     */
+    template <typename Visitor>
+    static void VisitRing(const DeptGrid& grid, int r0, int c0, int ring, Visitor&& visit) {
+        if (ring == 0) {
+            VisitCell(grid, r0, c0, visit);
+            return;
+        }
+        int col_begin = std::max(c0 - ring, grid.min_col);
+        int col_end = std::min(c0 + ring, grid.max_col);
+        for (int row : {r0 - ring, r0 + ring}) {
+            if (row < grid.min_row || row > grid.max_row) continue;
+            for (int col = col_begin; col <= col_end; ++col) {
+                VisitCell(grid, row, col, visit);
+            }
+        }
+        int row_begin = std::max(r0 - ring + 1, grid.min_row);
+        int row_end = std::min(r0 + ring - 1, grid.max_row);
+        for (int col : {c0 - ring, c0 + ring}) {
+            if (col < grid.min_col || col > grid.max_col) continue;
+            for (int row = row_begin; row <= row_end; ++row) {
+                VisitCell(grid, row, col, visit);
+            }
+        }
+    }
+
+    double cell_deg_;                                      // 网格边长（度，默认0.02°≈2km）
+    std::unordered_map<std::string, DeptGrid> grids_;      // 科室 → 网格
+};
+
+#endif // HOSPITAL_GEO_INDEX_H
@@ -0,0 +1,217 @@
+#ifndef HOSPITAL_SEARCH_H
+#define HOSPITAL_SEARCH_H
+
+#include "util/geo_util.h"
+#include "util/geo_batch.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <utility>
+
+/**
+ * 医院分页查询参数
+ */
+struct HospitalSearchOptions {
+    size_t limit = 20;              // 每页条数
+    std::string cursor;             // 上一页返回的游标（为空表示第一页）
+    double max_distance_km = 0;     // 最大距离（<=0 表示不限）
+    // 只返回有剩余号源的医院。未指定 reserve_date 时按目录中的 available_quota 判断，只是近似：
+    // 该值是医院级汇总（不分科室、日期），且随目录刷新，最多滞后一个刷新周期（默认 5 分钟）
+    bool available_only = false;
+    std::string reserve_date;       // 就诊日期（yyyy-mm-dd）：与 available_only 同时设置时按该日期的实时号源过滤
+};
+
+/**
+ * 号源判断：目录快照中第 row 行的医院在本次查询的科室/日期下是否还有号
+ * （用于 available_only，由服务层按配额引擎提供）
+ */
+using HospitalQuotaPredicate = std::function<bool(uint32_t row)>;
+
+/**
+ * 查询命中（row 为目录快照中的行号，由调用方换成医院）
+ */
+struct HospitalSearchHit {
+    uint32_t row = 0;
+    double distance = 0.0;          // km，未取整
+};
+
+/**
+ * 一段快照行号（科室倒排表），只引用不持有，在所属目录快照存活期间有效
+ */
+struct HospitalRows {
+    const uint32_t* data = nullptr;
+    size_t count = 0;
+
+    HospitalRows() = default;
+    HospitalRows(const uint32_t* rows, size_t n) : data(rows), count(n) {}
+    HospitalRows(const std::vector<uint32_t>& rows) : data(rows.data()), count(rows.size()) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    uint32_t operator[](size_t i) const { return data[i]; }
+    const uint32_t* begin() const { return data; }
+    const uint32_t* end() const { return data + count; }
+};
+
+/**
+ * 按距离分页查询医院
+ * - 距离由 GeoBatch 按科室坐标数组批量计算
+ * - 候选逐个交给 PageCollector：只保留 (距离, 行号) 的紧凑对，用大小为 limit 的堆选出本页，最后只对本页排序
+ * - 医院ID只在距离相等时按行号取一次，不需要把医院对象读出来
+ * - 游标为上一页最后一条的 (距离, 医院ID)，下一页从严格大于它的位置开始，目录刷新后仍然有效
+ */
+class HospitalSearcher {
+private:
+    struct Cursor {
+        double distance = 0;
+        std::string id;
+    };
+
+    // 游标格式："<距离(十六进制浮点，精确往返)>|<医院ID>"
+    static std::string MakeCursor(double distance, std::string_view id) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%a|", distance);
+        std::string cursor(buf);
+        cursor.append(id);
+        return cursor;
+    }
+
+    static bool ParseCursor(const std::string& text, Cursor& cursor) {
+        size_t sep = text.find('|');
+        if (sep == std::string::npos) {
+            return false;
+        }
+        std::string number = text.substr(0, sep);
+        char* end = nullptr;
+        cursor.distance = std::strtod(number.c_str(), &end);
+        if (end == number.c_str() || *end != '\0') {
+            return false;
+        }
+        cursor.id = text.substr(sep + 1);
+        return true;
+    }
+
+public:
+    /**
+     * 分页收集器：过滤距离上限与游标，再判断号源，统计总数，堆中保留距离最近的 limit 个候选
+     * 号源判断（可能查询配额引擎）放在距离与游标之后，翻页时游标之前的医院不再逐个判断
+     * @tparam IdAt 快照行号 → 医院ID（std::string_view）
+     * @param has_quota 为空表示不按号源过滤
+     */
+    template <typename IdAt>
+    class PageCollector {
+    public:
+        PageCollector(const HospitalSearchOptions& options, IdAt id_at, HospitalQuotaPredicate has_quota = nullptr)
+            : options_(options), id_at_(id_at), has_quota_(std::move(has_quota)) {
+            has_cursor_ = !options.cursor.empty();
+            if (has_cursor_ && !ParseCursor(options.cursor, after_)) {
+                throw std::invalid_argument("分页游标无效");
+            }
+            heap_.reserve(options.limit);
+        }
+
+        void Offer(double distance, uint32_t row) {
+            if (options_.max_distance_km > 0 && distance > options_.max_distance_km) {
+                return;
+            }
+            // 先用距离做廉价比较，只有相等时才取医院ID
+            if (has_cursor_ && distance <= after_.distance &&
+                (distance < after_.distance || id_at_(row) <= std::string_view(after_.id))) {
+                return;
+            }
+            if (has_quota_ && !has_quota_(row)) {
+                return;
+            }
+            ++total_;
+            Candidate candidate{distance, row};
+            if (heap_.size() < options_.limit) {
+                heap_.push_back(candidate);
+                std::push_heap(heap_.begin(), heap_.end(), Less());
+            } else if (!heap_.empty() && Less()(candidate, heap_.front())) {
+                std::pop_heap(heap_.begin(), heap_.end(), Less());
+                heap_.back() = candidate;
+                std::push_heap(heap_.begin(), heap_.end(), Less());
+            }
+        }
+
+        /**
+         * @return 满足距离上限与号源条件、位于游标之后的候选总数
+         */
+        size_t Finish(std::vector<HospitalSearchHit>& hits, std::string& next_cursor) {
+            std::sort_heap(heap_.begin(), heap_.end(), Less());
+            hits.clear();
+            next_cursor.clear();
+            hits.reserve(heap_.size());
+            for (const auto& candidate : heap_) {
+                hits.push_back(HospitalSearchHit{candidate.row, candidate.distance});
+            }
+            if (!hits.empty() && hits.size() < total_) {
+                next_cursor = MakeCursor(hits.back().distance, id_at_(hits.back().row));
+            }
+            return total_;
+        }
+
+    private:
+        struct Candidate {
+            double distance;
+            uint32_t row;
+        };
+
+        struct LessImpl {
+            IdAt id_at;
+            bool operator()(const Candidate& a, const Candidate& b) const {
+                if (a.distance != b.distance) return a.distance < b.distance;
+                return id_at(a.row) < id_at(b.row);
+            }
+        };
+
+        LessImpl Less() const { return LessImpl{id_at_}; }
+
+        const HospitalSearchOptions& options_;
+        IdAt id_at_;
+        HospitalQuotaPredicate has_quota_;
+        bool has_cursor_ = false;
+        Cursor after_;
+        std::vector<Candidate> heap_;   // 大顶堆：堆顶为当前保留的最远候选
+        size_t total_ = 0;
+    };
+
+    /**
+     * @param candidates 科室内全部医院的快照行号
+     * @param points 与 candidates 一一对应的坐标数组
+     * @param id_at 快照行号 → 医院ID（std::string_view）
+     * @param hits 输出本页命中（按距离升序）
+     * @param next_cursor 输出下一页游标（没有下一页时为空）
+     * @param has_quota available_only 的判断（设置 available_only 时必须提供）
+     * @return 满足过滤条件、位于游标之后的医院总数
+     */
+    template <typename IdAt>
+    static size_t Search(HospitalRows candidates, const GeoPointArray& points,
+                         double latitude, double longitude, const HospitalSearchOptions& options, IdAt id_at,
+                         std::vector<HospitalSearchHit>& hits, std::string& next_cursor,
+                         const HospitalQuotaPredicate& has_quota = nullptr) {
+        if (options.available_only && !has_quota) {
+            throw std::invalid_argument("只看有号源时需要提供号源判断");
+        }
+        HospitalQuotaPredicate quota;
+        if (options.available_only) {
+            quota = has_quota;
+        }
+        PageCollector<IdAt> collector(options, id_at, std::move(quota));
+        std::vector<double> distances;
+        GeoBatch::DistancesKm(latitude, longitude, points, distances);
+        for (uint32_t i = 0; i < candidates.size(); ++i) {
+            collector.Offer(distances[i], candidates[i]);
+        }
+        return collector.Finish(hits, next_cursor);
+    }
+
+};
+
+#endif // HOSPITAL_SEARCH_H
@@ -0,0 +1,164 @@
+#ifndef ORDER_EXPIRY_SCHEDULER_H
+#define ORDER_EXPIRY_SCHEDULER_H
+
+#include "util/timing_wheel.h"
+#include "util/time_util.h"
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 需要到期处理的订单类型
+ */
+enum class OrderExpiryKind {
+    TAXI_ORDER = 0,     // 打车订单（超时未派单）
+    PAYMENT_ORDER = 1,  // 支付订单（超时未支付）
+    RESERVE_ORDER = 2   // 挂号预约（就诊日已过未就诊）
+};
+
+/**
+ * 订单到期调度器：进程内分层时间轮，订单创建时登记到期时间，到期后按类型批量回调
+ * - 登记/取消 O(1)，可容纳百万级待到期订单
+ * - 回调在调度线程中、锁外执行，一次传入同一秒内到期的全部订单，便于 DAO 批量条件更新
+ * - 进程重启后由各服务调用 Restore 从数据库恢复未到期订单
+ */
+class OrderExpiryScheduler {
+public:
+    using ExpireHandler = std::function<void(const std::vector<std::string>& order_ids)>;
+
+    static OrderExpiryScheduler& GetInstance() {
+        static OrderExpiryScheduler instance;
+        return instance;
+    }
+
+    OrderExpiryScheduler(const OrderExpiryScheduler&) = delete;
+    OrderExpiryScheduler& operator=(const OrderExpiryScheduler&) = delete;
+
+    /**
+     * 设置某类订单的到期回调（批量）
+     */
+    void SetHandler(OrderExpiryKind kind, ExpireHandler handler) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handlers_[static_cast<int>(kind)] = std::move(handler);
+    }
+
+    /**
+     * 登记订单到期时间（重复登记会覆盖）
+     */
+    void Schedule(OrderExpiryKind kind, const std::string& order_id, int64_t expire_at) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wheel_.Schedule(MakeKey(kind, order_id), expire_at, static_cast<int>(kind));
+    }
+
+    /**
+     * 取消订单到期（订单已支付/已派单/已取消时调用）
+     */
+    void Cancel(OrderExpiryKind kind, const std::string& order_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wheel_.Cancel(MakeKey(kind, order_id));
+    }
+
+    /**
+     * 启动时批量恢复未到期订单（order_id, expire_at），已过期的在下一次推进时立即触发
+     */
+    void Restore(OrderExpiryKind kind, const std::vector<std::pair<std::string, int64_t>>& pending) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& item : pending) {
+            wheel_.Schedule(MakeKey(kind, item.first), item.second, static_cast<int>(kind));
+        }
+        SPDLOG_INFO("恢复订单到期定时器，kind={}, count={}", static_cast<int>(kind), pending.size());
+    }
+
+    /**
+     * 推进时间轮到 now 并触发到期回调
+     * @return 本次到期的订单数
+     */
+    size_t Tick(int64_t now) {
+        std::vector<std::string> batches[kKindCount];
+        ExpireHandler handlers[kKindCount];
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& item : wheel_.Advance(now)) {
+                // key 格式：<kind>:<order_id>
+                batches[item.kind].push_back(item.key.substr(item.key.find(':') + 1));
+            }
+            for (int i = 0; i < kKindCount; ++i) handlers[i] = handlers_[i];
+        }
+
+        size_t total = 0;
+        for (int i = 0; i < kKindCount; ++i) {
+            if (batches[i].empty()) continue;
+            total += batches[i].size();
+            if (!handlers[i]) {
+                SPDLOG_WARN("订单到期未设置回调，kind={}, count={}", i, batches[i].size());
+                continue;
+            }
+            try {
+                handlers[i](batches[i]);
+            } catch (const std::exception& e) {
+                SPDLOG_ERROR("订单到期处理异常，kind={}, count={}, error={}", i, batches[i].size(), e.what());
+            }
+        }
+        return total;
+    }
+
+    /**
+     * 启动后台线程（每秒推进一次；各服务的 InitOrderExpiry 均会调用，重复调用无副作用）
+     */
+    void Start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        worker_ = std::thread([this] {
+            std::unique_lock<std::mutex> lock(stop_mutex_);
+            while (running_) {
+                lock.unlock();
+                Tick(TimeUtil::GetCurrentTimestamp());
+                lock.lock();
+                stop_cv_.wait_for(lock, std::chrono::seconds(1), [this] { return !running_; });
+            }
+        });
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            if (!running_.exchange(false)) return;
+        }
+        stop_cv_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    size_t PendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return wheel_.Size();
+    }
+
+private:
+    static constexpr int kKindCount = 3;
+
+    OrderExpiryScheduler() : wheel_(TimeUtil::GetCurrentTimestamp()) {}
+    ~OrderExpiryScheduler() { Stop(); }
+
+    static std::string MakeKey(OrderExpiryKind kind, const std::string& order_id) {
+        return std::to_string(static_cast<int>(kind)) + ":" + order_id;
+    }
+
+    mutable std::mutex mutex_;              // 保护时间轮与回调表
+    TimingWheel wheel_;                     // 分层时间轮
+    ExpireHandler handlers_[kKindCount];    // 各类订单的到期回调
+
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    std::atomic<bool> running_{false};
+    std::thread worker_;
+};
+
+#endif // ORDER_EXPIRY_SCHEDULER_H
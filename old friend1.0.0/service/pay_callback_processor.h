@@ -0,0 +1,461 @@
+#ifndef PAY_CALLBACK_PROCESSOR_H
+#define PAY_CALLBACK_PROCESSOR_H
+
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_set>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 支付回调通知（解析后的微信支付回调）
+ */
+struct PayCallbackNotice {
+    std::string out_trade_no;       // 商户订单号
+    std::string trade_state;        // 支付状态（SUCCESS 为成功）
+    std::string transaction_id;     // 微信支付单号
+    int64_t pay_time = 0;           // 支付完成时间
+    std::string callback_data;      // 回调原始数据（用于问题排查）
+};
+
+/**
+ * 回调落库结果（由 DAO 的条件更新事务返回）
+ */
+struct PayCallbackApplyResult {
+    enum class Code {
+        APPLIED = 0,            // 本次更新了订单（成功时同时标记缴费项目已缴清）
+        ALREADY_PROCESSED = 1,  // 订单已处于本回调的结果状态（SUCCESS 时订单已是“已支付”），条件更新未命中
+        NOT_FOUND = 2,          // 订单不存在
+        FAILED = 3,             // 事务失败（可重试）
+        CONFLICT = 4            // 订单已进入与回调矛盾的终态（如已取消/支付失败后收到 SUCCESS），需人工对账或退款
+    };
+    Code code = Code::FAILED;
+    bool reconciled = false;    // NOT_FOUND/CONFLICT 时已在同一事务内写入对账表（仅批量落库使用）
+    std::string order_id;       // APPLIED 时返回，供提交后的处理使用
+    std::string item_id;
+    std::string user_id;        // 订单所属用户（用于使其缴费项目缓存失效）
+};
+
+/**
+ * 回调处理结论
+ */
+enum class PayCallbackOutcome {
+    APPLIED = 0,    // 本次落库
+    DUPLICATE = 1,  // 重复回调（内存去重命中或订单已处理）
+    NOT_FOUND = 2,  // 订单不存在（同步路径不确认，由微信重试；队列路径已写入对账表）
+    RETRYING = 3,   // 落库失败，已进入重试队列
+    CONFLICT = 4    // 订单状态与回调矛盾（同步路径不确认，由微信重试；队列路径已写入对账表）
+};
+
+/**
+ * 回调处理参数
+ */
+struct PayCallbackOptions {
+    size_t recent_capacity = 65536;     // 内存去重集合容量（超出后按到达顺序淘汰最早的记录）
+    size_t max_outbox = 10000;          // 重试队列上限（满时只依赖微信重试）
+    int retry_initial_ms = 500;         // 首次重试延迟
+    int retry_max_ms = 60000;           // 重试延迟上限（指数退避）
+};
+
+/**
+ * 回调处理统计
+ */
+struct PayCallbackStats {
+    uint64_t applied = 0;       // 落库成功
+    uint64_t duplicates = 0;    // 内存去重命中（未访问数据库）
+    uint64_t stale = 0;         // 条件更新未命中（订单已处理）
+    uint64_t not_found = 0;
+    uint64_t failures = 0;      // 落库失败次数（含重试）
+    uint64_t retried = 0;       // 经重试队列落库成功
+    uint64_t conflicts = 0;     // 订单状态与回调矛盾（需对账）
+    uint64_t reconciled = 0;    // 批量落库时写入对账表的回调（订单不存在或状态矛盾）
+    size_t outbox = 0;          // 当前重试队列长度
+};
+
+/**
+ * 微信支付回调处理：
+ * - 最近处理完成的 (商户订单号, 支付状态) 保存在分片去重集合中，重复投递直接确认，不读数据库；
+ *   同一订单先后收到的失败通知与 SUCCESS 是不同的键，失败通知不会让之后的 SUCCESS 被当作重复
+ * - 订单状态与缴费项目状态在 DAO 的一个条件更新事务中完成（仅“未支付”订单命中；SUCCESS 另可命中
+ *   已超时过期的订单，用户已付款就必须入账），并发的重复回调只有一个能生效
+ * - 只有订单已处于回调结果状态时才按重复确认；SUCCESS 遇到已取消/支付失败的订单记为冲突，不确认
+ * - 事务失败时回调进入重试队列（outbox），后台线程按指数退避重放；同时向微信返回失败，
+ *   两条重放路径由条件更新保证只生效一次
+ * - ProcessBatch 供持久化队列的消费线程使用：一批回调在一个事务中落库，失败时由队列整批重试；
+ *   同一批内同一订单同时有 SUCCESS 与其他状态的通知时只保留 SUCCESS（用户已付款是终态）
+ * - 队列中的回调已向微信确认、微信不再重发：订单不存在或状态矛盾的回调必须在同一事务内写入对账表，
+ *   否则整批按失败处理、留在队列中重试，不会随消费位置前进而丢失
+ * - 提交后的处理（取消到期定时器等）由 AppliedHook 在事务成功后执行
+ */
+class PayCallbackProcessor {
+public:
+    // 一个事务：UPDATE 订单 WHERE out_trade_no = ? AND status = 未支付（SUCCESS 时 status IN (未支付, 已过期)）；
+    // 成功支付时同一事务内标记缴费项目已缴清。未命中时按订单当前状态返回 ALREADY_PROCESSED 或 CONFLICT
+    using ApplyFn = std::function<PayCallbackApplyResult(const PayCallbackNotice& notice, int64_t now)>;
+    using AppliedHook = std::function<void(const PayCallbackNotice& notice, const PayCallbackApplyResult& result)>;
+    // 一个事务处理一批回调（逐条条件更新），results 与 notices 一一对应；事务失败返回 false
+    // NOT_FOUND/CONFLICT 的回调须在同一事务内写入对账表并置 reconciled
+    using ApplyBatchFn = std::function<bool(const std::vector<PayCallbackNotice>& notices, int64_t now,
+                                            std::vector<PayCallbackApplyResult>& results)>;
+    using ClockFn = std::function<int64_t()>;
+
+    static PayCallbackProcessor& GetInstance() {
+        static PayCallbackProcessor instance;
+        return instance;
+    }
+
+    PayCallbackProcessor(const PayCallbackProcessor&) = delete;
+    PayCallbackProcessor& operator=(const PayCallbackProcessor&) = delete;
+
+    /**
+     * 设置回调并启动重试线程
+     */
+    void Start(ApplyFn apply_fn, AppliedHook applied_hook, ClockFn now_fn,
+               PayCallbackOptions options = PayCallbackOptions()) {
+        std::lock_guard<std::mutex> lock(outbox_mutex_);
+        if (running_) {
+            return;
+        }
+        apply_fn_ = std::move(apply_fn);
+        applied_hook_ = std::move(applied_hook);
+        now_fn_ = std::move(now_fn);
+        options_ = options;
+        size_t per_shard = std::max<size_t>(1, options_.recent_capacity / kShardCount);
+        for (auto& shard : shards_) {
+            shard.capacity = per_shard;
+        }
+        running_ = true;
+        worker_ = std::thread([this] { RetryLoop(); });
+    }
+
+    /**
+     * 停止重试线程（队列中未落库的回调由微信重试或重启后重新投递）
+     */
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(outbox_mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        outbox_cv_.notify_all();
+        worker_.join();
+    }
+
+    /**
+     * 设置批量落库回调（ProcessBatch 使用，未设置时逐条落库）
+     */
+    void SetBatchApply(ApplyBatchFn apply_batch_fn) {
+        std::lock_guard<std::mutex> lock(outbox_mutex_);
+        apply_batch_fn_ = std::move(apply_batch_fn);
+    }
+
+    /**
+     * 处理一批回调（供持久化队列的消费线程调用）：去重后在一个事务中落库
+     * 事务失败时不进入重试队列，由调用方整批重试
+     * @return false=落库失败
+     */
+    bool ProcessBatch(const std::vector<PayCallbackNotice>& notices) {
+        std::unordered_set<std::string> paid;  // 本批中带 SUCCESS 通知的订单
+        for (const auto& notice : notices) {
+            if (notice.trade_state == kTradeStateSuccess) {
+                paid.insert(notice.out_trade_no);
+            }
+        }
+        std::vector<PayCallbackNotice> fresh;
+        std::unordered_set<std::string> seen;
+        for (const auto& notice : notices) {
+            bool superseded = notice.trade_state != kTradeStateSuccess && paid.count(notice.out_trade_no) > 0;
+            if (superseded || IsRecent(notice) || !seen.insert(DedupeKey(notice)).second) {
+                duplicates_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            fresh.push_back(notice);
+        }
+        if (fresh.empty()) {
+            return true;
+        }
+        std::vector<PayCallbackApplyResult> results;
+        bool ok = false;
+        if (apply_batch_fn_) {
+            try {
+                ok = apply_batch_fn_(fresh, now_fn_(), results) && results.size() == fresh.size();
+            } catch (const std::exception& e) {
+                SPDLOG_ERROR("Pay callback batch apply error (count={}): {}", fresh.size(), e.what());
+            }
+        } else if (apply_fn_) {
+            ok = true;
+            for (const auto& notice : fresh) {
+                results.push_back(TryApply(notice));
+                ok = ok && results.back().code != PayCallbackApplyResult::Code::FAILED;
+            }
+        }
+        for (size_t i = 0; ok && i < fresh.size(); ++i) {
+            if (NeedsReconcile(results[i].code) && !results[i].reconciled) {
+                SPDLOG_ERROR("Pay callback not recorded for reconciliation, retry batch (out_trade_no={}, trade_state={})",
+                    fresh[i].out_trade_no, fresh[i].trade_state);
+                ok = false;
+            }
+        }
+        if (!ok) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        for (size_t i = 0; i < fresh.size(); ++i) {
+            if (NeedsReconcile(results[i].code)) {
+                reconciled_.fetch_add(1, std::memory_order_relaxed);
+                Remember(fresh[i]);  // 已进入对账表，重复投递直接确认
+            }
+            Settle(fresh[i], results[i]);
+        }
+        return true;
+    }
+
+    /**
+     * 处理一条回调（未启动时按落库失败处理）
+     */
+    PayCallbackOutcome Process(const PayCallbackNotice& notice) {
+        if (IsRecent(notice)) {
+            duplicates_.fetch_add(1, std::memory_order_relaxed);
+            return PayCallbackOutcome::DUPLICATE;
+        }
+        if (!apply_fn_) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            return PayCallbackOutcome::RETRYING;
+        }
+        PayCallbackOutcome outcome = Settle(notice, TryApply(notice));
+        if (outcome == PayCallbackOutcome::RETRYING) {
+            Enqueue(notice);
+        }
+        return outcome;
+    }
+
+    /**
+     * 同一订单、同一支付状态的回调是否已确认处理过（仅查内存）
+     */
+    bool IsRecent(const PayCallbackNotice& notice) const {
+        std::string key = DedupeKey(notice);
+        const Shard& shard = ShardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.keys.count(key) > 0;
+    }
+
+    PayCallbackStats GetStats() const {
+        PayCallbackStats stats;
+        stats.applied = applied_.load(std::memory_order_relaxed);
+        stats.duplicates = duplicates_.load(std::memory_order_relaxed);
+        stats.stale = stale_.load(std::memory_order_relaxed);
+        stats.not_found = not_found_.load(std::memory_order_relaxed);
+        stats.failures = failures_.load(std::memory_order_relaxed);
+        stats.retried = retried_.load(std::memory_order_relaxed);
+        stats.conflicts = conflicts_.load(std::memory_order_relaxed);
+        stats.reconciled = reconciled_.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(outbox_mutex_);
+            stats.outbox = outbox_.size();
+        }
+        return stats;
+    }
+
+private:
+    static constexpr size_t kShardCount = 16;
+    static constexpr const char* kTradeStateSuccess = "SUCCESS";
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_set<std::string> keys;
+        std::deque<std::string> order;      // 到达顺序，用于淘汰
+        size_t capacity = 4096;
+    };
+
+    struct OutboxEntry {
+        PayCallbackNotice notice;
+        std::chrono::steady_clock::time_point due;
+        int delay_ms = 0;
+    };
+
+    PayCallbackProcessor() = default;
+    ~PayCallbackProcessor() { Stop(); }
+
+    const Shard& ShardOf(const std::string& key) const {
+        return shards_[std::hash<std::string>()(key) % kShardCount];
+    }
+
+    Shard& ShardOf(const std::string& key) {
+        return shards_[std::hash<std::string>()(key) % kShardCount];
+    }
+
+    static bool NeedsReconcile(PayCallbackApplyResult::Code code) {
+        return code == PayCallbackApplyResult::Code::NOT_FOUND || code == PayCallbackApplyResult::Code::CONFLICT;
+    }
+
+    // 去重键：商户订单号 + 支付状态
+    static std::string DedupeKey(const PayCallbackNotice& notice) {
+        return notice.out_trade_no + '\x1f' + notice.trade_state;
+    }
+
+    void Remember(const PayCallbackNotice& notice) {
+        std::string key = DedupeKey(notice);
+        Shard& shard = ShardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.keys.insert(key).second) {
+            return;
+        }
+        shard.order.push_back(std::move(key));
+        while (shard.order.size() > shard.capacity) {
+            shard.keys.erase(shard.order.front());
+            shard.order.pop_front();
+        }
+    }
+
+    PayCallbackApplyResult TryApply(const PayCallbackNotice& notice) {
+        PayCallbackApplyResult result;
+        try {
+            result = apply_fn_(notice, now_fn_());
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("Pay callback apply error (out_trade_no={}): {}", notice.out_trade_no, e.what());
+            result.code = PayCallbackApplyResult::Code::FAILED;
+        }
+        if (result.code == PayCallbackApplyResult::Code::FAILED) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // 根据落库结果更新去重集合与统计（FAILED 由调用方决定如何重试）
+    PayCallbackOutcome Settle(const PayCallbackNotice& notice, const PayCallbackApplyResult& result) {
+        switch (result.code) {
+            case PayCallbackApplyResult::Code::APPLIED:
+                OnApplied(notice, result);
+                return PayCallbackOutcome::APPLIED;
+            case PayCallbackApplyResult::Code::ALREADY_PROCESSED:
+                stale_.fetch_add(1, std::memory_order_relaxed);
+                Remember(notice);
+                return PayCallbackOutcome::DUPLICATE;
+            case PayCallbackApplyResult::Code::NOT_FOUND:
+                not_found_.fetch_add(1, std::memory_order_relaxed);
+                return PayCallbackOutcome::NOT_FOUND;
+            case PayCallbackApplyResult::Code::CONFLICT:
+                conflicts_.fetch_add(1, std::memory_order_relaxed);
+                SPDLOG_ERROR("Pay callback conflicts with order state, need reconciliation (out_trade_no={}, trade_state={}, transaction_id={})",
+                    notice.out_trade_no, notice.trade_state, notice.transaction_id);
+                return PayCallbackOutcome::CONFLICT;
+            default:
+                return PayCallbackOutcome::RETRYING;
+        }
+    }
+
+    void OnApplied(const PayCallbackNotice& notice, const PayCallbackApplyResult& result) {
+        applied_.fetch_add(1, std::memory_order_relaxed);
+        Remember(notice);
+        if (applied_hook_) {
+            try {
+                applied_hook_(notice, result);
+            } catch (const std::exception& e) {
+                SPDLOG_WARN("Pay callback post-commit hook error (out_trade_no={}): {}", notice.out_trade_no, e.what());
+            }
+        }
+    }
+
+    void Enqueue(const PayCallbackNotice& notice) {
+        {
+            std::lock_guard<std::mutex> lock(outbox_mutex_);
+            std::string key = DedupeKey(notice);
+            if (!running_ || outbox_.count(key) > 0) {
+                return;
+            }
+            if (outbox_.size() >= options_.max_outbox) {
+                SPDLOG_WARN("Pay callback outbox full, rely on wechat retry (out_trade_no={})", notice.out_trade_no);
+                return;
+            }
+            OutboxEntry entry;
+            entry.notice = notice;
+            entry.delay_ms = options_.retry_initial_ms;
+            entry.due = std::chrono::steady_clock::now() + std::chrono::milliseconds(entry.delay_ms);
+            outbox_.emplace(std::move(key), std::move(entry));
+        }
+        outbox_cv_.notify_one();
+    }
+
+    void RetryLoop() {
+        std::unique_lock<std::mutex> lock(outbox_mutex_);
+        while (running_) {
+            auto now = std::chrono::steady_clock::now();
+            auto next_due = now + std::chrono::milliseconds(options_.retry_max_ms);
+            std::vector<PayCallbackNotice> due;
+            for (const auto& item : outbox_) {
+                if (item.second.due <= now) {
+                    due.push_back(item.second.notice);
+                } else {
+                    next_due = std::min(next_due, item.second.due);
+                }
+            }
+            if (due.empty()) {
+                outbox_cv_.wait_until(lock, next_due);
+                continue;
+            }
+            lock.unlock();
+            std::vector<std::pair<std::string, bool>> done; // (去重键, 是否结束重试)
+            for (const auto& notice : due) {
+                if (IsRecent(notice)) {
+                    done.emplace_back(DedupeKey(notice), true); // 微信重放已先一步落库
+                    continue;
+                }
+                PayCallbackApplyResult result = TryApply(notice);
+                if (result.code == PayCallbackApplyResult::Code::APPLIED) {
+                    retried_.fetch_add(1, std::memory_order_relaxed);
+                    OnApplied(notice, result);
+                } else if (result.code != PayCallbackApplyResult::Code::FAILED) {
+                    Settle(notice, result);
+                }
+                done.emplace_back(DedupeKey(notice), result.code != PayCallbackApplyResult::Code::FAILED);
+            }
+            lock.lock();
+            auto retry_now = std::chrono::steady_clock::now();
+            for (const auto& item : done) {
+                auto it = outbox_.find(item.first);
+                if (it == outbox_.end()) continue;
+                if (item.second) {
+                    outbox_.erase(it);
+                    continue;
+                }
+                OutboxEntry& entry = it->second;
+                entry.delay_ms = std::min(entry.delay_ms * 2, options_.retry_max_ms);
+                entry.due = retry_now + std::chrono::milliseconds(entry.delay_ms);
+            }
+        }
+    }
+
+    Shard shards_[kShardCount];
+
+    ApplyFn apply_fn_;
+    ApplyBatchFn apply_batch_fn_;
+    AppliedHook applied_hook_;
+    ClockFn now_fn_;
+    PayCallbackOptions options_;
+
+    mutable std::mutex outbox_mutex_;
+    std::condition_variable outbox_cv_;
+    std::unordered_map<std::string, OutboxEntry> outbox_;  // 去重键 → 待重试回调
+    bool running_ = false;
+    std::thread worker_;
+
+    std::atomic<uint64_t> applied_{0};
+    std::atomic<uint64_t> duplicates_{0};
+    std::atomic<uint64_t> stale_{0};
+    std::atomic<uint64_t> not_found_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<uint64_t> retried_{0};
+    std::atomic<uint64_t> conflicts_{0};
+    std::atomic<uint64_t> reconciled_{0};
+};
+
+#endif // PAY_CALLBACK_PROCESSOR_H
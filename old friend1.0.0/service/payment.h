@@ -8,18 +8,30 @@
 #include "util/http_client.h"
 #include "util/json_util.h"
 #include "util/time_util.h"
+#include "util/id_generator.h"
 #include "util/string_util.h"
 #include "config/config_parser.h"
 #include "core/logger.h"
+#include "service/order_expiry_scheduler.h"
+#include "service/pay_callback_processor.h"
+#include "service/payment_item_cache.h"
+#include "util/durable_queue.h"
 #include <stdexcept>
 #include <fmt/core.h>
-#include <random>
+#include <mutex>
+#include <memory>
+#include <cstdlib>
+#include <algorithm>
+#include <unordered_set>
 
 // 支付相关常量定义
 constexpr int PAYMENT_ORDER_EXPIRE_SECONDS = 300; // 支付订单有效期（5分钟）
+constexpr int PAYMENT_ORDER_EXPIRE_GRACE_SECONDS = 120; // 到期后再等待的时间（容纳临近到期时完成支付、回调延迟到达的订单）
 constexpr const char* SUPPORTED_PAY_TYPE = "wechat"; // 仅支持微信支付（适配老年人习惯）
 constexpr const char* PAYMENT_ITEM_STATUS_UNPAID = "欠费";
 constexpr const char* PAYMENT_ITEM_STATUS_PAID = "已缴清";
+constexpr const char* PAY_CALLBACK_QUEUE_DIR_ENV = "PAY_CALLBACK_QUEUE_DIR"; // 支付回调本地持久化队列目录（环境变量，绝对路径）
+constexpr const char* PAY_CALLBACK_QUEUE_DEFAULT_DIR = "/var/lib/old_friend/pay_callback_queue"; // 未配置时的默认目录
 
 /**
  * 生活缴费服务层：封装水电燃气等缴费业务逻辑，适配老年人使用场景
@@ -45,18 +57,18 @@ public:
             throw std::runtime_error("用户不存在");
         }
 
-        // 查询用户绑定的缴费项目（DAO层）
-        std::vector<PaymentItem> items = PaymentDao::QueryUserPaymentItems(user_id);
+        // 查询用户绑定的缴费项目（与语音缴费共用缓存快照）
+        PaymentItemCache::SnapshotPtr snapshot = LoadUserPaymentItems(user_id);
         std::vector<PaymentItemDTO> result;
 
         // 转换为DTO（脱敏+状态格式化）
-        for (const auto& item : items) {
+        for (const auto& item : snapshot->items) {
             PaymentItemDTO dto;
             dto.item_id = item.item_id;
             dto.item_type = item.item_type; // 水费/电费/网费/话费
             dto.account = DesensitizeAccount(item.account); // 账号脱敏（如：****1234）
-            dto.amount = item.amount; // 待缴金额（保留2位小数）
-            dto.status = (item.amount > 0.001) ? PAYMENT_ITEM_STATUS_UNPAID : PAYMENT_ITEM_STATUS_PAID;
+            dto.amount = item.amount; // 待缴金额（精确到分）
+            dto.status = item.amount.IsPositive() ? PAYMENT_ITEM_STATUS_UNPAID : PAYMENT_ITEM_STATUS_PAID;
             dto.due_date = item.due_date; // 缴费截止日期（yyyy-mm-dd）
             dto.last_pay_time = (item.last_pay_time > 0) ? TimeUtil::TimestampToStr(item.last_pay_time) : "暂无";
             dto.remark = item.remark; // 附加说明（如："2025年10月账单"）
@@ -67,6 +79,63 @@ public:
         return result;
     }
 
+    /**
+     * 读取用户缴费项目快照（缓存未命中时查库一次，待缴项目由同一结果派生）
+     * 语音查询、语音下单、确认缴费与项目列表的展示/选择共用；快照可能落后于其他实例的写入，
+     * 仅用于读路径，创建支付订单（扣款金额）始终重新查库
+     */
+    static PaymentItemCache::SnapshotPtr LoadUserPaymentItems(const std::string& user_id) {
+        uint64_t load_ticket = 0;
+        PaymentItemCache::SnapshotPtr cached = ItemCache().Get(user_id, load_ticket);
+        if (cached) {
+            return cached;
+        }
+        PaymentItemSnapshot snapshot;
+        snapshot.items = PaymentDao::QueryUserPaymentItems(user_id);
+        for (const auto& item : snapshot.items) {
+            if (item.amount.IsPositive() && item.status != PAYMENT_ITEM_STATUS_PAID) {
+                snapshot.unpaid.push_back(item);
+            }
+        }
+        std::stable_sort(snapshot.unpaid.begin(), snapshot.unpaid.end(),
+            [](const PaymentItem& a, const PaymentItem& b) { return a.create_time > b.create_time; });
+        return ItemCache().Put(user_id, std::move(snapshot), load_ticket);
+    }
+
+    /**
+     * 导入账单（新增或更新缴费项目），成功后使涉及用户的缓存失效
+     * @return true=导入成功
+     */
+    static bool ImportPaymentItems(const std::vector<PaymentItem>& items) {
+        if (items.empty()) {
+            return true;
+        }
+        bool ok = PaymentDao::UpsertPaymentItems(items);
+        // 失败时事务可能已部分生效，同样失效
+        std::unordered_set<std::string> user_ids;
+        for (const auto& item : items) {
+            if (user_ids.insert(item.user_id).second) {
+                ItemCache().Invalidate(item.user_id);
+            }
+        }
+        SPDLOG_INFO("Import payment items (count={}, users={}, ok={})", items.size(), user_ids.size(), ok);
+        return ok;
+    }
+
+    /**
+     * 使用户缴费项目缓存失效（账单由其他入口或其他实例写入后调用）
+     */
+    static void InvalidatePaymentItemCache(const std::string& user_id) {
+        ItemCache().Invalidate(user_id);
+    }
+
+    /**
+     * 缴费项目缓存命中统计
+     */
+    static PaymentItemCacheStats GetPaymentItemCacheStats() {
+        return ItemCache().GetStats();
+    }
+
     // ====================== 支付订单相关 ======================
     /**
      * 创建支付订单（对接微信支付API，生成预支付参数）
@@ -88,7 +157,7 @@ public:
             throw std::invalid_argument(fmt::format("仅支持{}支付", SUPPORTED_PAY_TYPE));
         }
 
-        // 2. 校验缴费项目合法性
+        // 2. 校验缴费项目合法性（涉及扣款，始终以数据库为准，不使用缓存快照）
         PaymentItem item = PaymentDao::QueryPaymentItemById(item_id);
         if (item.item_id.empty()) {
             throw std::runtime_error("缴费项目不存在");
@@ -96,7 +165,7 @@ public:
         if (item.user_id != user_id) {
             throw std::runtime_error("无权操作该缴费项目");
         }
-        if (item.amount <= 0.001) {
+        if (!item.amount.IsPositive() || item.status == PAYMENT_ITEM_STATUS_PAID) {
             throw std::runtime_error("该项目暂无待缴费用");
         }
 
@@ -106,6 +175,8 @@ public:
             // 刷新订单有效期（延长5分钟）
             bool refresh_ok = PaymentDao::RefreshOrderExpire(existing_order.order_id, PAYMENT_ORDER_EXPIRE_SECONDS);
             if (refresh_ok) {
+                OrderExpiryScheduler::GetInstance().Schedule(OrderExpiryKind::PAYMENT_ORDER, existing_order.order_id,
+                    TimeUtil::GetCurrentTimestamp() + PAYMENT_ORDER_EXPIRE_SECONDS + PAYMENT_ORDER_EXPIRE_GRACE_SECONDS);
                 SPDLOG_INFO("Reuse unpaid order (order_id={}, user_id={})", existing_order.order_id, user_id);
                 return ConvertOrderToDTO(existing_order);
             }
@@ -117,6 +188,9 @@ public:
         if (!save_ok) {
             throw std::runtime_error("订单创建失败，请重试");
         }
+        ItemCache().Invalidate(user_id);
+        OrderExpiryScheduler::GetInstance().Schedule(OrderExpiryKind::PAYMENT_ORDER, new_order.order_id,
+            new_order.expire_time + PAYMENT_ORDER_EXPIRE_GRACE_SECONDS);
 
         // 5. 调用微信支付API，生成预支付参数（如prepay_id）
         WechatPayParams pay_params = CallWechatPayAPI(new_order);
@@ -153,75 +227,207 @@ public:
         return VoicePaymentService::QueryUnpaidItemsByVoice(user_id);
     }
 
+    /**
+     * 注册支付订单到期处理，从数据库恢复未支付订单的到期定时器并启动调度线程（服务启动时调用一次）
+     * 订单在 expire_time 之后再等待 PAYMENT_ORDER_EXPIRE_GRACE_SECONDS 才置为过期；
+     * 过期后才到达的 SUCCESS 回调仍会入账（见 CallbackProcessor）
+     */
+    static void InitOrderExpiry() {
+        IdGenerator::Init(); // 订单号发号器启动检查：NODE_ID 非法时启动失败，而不是在首次下单时
+        OrderExpiryScheduler& scheduler = OrderExpiryScheduler::GetInstance();
+        scheduler.SetHandler(OrderExpiryKind::PAYMENT_ORDER, [](const std::vector<std::string>& order_ids) {
+            // 批量条件更新：仅将仍为“未支付”的订单置为“已过期”
+            size_t expired = PaymentDao::ExpireUnpaidOrders(order_ids, TimeUtil::GetCurrentTimestamp());
+            SPDLOG_INFO("Payment orders expired (expired={}, total={})", expired, order_ids.size());
+        });
+        std::vector<std::pair<std::string, int64_t>> pending = PaymentDao::QueryUnpaidOrderExpiries();
+        for (auto& item : pending) {
+            item.second += PAYMENT_ORDER_EXPIRE_GRACE_SECONDS;
+        }
+        scheduler.Restore(OrderExpiryKind::PAYMENT_ORDER, pending);
+        scheduler.Start();
+    }
+
     // ====================== 支付回调相关 ======================
     /**
      * 处理微信支付异步回调（更新订单状态+标记缴费项目为已缴清）
+     * - 原始回调写入本地持久化队列后立即确认，由后台线程解析、去重并按批在一个事务中落库
+     * - 队列不可用时同步处理：重复投递由内存去重集合直接确认，订单与缴费项目在一个条件更新事务中落库
      * @param callback_data 微信支付回调的JSON数据
      * @return true=处理成功，false=处理失败（微信会重试）
      */
     static bool HandleWechatPayCallback(const std::string& callback_data) {
-        try {
-            // 1. 解析回调数据（微信支付回调格式）
-            nlohmann::json callback_json = JsonUtil::Parse(callback_data);
-            std::string out_trade_no = callback_json.value("out_trade_no", ""); // 商户订单号
-            std::string trade_state = callback_json.value("trade_state", ""); // 支付状态
-            std::string transaction_id = callback_json.value("transaction_id", ""); // 微信支付单号
-            std::string pay_time_str = callback_json.value("success_time", ""); // 支付完成时间
-
-            // 2. 校验回调参数合法性
-            if (out_trade_no.empty() || trade_state.empty()) {
-                SPDLOG_WARN("Invalid pay callback: missing core params");
-                return false;
-            }
+        DurableQueue* queue = CallbackQueue();
+        if (queue != nullptr && queue->Append(callback_data)) {
+            return true;
+        }
+        SPDLOG_WARN("Pay callback queue unavailable, process synchronously");
+        return ProcessPayCallback(callback_data);
+    }
 
-            // 3. 查询订单（确认订单存在且未支付）
-            PaymentOrder order = PaymentDao::QueryPaymentOrderByNo(out_trade_no);
-            if (order.order_id.empty()) {
-                SPDLOG_WARN("Pay callback: order not found (out_trade_no={})", out_trade_no);
-                return false;
+    /**
+     * 打开支付回调队列并启动消费线程，重放上次停机前未落库的回调（服务启动时调用一次）
+     * 队列目录取环境变量 PAY_CALLBACK_QUEUE_DIR（必须是绝对路径，不随进程工作目录变化），未设置时用默认目录；
+     * 目录非法或无法打开时记录错误并退化为同步处理
+     */
+    static void InitPayCallbackQueue() {
+        CallbackQueue();
+    }
+
+    /**
+     * 支付回调处理统计（去重命中、重试队列长度等）
+     */
+    static PayCallbackStats GetPayCallbackStats() {
+        return CallbackProcessor().GetStats();
+    }
+
+    /**
+     * 支付回调队列统计（积压条数、批次数等，队列不可用时为空）
+     */
+    static DurableQueueStats GetPayCallbackQueueStats() {
+        DurableQueue* queue = CallbackQueue();
+        return queue != nullptr ? queue->GetStats() : DurableQueueStats();
+    }
+    
+
+private:
+    /**
+     * 用户缴费项目缓存
+     */
+    static PaymentItemCache& ItemCache() {
+        static PaymentItemCache cache;
+        return cache;
+    }
+
+    /**
+     * 支付回调处理器（首次使用时设置落库回调并启动重试线程）
+     */
+    static PayCallbackProcessor& CallbackProcessor() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            PayCallbackProcessor::GetInstance().Start(
+                // 一个事务：订单 未支付 → 已支付/支付失败（写入 transaction_id、pay_time、callback_data），
+                // SUCCESS 同样接受 已过期 → 已支付（用户已付款），成功支付时同一事务内将缴费项目置为已缴清并记录 last_pay_time；
+                // 未命中时订单已是回调结果状态返回 ALREADY_PROCESSED，SUCCESS 遇到已取消/支付失败返回 CONFLICT
+                [](const PayCallbackNotice& notice, int64_t now) {
+                    return PaymentDao::ApplyPayCallback(notice, now);
+                },
+                // 事务提交后：订单已离开“未支付”，取消到期定时器；缴费项目状态已变，使该用户缓存失效
+                [](const PayCallbackNotice&, const PayCallbackApplyResult& result) {
+                    OrderExpiryScheduler::GetInstance().Cancel(OrderExpiryKind::PAYMENT_ORDER, result.order_id);
+                    if (!result.user_id.empty()) {
+                        ItemCache().Invalidate(result.user_id);
+                    }
+                },
+                [] { return TimeUtil::GetCurrentTimestamp(); });
+            // 一个事务：逐条执行上述条件更新，返回每条的结果；NOT_FOUND/CONFLICT 的回调在同一事务内
+            // 写入对账表 PAY_CALLBACK_RECONCILE（按 out_trade_no + trade_state 去重，保存 transaction_id 与原始数据）
+            // 并置 reconciled，由对账任务补单或退款
+            PayCallbackProcessor::GetInstance().SetBatchApply(
+                [](const std::vector<PayCallbackNotice>& notices, int64_t now,
+                   std::vector<PayCallbackApplyResult>& results) {
+                    return PaymentDao::ApplyPayCallbacks(notices, now, results);
+                });
+        });
+        return PayCallbackProcessor::GetInstance();
+    }
+
+    /**
+     * 支付回调持久化队列（首次使用时打开并启动消费线程，打开失败返回 nullptr）
+     */
+    static DurableQueue* CallbackQueue() {
+        static std::once_flag once;
+        static std::unique_ptr<DurableQueue> queue;
+        std::call_once(once, [] {
+            try {
+                // 入队即向微信确认、微信不再重发，必须落盘后才确认（组提交合并并发写入的 fdatasync）
+                DurableQueueOptions options;
+                options.sync_before_ack = true;
+                queue.reset(new DurableQueue(PayCallbackQueueDir(), options));
+            } catch (const std::exception& e) {
+                SPDLOG_ERROR("Open pay callback queue failed: {}", e.what());
+                return;
             }
-            if (order.status != PaymentOrder::OrderStatus::UNPAID) {
-                SPDLOG_WARN("Pay callback: order already processed (out_trade_no={}, status={})", 
-                    out_trade_no, OrderStatusToString(order.status));
+            queue->Start([](const std::vector<std::string>& records) {
+                std::vector<PayCallbackNotice> notices;
+                notices.reserve(records.size());
+                for (const auto& record : records) {
+                    PayCallbackNotice notice;
+                    if (ParsePayCallback(record, notice)) {
+                        notices.push_back(std::move(notice));
+                    }
+                }
+                return CallbackProcessor().ProcessBatch(notices);
+            },
+            // 同一订单的回调（如 NOTPAY 后的 SUCCESS 重试）交给同一消费线程，按到达顺序落库
+            [](const std::string& record) {
+                return std::hash<std::string>()(JsonUtil::Parse(record).value("out_trade_no", ""));
+            });
+        });
+        return queue.get();
+    }
+
+    /**
+     * 支付回调队列目录（相对路径会让重启后的进程在另一个目录下找不到未处理的回调，直接拒绝）
+     * @throw std::invalid_argument 配置的不是绝对路径
+     */
+    static std::string PayCallbackQueueDir() {
+        const char* env = std::getenv(PAY_CALLBACK_QUEUE_DIR_ENV);
+        std::string dir = env != nullptr && *env != '\0' ? env : PAY_CALLBACK_QUEUE_DEFAULT_DIR;
+        if (dir[0] != '/') {
+            throw std::invalid_argument(fmt::format("{} must be an absolute path: {}", PAY_CALLBACK_QUEUE_DIR_ENV, dir));
+        }
+        return dir;
+    }
+
+    /**
+     * 同步处理一条支付回调（队列不可用时使用）
+     */
+    static bool ProcessPayCallback(const std::string& callback_data) {
+        PayCallbackNotice notice;
+        if (!ParsePayCallback(callback_data, notice)) {
+            return false;
+        }
+        switch (CallbackProcessor().Process(notice)) {
+            case PayCallbackOutcome::APPLIED:
+                SPDLOG_INFO("Pay callback applied: order={}, trade_state={}, transaction_id={}",
+                    notice.out_trade_no, notice.trade_state, notice.transaction_id);
+                return true;
+            case PayCallbackOutcome::DUPLICATE:
                 return true; // 已处理过，返回成功避免重复回调
-            }
+            case PayCallbackOutcome::NOT_FOUND:
+                SPDLOG_WARN("Pay callback: order not found (out_trade_no={})", notice.out_trade_no);
+                return false;
+            case PayCallbackOutcome::CONFLICT:
+                return false; // 不确认，微信重试期间由对账处理（已记录错误日志）
+            default:
+                SPDLOG_ERROR("Pay callback: update order/item failed, queued for retry (order={})", notice.out_trade_no);
+                return false;
+        }
+    }
 
-            // 4. 处理支付结果
-            if (trade_state == "SUCCESS") {
-                // 支付成功：更新订单状态+标记缴费项目已缴清
-                order.status = PaymentOrder::OrderStatus::PAID;
-                order.transaction_id = transaction_id;
-                order.pay_time = TimeUtil::IsoStrToTimestamp(pay_time_str);
-                order.update_time = TimeUtil::GetCurrentTimestamp();
-
-                // 数据库事务：确保订单更新和缴费项目状态更新原子性
-                bool update_order_ok = PaymentDao::UpdatePaymentOrder(order);
-                bool update_item_ok = PaymentDao::UpdatePaymentItemStatus(order.item_id, PAYMENT_ITEM_STATUS_PAID);
-
-                if (update_order_ok && update_item_ok) {
-                    SPDLOG_INFO("Pay success: order={}, transaction_id={}", out_trade_no, transaction_id);
-                    return true;
-                } else {
-                    SPDLOG_ERROR("Pay callback: update order/item failed (order={})", out_trade_no);
-                    return false;
-                }
-            } else {
-                // 支付失败/关闭/取消：更新订单状态为失败
-                order.status = PaymentOrder::OrderStatus::PAY_FAILED;
-                order.update_time = TimeUtil::GetCurrentTimestamp();
-                PaymentDao::UpdatePaymentOrder(order);
-                SPDLOG_INFO("Pay failed: order={}, trade_state={}", out_trade_no, trade_state);
-                return true; // 非成功状态也返回成功，避免微信重试
-            }
+    /**
+     * 解析微信支付回调（缺少核心参数或格式错误时返回 false）
+     */
+    static bool ParsePayCallback(const std::string& callback_data, PayCallbackNotice& notice) {
+        try {
+            nlohmann::json callback_json = JsonUtil::Parse(callback_data);
+            notice.out_trade_no = callback_json.value("out_trade_no", ""); // 商户订单号
+            notice.trade_state = callback_json.value("trade_state", ""); // 支付状态
+            notice.transaction_id = callback_json.value("transaction_id", ""); // 微信支付单号
+            notice.pay_time = TimeUtil::IsoStrToTimestamp(callback_json.value("success_time", "")); // 支付完成时间
+            notice.callback_data = callback_data;
         } catch (const std::exception& e) {
-            SPDLOG_ERROR("Handle pay callback error: {}", e.what());
+            SPDLOG_ERROR("Parse pay callback error: {}", e.what());
             return false;
         }
+        if (notice.out_trade_no.empty() || notice.trade_state.empty()) {
+            SPDLOG_WARN("Invalid pay callback: missing core params");
+            return false;
+        }
+        return true;
     }
 
-    
-
-private:
     // ====================== 辅助函数 ======================
     /**
      * 账号脱敏（如：12345678 → ****5678）
@@ -253,26 +459,17 @@ private:
     }
 
     /**
-     * 生成唯一订单ID（格式：PAY + 时间戳 + 随机数）
+     * 生成唯一订单ID（格式：PAY + 64 位ID）
      */
     static std::string GenerateOrderId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("PAY{}{}", TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("PAY");
     }
 
     /**
-     * 生成商户订单号（微信支付要求唯一，格式：YYYYMMDD + 时间戳 + 随机数）
+     * 生成商户订单号（微信支付要求唯一且不超过32位，格式：YYYYMMDD + 64 位ID，共 27 位以内）
      */
     static std::string GenerateOutTradeNo() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(100000, 999999);
-        return fmt::format("{}{}{}", 
-            TimeUtil::GetCurrentDateStr("YYYYMMDD"), 
-            TimeUtil::GetCurrentTimestamp(), 
-            dis(gen));
+        return TimeUtil::GetCurrentDateStr("YYYYMMDD") + IdGenerator::GetInstance().NextString();
     }
 
     /**
@@ -302,7 +499,7 @@ private:
             {"time_expire", TimeUtil::TimestampToIsoStr(order.expire_time)},
             {"notify_url", notify_url},
             {"amount", {
-                {"total", static_cast<int>(order.amount * 100)}, // 单位：分
+                {"total", order.amount.Cents()}, // 单位：分（整数，无换算误差）
                 {"currency", "CNY"}
             }},
             {"payer", {
@@ -369,10 +566,10 @@ private:
 */
     
     /**
-     * 金额匹配校验（允许±0.01元误差）
+     * 金额匹配校验（定点数精确比较）
      */
-    static bool IsAmountMatch(double actual, double target) {
-        return std::fabs(actual - target) <= 0.01;
+    static bool IsAmountMatch(Money actual, Money target) {
+        return actual == target;
     }
     
 
@@ -380,12 +577,12 @@ private:
      * 确认最后一个待缴项目（处理"确认缴费"指令）
      */
     static std::string ConfirmLastUnpaidItem(const std::string& user_id) {
-        std::vector<PaymentItem> unpaid_items = PaymentDao::QueryUserAllUnpaidItems(user_id);
-        if (unpaid_items.empty()) {
+        PaymentItemCache::SnapshotPtr snapshot = LoadUserPaymentItems(user_id);
+        if (snapshot->unpaid.empty()) {
             return "您当前暂无待缴费用";
         }
         // 取最后一个待缴项目（按创建时间倒序）
-        PaymentItem last_item = unpaid_items[0];
+        PaymentItem last_item = snapshot->unpaid[0];
         try {
             CreatePaymentOrder(user_id, last_item.item_id, SUPPORTED_PAY_TYPE);
             return fmt::format("已为您发起{}支付，金额{}元，请在微信中完成支付", 
@@ -426,7 +623,7 @@ struct PaymentItemDTO {
     std::string item_id;       // 缴费项目ID
     std::string item_type;     // 缴费类型（水费/电费/燃气费）
     std::string account;       // 脱敏账号（如：****1234）
-    double amount;             // 待缴金额
+    Money amount;              // 待缴金额
     std::string status;        // 状态（欠费/已缴清）
     std::string due_date;      // 缴费截止日期（yyyy-mm-dd）
     std::string last_pay_time; // 上次缴费时间
@@ -440,7 +637,7 @@ struct PaymentOrderDTO {
     std::string order_id;      // 订单ID
     std::string out_trade_no;  // 商户订单号（微信支付用）
     std::string item_type;     // 缴费类型
-    double amount;             // 支付金额
+    Money amount;              // 支付金额
     std::string pay_type;      // 支付方式
     std::string status;        // 订单状态（字符串形式）
     std::string create_time;   // 创建时间（yyyy-mm-dd HH:MM:SS）
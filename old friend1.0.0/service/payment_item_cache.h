@@ -0,0 +1,186 @@
+#ifndef PAYMENT_ITEM_CACHE_H
+#define PAYMENT_ITEM_CACHE_H
+
+#include "model/payment.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <inttypes.h>
+
+/**
+ * 用户缴费项目快照（一次查库的结果，只读）
+ */
+struct PaymentItemSnapshot {
+    std::vector<PaymentItem> items;     // 用户全部缴费项目
+    std::vector<PaymentItem> unpaid;    // 其中的待缴项目（按创建时间倒序）
+};
+
+/**
+ * 缴费项目缓存统计
+ */
+struct PaymentItemCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t invalidations = 0;    // 按用户精确失效次数
+    uint64_t discarded_loads = 0;  // 加载期间发生失效而未写入缓存的结果
+    uint64_t expirations = 0;      // 超过有效期被丢弃的快照
+    uint64_t evictions = 0;
+    size_t users = 0;              // 当前缓存的用户数
+
+    double HitRatio() const {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * 用户缴费项目缓存：按用户缓存缴费项目快照，语音查询、语音下单、确认缴费、项目列表共用一次查库结果
+ * - 快照为只读 shared_ptr，读方拿到后无需持锁
+ * - 由写入方精确失效：支付回调落库、账单导入、创建支付订单后使对应用户的快照失效
+ * - 加载与失效并发时（读旧数据期间发生失效）丢弃加载结果，不会把旧数据写回缓存
+ * - 快照有效期兜底其他实例的写入；按用户分片加锁，每个分片独立 LRU
+ * - 只服务展示与选择等读路径；涉及扣款的路径（创建支付订单）必须重新查库
+ */
+class PaymentItemCache {
+public:
+    using SnapshotPtr = std::shared_ptr<const PaymentItemSnapshot>;
+
+    explicit PaymentItemCache(size_t max_users = 100000, int ttl_seconds = 300, size_t shard_count = 16)
+        : shards_(new Shard[shard_count]), shard_count_(shard_count),
+          max_users_per_shard_(std::max<size_t>(1, max_users / shard_count)),
+          ttl_(std::chrono::seconds(ttl_seconds)) {}
+
+    PaymentItemCache(const PaymentItemCache&) = delete;
+    PaymentItemCache& operator=(const PaymentItemCache&) = delete;
+
+    /**
+     * 读取用户快照
+     * @param load_ticket 未命中时写入加载凭证，查库后连同结果交给 Put
+     * @return 未缓存或已过期时返回空指针
+     */
+    SnapshotPtr Get(const std::string& user_id, uint64_t& load_ticket) {
+        Shard& shard = ShardOf(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.users.find(user_id);
+        if (it != shard.users.end() && std::chrono::steady_clock::now() - it->second.load_time > ttl_) {
+            shard.lru.erase(it->second.lru_pos);
+            shard.users.erase(it);
+            it = shard.users.end();
+            expirations_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (it == shard.users.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            load_ticket = shard.generation;
+            return nullptr;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_pos);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second.snapshot;
+    }
+
+    /**
+     * 写入从数据库加载的快照（自 Get 以来该分片发生过失效时只返回、不缓存）
+     */
+    SnapshotPtr Put(const std::string& user_id, PaymentItemSnapshot snapshot, uint64_t load_ticket) {
+        SnapshotPtr ptr = std::make_shared<const PaymentItemSnapshot>(std::move(snapshot));
+        Shard& shard = ShardOf(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.generation != load_ticket) {
+            discarded_loads_.fetch_add(1, std::memory_order_relaxed);
+            return ptr;
+        }
+        auto now = std::chrono::steady_clock::now();
+        auto it = shard.users.find(user_id);
+        if (it != shard.users.end()) {
+            it->second.snapshot = ptr;
+            it->second.load_time = now;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_pos);
+            return ptr;
+        }
+        shard.lru.push_front(user_id);
+        shard.users.emplace(user_id, Entry{ptr, now, shard.lru.begin()});
+        while (shard.users.size() > max_users_per_shard_) {
+            shard.users.erase(shard.lru.back());
+            shard.lru.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return ptr;
+    }
+
+    /**
+     * 使某用户的快照失效（该用户的缴费项目或订单发生写入后调用）
+     */
+    void Invalidate(const std::string& user_id) {
+        Shard& shard = ShardOf(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ++shard.generation;  // 进行中的加载（可能读到写入前的数据）不再写入缓存
+        invalidations_.fetch_add(1, std::memory_order_relaxed);
+        auto it = shard.users.find(user_id);
+        if (it != shard.users.end()) {
+            shard.lru.erase(it->second.lru_pos);
+            shard.users.erase(it);
+        }
+    }
+
+    void InvalidateAll() {
+        for (size_t i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            ++shards_[i].generation;
+            shards_[i].users.clear();
+            shards_[i].lru.clear();
+        }
+    }
+
+    PaymentItemCacheStats GetStats() const {
+        PaymentItemCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+        stats.discarded_loads = discarded_loads_.load(std::memory_order_relaxed);
+        stats.expirations = expirations_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            stats.users += shards_[i].users.size();
+        }
+        return stats;
+    }
+
+private:
+    struct Entry {
+        SnapshotPtr snapshot;
+        std::chrono::steady_clock::time_point load_time;
+        std::list<std::string>::iterator lru_pos;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> users;  // user_id → 快照
+        std::list<std::string> lru;                    // 最近访问在前
+        uint64_t generation = 0;                       // 失效计数，用于识别加载期间的失效
+    };
+
+    Shard& ShardOf(const std::string& user_id) const {
+        return shards_[std::hash<std::string>{}(user_id) % shard_count_];
+    }
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+    size_t max_users_per_shard_;
+    std::chrono::steady_clock::duration ttl_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> discarded_loads_{0};
+    std::atomic<uint64_t> expirations_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+#endif // PAYMENT_ITEM_CACHE_H
@@ -0,0 +1,239 @@
+#ifndef RESERVE_ADMISSION_GATE_H
+#define RESERVE_ADMISSION_GATE_H
+
+#include "service/reserve_quota_engine.h"
+#include <string>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <unordered_map>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 准入结果
+ */
+enum class AdmissionResult {
+    ADMITTED = 0,   // 获得预约令牌，可进入预约流程
+    SOLD_OUT = 1,   // 剩余号源已全部发出令牌，直接返回“已满”
+    BUSY = 2        // 排队人数超限或等待超时
+};
+
+/**
+ * 准入参数
+ */
+struct ReserveAdmissionOptions {
+    int max_concurrent = 16;       // 每个 (医院, 科室, 日期) 同时进入预约流程的请求数（限制打到数据库的并发）
+    int max_queue = 2000;          // 每个键的最大排队数
+    int wait_timeout_ms = 3000;    // 排队最长等待时间
+};
+
+/**
+ * 准入统计
+ */
+struct ReserveAdmissionStats {
+    uint64_t admitted = 0;
+    uint64_t sold_out = 0;
+    uint64_t busy = 0;
+    size_t gates = 0;       // 当前存在的准入队列数（只含有在途请求的键）
+};
+
+/**
+ * 抢号准入层：放在预约流程最前面，热门医院放号时挡住注定失败的请求
+ * - 按 (医院, 科室, 日期) 发放令牌：尚未占到号源的在途令牌数不超过配额引擎中的剩余号源，
+ *   其余请求直接返回“已满”，不访问DAO
+ * - 拿到令牌的请求按到达顺序排队，同一时刻最多 max_concurrent 个进入预约流程，离开时只唤醒队首
+ * - 令牌随 Ticket 析构归还；预约失败时号源由配额引擎归还，后续请求可继续获得令牌
+ * - 准入队列只在有在途请求时存在：最后一个请求离开后即从表中移除，过期日期的键不会累积
+ */
+class ReserveAdmissionGate {
+private:
+    // 排队者（各自的条件变量，放行时只唤醒队首，避免惊群）
+    struct Waiter {
+        std::condition_variable cv;
+        bool admitted = false;
+    };
+
+    struct KeyGate {
+        std::mutex mutex;
+        std::list<Waiter*> queue;       // 先到先放行
+        uint64_t running = 0;           // 已放行、尚未离开的请求数
+        uint64_t holding = 0;           // 已放行请求中已占到号源的数量
+        uint64_t max_concurrent = 0;
+
+        /**
+         * 有空位时把队首交给下一个排队者（持锁调用）
+         */
+        void AdmitNext() {
+            while (running < max_concurrent && !queue.empty()) {
+                Waiter* waiter = queue.front();
+                queue.pop_front();
+                waiter->admitted = true;
+                ++running;
+                waiter->cv.notify_one();
+            }
+        }
+    };
+
+public:
+    /**
+     * 预约令牌（RAII，离开作用域即归还）
+     */
+    class Ticket {
+    public:
+        Ticket() = default;
+        ~Ticket() { Reset(); }
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+        /**
+         * 已在配额引擎中占到号源（此后该令牌不再计入“待占用”）
+         */
+        void MarkQuotaAcquired() {
+            if (gate_ && !holding_) {
+                std::lock_guard<std::mutex> lock(gate_->mutex);
+                ++gate_->holding;
+                holding_ = true;
+            }
+        }
+
+        void Reset() {
+            if (!gate_) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(gate_->mutex);
+                --gate_->running;
+                if (holding_) --gate_->holding;
+                gate_->AdmitNext();
+            }
+            ReserveAdmissionGate::GetInstance().Leave(key_, gate_);
+            holding_ = false;
+        }
+
+    private:
+        friend class ReserveAdmissionGate;
+        std::shared_ptr<KeyGate> gate_;
+        std::string key_;
+        bool holding_ = false;
+    };
+
+    static ReserveAdmissionGate& GetInstance() {
+        static ReserveAdmissionGate instance;
+        return instance;
+    }
+
+    ReserveAdmissionGate(const ReserveAdmissionGate&) = delete;
+    ReserveAdmissionGate& operator=(const ReserveAdmissionGate&) = delete;
+
+    void SetOptions(const ReserveAdmissionOptions& options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+    }
+
+    /**
+     * 申请预约令牌（可能排队等待，最长 wait_timeout_ms）
+     */
+    AdmissionResult Enter(const std::string& hospital_id, const std::string& department,
+                          const std::string& reserve_date, Ticket& ticket) {
+        ReserveAdmissionOptions options;
+        std::string key = hospital_id + '\x1f' + department + '\x1f' + reserve_date;
+        std::shared_ptr<KeyGate> gate;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            options = options_;
+            auto& slot = gates_[key];
+            if (!slot) slot = std::make_shared<KeyGate>();
+            gate = slot;
+        }
+        AdmissionResult result = Wait(options, gate, hospital_id, department, reserve_date);
+        if (result != AdmissionResult::ADMITTED) {
+            Leave(key, gate);
+            return result;
+        }
+        ticket.Reset();
+        ticket.gate_ = std::move(gate);
+        ticket.key_ = std::move(key);
+        admitted_.fetch_add(1, std::memory_order_relaxed);
+        return AdmissionResult::ADMITTED;
+    }
+
+    ReserveAdmissionStats GetStats() const {
+        ReserveAdmissionStats stats;
+        stats.admitted = admitted_.load(std::memory_order_relaxed);
+        stats.sold_out = sold_out_.load(std::memory_order_relaxed);
+        stats.busy = busy_.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats.gates = gates_.size();
+        }
+        return stats;
+    }
+
+private:
+    ReserveAdmissionGate() = default;
+
+    /**
+     * 在某个键的准入队列上等待放行（成功时 running 已计入本请求）
+     */
+    AdmissionResult Wait(const ReserveAdmissionOptions& options, const std::shared_ptr<KeyGate>& gate,
+                         const std::string& hospital_id, const std::string& department,
+                         const std::string& reserve_date) {
+        // 剩余号源（-1 表示尚未加载，放行，由预约流程加载后判断）
+        int remaining = ReserveQuotaEngine::GetInstance().Remaining(hospital_id, department, reserve_date);
+
+        std::unique_lock<std::mutex> lock(gate->mutex);
+        gate->max_concurrent = static_cast<uint64_t>(options.max_concurrent);
+        uint64_t waiting = gate->queue.size();
+        // 尚未占到号源的在途令牌 = 排队中 + 已放行未占用
+        if (remaining >= 0 && waiting + gate->running - gate->holding >= static_cast<uint64_t>(remaining)) {
+            sold_out_.fetch_add(1, std::memory_order_relaxed);
+            return AdmissionResult::SOLD_OUT;
+        }
+        if (waiting >= static_cast<uint64_t>(options.max_queue)) {
+            busy_.fetch_add(1, std::memory_order_relaxed);
+            return AdmissionResult::BUSY;
+        }
+
+        if (gate->queue.empty() && gate->running < gate->max_concurrent) {
+            ++gate->running;
+            return AdmissionResult::ADMITTED;
+        }
+        // 排队，由离开的请求按先后顺序放行
+        Waiter waiter;
+        auto pos = gate->queue.insert(gate->queue.end(), &waiter);
+        bool admitted = waiter.cv.wait_for(lock, std::chrono::milliseconds(options.wait_timeout_ms),
+            [&waiter] { return waiter.admitted; });
+        if (!admitted) {
+            gate->queue.erase(pos);
+            busy_.fetch_add(1, std::memory_order_relaxed);
+            return AdmissionResult::BUSY;
+        }
+        return AdmissionResult::ADMITTED;
+    }
+
+    /**
+     * 释放对某个键准入队列的引用；没有其他请求持有时从表中移除
+     * 新的引用只在持有 mutex_ 时从表中取得，因此 use_count 为 2（表 + 本引用）时不会有并发的使用者
+     */
+    void Leave(const std::string& key, std::shared_ptr<KeyGate>& gate) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = gates_.find(key);
+        if (it != gates_.end() && it->second == gate && gate.use_count() == 2) {
+            gates_.erase(it);
+        }
+        gate.reset();
+    }
+
+    mutable std::mutex mutex_;
+    ReserveAdmissionOptions options_;
+    std::unordered_map<std::string, std::shared_ptr<KeyGate>> gates_;  // (医院, 科室, 日期) → 准入队列
+
+    std::atomic<uint64_t> admitted_{0};
+    std::atomic<uint64_t> sold_out_{0};
+    std::atomic<uint64_t> busy_{0};
+};
+
+#endif // RESERVE_ADMISSION_GATE_H
@@ -0,0 +1,211 @@
+#ifndef RESERVE_EXPIRY_SWEEPER_H
+#define RESERVE_EXPIRY_SWEEPER_H
+
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 待过期预约订单（扫描结果只取 idx_status_date 覆盖的列，扫描不回表）
+ */
+struct ReserveOrderKey {
+    std::string reserve_date;
+    std::string order_id;
+};
+
+/**
+ * 过期扫描参数
+ */
+struct ReserveSweepOptions {
+    size_t batch_size = 1000;       // 每批扫描/更新的订单数（一个事务）
+    int interval_ms = 600000;       // 两轮扫描的间隔（就诊日次日零点后最迟一个间隔内过期）
+};
+
+/**
+ * 过期扫描统计
+ */
+struct ReserveSweepStats {
+    uint64_t runs = 0;              // 扫描轮数
+    uint64_t batches = 0;           // 已提交事务数
+    uint64_t scanned = 0;           // 扫描到的订单数
+    uint64_t expired = 0;           // 实际置为“已过期”并归还号源的订单数
+    uint64_t failed_batches = 0;    // 失败的批次（下一轮重试）
+    int64_t last_run_time = 0;      // 最近一轮开始时间
+};
+
+/**
+ * 预约过期扫描：把就诊日已过、仍为“待就诊”的订单批量置为“已过期”，并按 (医院, 科室, 日期) 汇总归还号源
+ * - 按 (reserve_date, order_id) 索引顺序做键集分页扫描，每批一个事务
+ * - 事务内只更新仍为“待就诊”且 is_quota_recovered = 0 的行，同时置 is_quota_recovered = 1 并写入号源增量，
+ *   与取消预约互斥；中途崩溃时已提交的批次不会重复归还，未提交的批次下一轮重新扫描
+ * - 失败的批次跳过，下一轮重试
+ */
+class ReserveExpirySweeper {
+public:
+    // 扫描就诊日早于 before_date、位于游标 (after_date, after_order_id) 之后的待就诊订单，按索引顺序返回至多 limit 条
+    using ScanFn = std::function<bool(const std::string& before_date, const std::string& after_date,
+                                      const std::string& after_order_id, size_t limit,
+                                      std::vector<ReserveOrderKey>& out)>;
+    // 一个事务：锁定仍为“待就诊”且未归还号源的订单，置为“已过期”并标记 is_quota_recovered，
+    // 按 (医院, 科室, 日期) 汇总实际更新的订单并归还号源；返回实际过期的订单数，失败返回 -1
+    using ExpireFn = std::function<int64_t(const std::vector<std::string>& order_ids, int64_t now)>;
+    using ClockFn = std::function<std::string()>;   // 当前日期（yyyy-mm-dd）
+
+    static ReserveExpirySweeper& GetInstance() {
+        static ReserveExpirySweeper instance;
+        return instance;
+    }
+
+    ReserveExpirySweeper(const ReserveExpirySweeper&) = delete;
+    ReserveExpirySweeper& operator=(const ReserveExpirySweeper&) = delete;
+
+    /**
+     * 设置回调与参数（启动前调用）
+     */
+    void Configure(ScanFn scan_fn, ExpireFn expire_fn, ClockFn today_fn,
+                   ReserveSweepOptions options = ReserveSweepOptions()) {
+        std::lock_guard<std::mutex> lock(run_mutex_);
+        scan_fn_ = std::move(scan_fn);
+        expire_fn_ = std::move(expire_fn);
+        today_fn_ = std::move(today_fn);
+        options_ = options;
+    }
+
+    /**
+     * 立即执行一轮扫描（后台线程与手动触发共用，同一时刻只有一轮）
+     * @return 本轮过期的订单数
+     */
+    uint64_t RunOnce(int64_t now) {
+        std::lock_guard<std::mutex> lock(run_mutex_);
+        if (!scan_fn_ || !expire_fn_ || !today_fn_) {
+            return 0;
+        }
+        std::string today = today_fn_();
+        last_run_time_.store(now, std::memory_order_relaxed);
+        runs_.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t expired_total = 0;
+        std::string after_date;
+        std::string after_order_id;
+        std::vector<ReserveOrderKey> batch;
+        std::vector<std::string> order_ids;
+        while (!stopping_.load(std::memory_order_relaxed)) {
+            batch.clear();
+            bool ok = false;
+            try {
+                ok = scan_fn_(today, after_date, after_order_id, options_.batch_size, batch);
+            } catch (const std::exception& e) {
+                SPDLOG_ERROR("预约过期扫描失败，error={}", e.what());
+            }
+            if (!ok || batch.empty()) {
+                break;
+            }
+            scanned_.fetch_add(batch.size(), std::memory_order_relaxed);
+            order_ids.clear();
+            for (const auto& order : batch) {
+                order_ids.push_back(order.order_id);
+            }
+
+            int64_t expired = -1;
+            try {
+                expired = expire_fn_(order_ids, now);
+            } catch (const std::exception& e) {
+                SPDLOG_ERROR("预约过期更新异常，count={}, error={}", order_ids.size(), e.what());
+            }
+            if (expired < 0) {
+                failed_batches_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                batches_.fetch_add(1, std::memory_order_relaxed);
+                expired_.fetch_add(static_cast<uint64_t>(expired), std::memory_order_relaxed);
+                expired_total += static_cast<uint64_t>(expired);
+            }
+            // 无论成败都越过本批（失败的批次留到下一轮），保证一轮内不会在同一批上空转
+            after_date = batch.back().reserve_date;
+            after_order_id = batch.back().order_id;
+            if (batch.size() < options_.batch_size) {
+                break;
+            }
+        }
+        if (expired_total > 0) {
+            SPDLOG_INFO("预约过期扫描完成，expired={}", expired_total);
+        }
+        return expired_total;
+    }
+
+    /**
+     * 启动后台线程（启动后立即执行一轮，处理停机期间积压的订单）
+     * @param now_fn 当前时间戳（秒）
+     */
+    void Start(std::function<int64_t()> now_fn) {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        if (started_) {
+            return;
+        }
+        started_ = true;
+        running_ = true;
+        worker_ = std::thread([this, now_fn] {
+            std::unique_lock<std::mutex> lock(stop_mutex_);
+            while (running_) {
+                lock.unlock();
+                RunOnce(now_fn());
+                lock.lock();
+                stop_cv_.wait_for(lock, std::chrono::milliseconds(options_.interval_ms), [this] { return !running_; });
+            }
+        });
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            if (!running_) return;
+            running_ = false;
+            stopping_ = true;   // 让进行中的一轮在当前批次后退出
+        }
+        stop_cv_.notify_all();
+        worker_.join();
+    }
+
+    ReserveSweepStats GetStats() const {
+        ReserveSweepStats stats;
+        stats.runs = runs_.load(std::memory_order_relaxed);
+        stats.batches = batches_.load(std::memory_order_relaxed);
+        stats.scanned = scanned_.load(std::memory_order_relaxed);
+        stats.expired = expired_.load(std::memory_order_relaxed);
+        stats.failed_batches = failed_batches_.load(std::memory_order_relaxed);
+        stats.last_run_time = last_run_time_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    ReserveExpirySweeper() = default;
+    ~ReserveExpirySweeper() { Stop(); }
+
+    std::mutex run_mutex_;
+    ScanFn scan_fn_;
+    ExpireFn expire_fn_;
+    ClockFn today_fn_;
+    ReserveSweepOptions options_;
+
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool started_ = false;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};
+    std::thread worker_;
+
+    std::atomic<uint64_t> runs_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> scanned_{0};
+    std::atomic<uint64_t> expired_{0};
+    std::atomic<uint64_t> failed_batches_{0};
+    std::atomic<int64_t> last_run_time_{0};
+};
+
+#endif // RESERVE_EXPIRY_SWEEPER_H
@@ -0,0 +1,371 @@
+#ifndef RESERVE_ORDER_COMMITTER_H
+#define RESERVE_ORDER_COMMITTER_H
+
+#include "model/reserve_order.h"
+#include "model/reserve_quota.h"
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 提交结果
+ */
+enum class ReserveCommitResult {
+    COMMITTED = 0,       // 订单已落库
+    QUOTA_EXCEEDED = 1,  // 数据库中号源已满（其他实例已约满），事务回滚
+    FAILED = 2,          // 事务失败
+    SLOT_FULL = 3        // 数据库中该时段已满（其他实例已约满该时段），事务回滚
+};
+
+/**
+ * 整批回滚时数据库报告的超出项（deltas / slot_deltas 中的下标）
+ * 未报告（为空）时按整批可疑处理，由组提交器二分定位
+ */
+struct ReserveCommitOverflow {
+    std::vector<size_t> quota;  // 使 used_quota 超过 total_quota 的号源增量
+    std::vector<size_t> slots;  // 使时段占用超过容量的时段增量
+};
+
+/**
+ * 组提交参数
+ */
+struct ReserveCommitOptions {
+    size_t max_batch = 256;        // 单个事务最多包含的订单数
+    int commit_interval_ms = 5;    // 攒批最长等待时间（首个订单到达起算）
+};
+
+/**
+ * 组提交统计
+ */
+struct ReserveCommitStats {
+    uint64_t orders = 0;        // 已提交订单数
+    uint64_t batches = 0;       // 已提交事务数
+    uint64_t failed = 0;        // 失败订单数
+    uint64_t quota_exceeded = 0; // 因数据库号源已满被拒的订单数
+    uint64_t slot_full = 0;     // 因数据库时段已满被拒的订单数
+    uint64_t fallbacks = 0;     // 整批回滚后拆分重试的次数
+};
+
+/**
+ * 预约订单组提交：多个线程提交的订单由后台线程攒批，在一个事务中写入订单并累加号源增量
+ * - 调用方拿到 future，订单真正落库（事务提交成功）后完成
+ * - 号源/时段超出时只拆出涉及超出键的订单（二分，先入队的优先），其余订单重新成批提交；
+ *   同一批内某键已确认约满后，该键的剩余订单直接拒绝，不再逐单开事务
+ * - 事务失败（非号源原因）时逐单重试，只让有问题的订单失败
+ * - 号源增量由本批订单按 (医院, 科室, 日期) 汇总，与订单在同一事务内写入；事务内以数据库为准校验
+ *   used_quota + 增量 <= total_quota，多实例各自的内存配额合计超出时由这里拒绝，不会超卖
+ * - 占用了分时段号源的订单另按 (医院, 科室, 日期, 时段) 汇总时段增量，同一事务内校验时段容量，
+ *   多实例各自的时段计数合计超出时同样整体回滚
+ */
+class ReserveOrderCommitter {
+public:
+    // 在一个事务中写入订单、号源增量与时段增量；任一号源增量使 used_quota 超过 total_quota 时回滚并返回
+    // QUOTA_EXCEEDED，任一时段增量使该时段占用超过容量时回滚并返回 SLOT_FULL；
+    // 回滚前把全部超出的增量下标写入 overflow（不报告时组提交器自行二分定位）
+    using CommitFn = std::function<ReserveCommitResult(const std::vector<ReserveOrder>& orders,
+                                                       const std::vector<ReserveQuotaDelta>& deltas,
+                                                       const std::vector<ReserveSlotDelta>& slot_deltas,
+                                                       ReserveCommitOverflow& overflow)>;
+
+    static ReserveOrderCommitter& GetInstance() {
+        static ReserveOrderCommitter instance;
+        return instance;
+    }
+
+    ReserveOrderCommitter(const ReserveOrderCommitter&) = delete;
+    ReserveOrderCommitter& operator=(const ReserveOrderCommitter&) = delete;
+
+    /**
+     * 设置提交回调并启动后台线程
+     */
+    void Start(CommitFn commit_fn, ReserveCommitOptions options = ReserveCommitOptions()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            return;
+        }
+        commit_fn_ = std::move(commit_fn);
+        options_ = options;
+        running_ = true;
+        worker_ = std::thread([this] { CommitLoop(); });
+    }
+
+    /**
+     * 停止后台线程（停止前提交队列中剩余订单）
+     */
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        cv_.notify_all();
+        worker_.join();
+    }
+
+    /**
+     * 提交订单（未启动时返回已完成的 FAILED）
+     * @param slotted 订单是否占用了分时段号源（是则按 reserve_period 汇总时段增量，在数据库侧校验时段容量）
+     */
+    std::future<ReserveCommitResult> Submit(const ReserveOrder& order, bool slotted = false) {
+        Pending pending;
+        pending.order = order;
+        pending.slotted = slotted;
+        std::future<ReserveCommitResult> result = pending.promise.get_future();
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                pending.promise.set_value(ReserveCommitResult::FAILED);
+                return result;
+            }
+            if (queue_.empty()) {
+                first_enqueue_ = std::chrono::steady_clock::now();
+            }
+            queue_.push_back(std::move(pending));
+            notify = queue_.size() == 1 || queue_.size() >= options_.max_batch;
+        }
+        if (notify) {
+            cv_.notify_one();
+        }
+        return result;
+    }
+
+    ReserveCommitStats GetStats() const {
+        ReserveCommitStats stats;
+        stats.orders = orders_.load(std::memory_order_relaxed);
+        stats.batches = batches_.load(std::memory_order_relaxed);
+        stats.failed = failed_.load(std::memory_order_relaxed);
+        stats.quota_exceeded = quota_exceeded_.load(std::memory_order_relaxed);
+        stats.slot_full = slot_full_.load(std::memory_order_relaxed);
+        stats.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Pending {
+        ReserveOrder order;
+        bool slotted = false;
+        std::promise<ReserveCommitResult> promise;
+    };
+
+    using QuotaKey = std::tuple<std::string, std::string, std::string>;              // 医院, 科室, 日期
+    using SlotKey = std::tuple<std::string, std::string, std::string, std::string>;  // 医院, 科室, 日期, 时段
+
+    // 一批订单拆分重试过程中已确认约满的键
+    struct FullKeys {
+        std::set<QuotaKey> quota;
+        std::set<SlotKey> slots;
+    };
+
+    ReserveOrderCommitter() = default;
+    ~ReserveOrderCommitter() { Stop(); }
+
+    void CommitLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                break; // 已停止且无剩余订单
+            }
+            // 攒批：等到满批、超过提交间隔或停止
+            auto deadline = first_enqueue_ + std::chrono::milliseconds(options_.commit_interval_ms);
+            cv_.wait_until(lock, deadline, [this] { return !running_ || queue_.size() >= options_.max_batch; });
+
+            std::vector<Pending> batch;
+            if (queue_.size() <= options_.max_batch) {
+                batch.swap(queue_);
+            } else {
+                batch.assign(std::make_move_iterator(queue_.begin()),
+                             std::make_move_iterator(queue_.begin() + options_.max_batch));
+                queue_.erase(queue_.begin(), queue_.begin() + options_.max_batch);
+                first_enqueue_ = std::chrono::steady_clock::now();
+            }
+            lock.unlock();
+            CommitBatch(batch);
+            lock.lock();
+        }
+    }
+
+    static QuotaKey QuotaKeyOf(const ReserveOrder& order) {
+        return std::make_tuple(order.hospital_id, order.department, order.reserve_date);
+    }
+
+    static SlotKey SlotKeyOf(const ReserveOrder& order) {
+        return std::make_tuple(order.hospital_id, order.department, order.reserve_date, order.reserve_period);
+    }
+
+    void CommitBatch(std::vector<Pending>& batch) {
+        std::vector<size_t> all(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) all[i] = i;
+        FullKeys full;
+        CommitGroup(batch, all, full);
+    }
+
+    /**
+     * 提交 batch 中下标为 members 的订单（一个事务）
+     * 号源/时段超出时拆出涉及超出键的订单二分重试，其余订单重新成批提交
+     */
+    void CommitGroup(std::vector<Pending>& batch, const std::vector<size_t>& members, FullKeys& full) {
+        // 已确认约满的键：直接拒绝
+        std::vector<size_t> group;
+        group.reserve(members.size());
+        for (size_t i : members) {
+            if (full.quota.count(QuotaKeyOf(batch[i].order))) {
+                Settle(batch[i], ReserveCommitResult::QUOTA_EXCEEDED);
+            } else if (batch[i].slotted && full.slots.count(SlotKeyOf(batch[i].order))) {
+                Settle(batch[i], ReserveCommitResult::SLOT_FULL);
+            } else {
+                group.push_back(i);
+            }
+        }
+        if (group.empty()) {
+            return;
+        }
+
+        std::vector<ReserveOrder> orders;
+        std::vector<bool> slotted;
+        orders.reserve(group.size());
+        slotted.reserve(group.size());
+        for (size_t i : group) {
+            orders.push_back(batch[i].order);
+            slotted.push_back(batch[i].slotted);
+        }
+        std::set<QuotaKey> overflowed_quota;
+        std::set<SlotKey> overflowed_slots;
+        ReserveCommitResult result = TryCommit(orders, slotted, overflowed_quota, overflowed_slots);
+        if (result == ReserveCommitResult::COMMITTED) {
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            for (size_t i : group) Settle(batch[i], ReserveCommitResult::COMMITTED);
+            return;
+        }
+        if (group.size() == 1) {
+            // 单个订单被拒：记下约满的键，同批后续订单不再尝试
+            if (result == ReserveCommitResult::QUOTA_EXCEEDED) {
+                full.quota.insert(QuotaKeyOf(orders[0]));
+            } else if (result == ReserveCommitResult::SLOT_FULL && slotted[0]) {
+                full.slots.insert(SlotKeyOf(orders[0]));
+            } else if (result == ReserveCommitResult::FAILED) {
+                SPDLOG_ERROR("预约订单保存失败，order_id={}", orders[0].order_id);
+            }
+            Settle(batch[group[0]], result);
+            return;
+        }
+
+        fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        if (result == ReserveCommitResult::FAILED) {
+            // 非号源原因：逐单重试，只让有问题的订单失败
+            SPDLOG_WARN("预约订单组提交失败，逐单重试，count={}", group.size());
+            for (size_t i : group) CommitGroup(batch, std::vector<size_t>{i}, full);
+            return;
+        }
+
+        // 号源/时段超出：不涉及超出键的订单重新成批提交；涉及的（或数据库未报告超出键时的整组）二分重试
+        std::vector<size_t> clean;
+        std::vector<size_t> suspect;
+        bool reported = !overflowed_quota.empty() || !overflowed_slots.empty();
+        for (size_t k = 0; k < group.size(); ++k) {
+            bool hit = !reported || overflowed_quota.count(QuotaKeyOf(orders[k])) ||
+                       (slotted[k] && overflowed_slots.count(SlotKeyOf(orders[k])));
+            (hit ? suspect : clean).push_back(group[k]);
+        }
+        if (!clean.empty()) {
+            CommitGroup(batch, clean, full);
+        }
+        // 涉及超出键的订单整体重试必然再次超出：对半拆分，先入队的一半优先
+        if (suspect.size() == 1) {
+            CommitGroup(batch, suspect, full);
+        } else if (!suspect.empty()) {
+            size_t half = suspect.size() / 2;
+            CommitGroup(batch, std::vector<size_t>(suspect.begin(), suspect.begin() + half), full);
+            CommitGroup(batch, std::vector<size_t>(suspect.begin() + half, suspect.end()), full);
+        }
+    }
+
+    void Settle(Pending& pending, ReserveCommitResult result) {
+        if (result == ReserveCommitResult::COMMITTED) {
+            orders_.fetch_add(1, std::memory_order_relaxed);
+        } else if (result == ReserveCommitResult::QUOTA_EXCEEDED) {
+            quota_exceeded_.fetch_add(1, std::memory_order_relaxed);
+        } else if (result == ReserveCommitResult::SLOT_FULL) {
+            slot_full_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        pending.promise.set_value(result);
+    }
+
+    ReserveCommitResult TryCommit(const std::vector<ReserveOrder>& orders, const std::vector<bool>& slotted,
+                                  std::set<QuotaKey>& overflowed_quota, std::set<SlotKey>& overflowed_slots) {
+        // 汇总本批号源增量与时段增量
+        std::map<QuotaKey, int> grouped;
+        std::map<SlotKey, int> grouped_slots;
+        for (size_t i = 0; i < orders.size(); ++i) {
+            ++grouped[QuotaKeyOf(orders[i])];
+            if (slotted[i]) {
+                ++grouped_slots[SlotKeyOf(orders[i])];
+            }
+        }
+        std::vector<ReserveQuotaDelta> deltas;
+        deltas.reserve(grouped.size());
+        for (const auto& item : grouped) {
+            deltas.push_back(ReserveQuotaDelta{std::get<0>(item.first), std::get<1>(item.first),
+                                               std::get<2>(item.first), item.second});
+        }
+        std::vector<ReserveSlotDelta> slot_deltas;
+        slot_deltas.reserve(grouped_slots.size());
+        for (const auto& item : grouped_slots) {
+            slot_deltas.push_back(ReserveSlotDelta{std::get<0>(item.first), std::get<1>(item.first),
+                                                   std::get<2>(item.first), std::get<3>(item.first), item.second});
+        }
+        ReserveCommitOverflow overflow;
+        ReserveCommitResult result;
+        try {
+            result = commit_fn_(orders, deltas, slot_deltas, overflow);
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("预约订单提交异常，count={}, error={}", orders.size(), e.what());
+            return ReserveCommitResult::FAILED;
+        }
+        for (size_t i : overflow.quota) {
+            if (i < deltas.size()) {
+                overflowed_quota.insert(std::make_tuple(deltas[i].hospital_id, deltas[i].department,
+                                                        deltas[i].reserve_date));
+            }
+        }
+        for (size_t i : overflow.slots) {
+            if (i < slot_deltas.size()) {
+                overflowed_slots.insert(std::make_tuple(slot_deltas[i].hospital_id, slot_deltas[i].department,
+                                                        slot_deltas[i].reserve_date, slot_deltas[i].period));
+            }
+        }
+        return result;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Pending> queue_;                                  // 待提交订单
+    std::chrono::steady_clock::time_point first_enqueue_;         // 当前批次首个订单到达时间
+    CommitFn commit_fn_;
+    ReserveCommitOptions options_;
+    bool running_ = false;
+    std::thread worker_;
+
+    std::atomic<uint64_t> orders_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> quota_exceeded_{0};
+    std::atomic<uint64_t> slot_full_{0};
+    std::atomic<uint64_t> fallbacks_{0};
+};
+
+#endif // RESERVE_ORDER_COMMITTER_H
@@ -0,0 +1,404 @@
+#ifndef RESERVE_QUOTA_ENGINE_H
+#define RESERVE_QUOTA_ENGINE_H
+
+#include "model/reserve_quota.h"
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 配额占用结果
+ */
+enum class QuotaAcquireResult {
+    OK = 0,         // 占用成功
+    SOLD_OUT = 1,   // 号源已满
+    UNKNOWN = 2     // 医院/科室/日期不存在或加载失败
+};
+
+/**
+ * 配额引擎统计
+ */
+struct ReserveQuotaStats {
+    uint64_t acquired = 0;   // 占用成功次数
+    uint64_t sold_out = 0;   // 因约满被拒次数
+    uint64_t released = 0;   // 释放次数
+    uint64_t flushed = 0;    // 已写回数据库的增量条数
+    uint64_t evicted = 0;    // 已淘汰的过期计数器数量
+    size_t counters = 0;     // 内存中的配额计数器数量
+};
+
+/**
+ * 挂号配额引擎：按 (医院, 科室, 日期) 在内存中维护剩余号源
+ * - 占用为原子的“大于0才减一”（CAS），单实例内不会超卖，也不在数据库行锁上排队
+ * - 多实例部署时各实例的计数器只是本实例视角的快速拒绝：最终由订单提交事务按数据库 used_quota 校验，
+ *   被拒时用 Refresh 以数据库为准重新加载该键
+ * - 占用/释放的增量累积在计数器上，由后台线程定期批量写回数据库
+ * - 启动时用 Reconcile 以数据库（有效预约订单统计）为准校正计数器；首次访问的键按需加载
+ * - 计数器以 shared_ptr 持有：写回线程每轮淘汰就诊日早于今天、增量已写回且没有调用方持有的计数器，
+ *   淘汰后再访问（如取消历史订单归还号源）按需重新加载
+ */
+class ReserveQuotaEngine {
+public:
+    // 加载单个键的配额（不存在返回 false）
+    using Loader = std::function<bool(const std::string& hospital_id, const std::string& department,
+                                      const std::string& reserve_date, ReserveQuota& out)>;
+    // 批量写回增量（失败返回 false，增量保留到下一轮）
+    using Flusher = std::function<bool(const std::vector<ReserveQuotaDelta>& deltas)>;
+    // 当前日期（yyyy-mm-dd）
+    using DateFn = std::function<std::string()>;
+    // 淘汰回调：写回线程淘汰计数器后以同一日期调用（供时段库存等同步淘汰）
+    using EvictHook = std::function<void(const std::string& before_date)>;
+
+    static ReserveQuotaEngine& GetInstance() {
+        static ReserveQuotaEngine instance;
+        return instance;
+    }
+
+    ReserveQuotaEngine(const ReserveQuotaEngine&) = delete;
+    ReserveQuotaEngine& operator=(const ReserveQuotaEngine&) = delete;
+
+    /**
+     * 设置加载/写回回调（启动时调用一次）
+     */
+    void Configure(Loader loader, Flusher flusher, int flush_interval_ms = 500) {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        loader_ = std::move(loader);
+        flusher_ = std::move(flusher);
+        flush_interval_ms_ = flush_interval_ms;
+    }
+
+    /**
+     * 以数据库快照校正计数器（启动对账，应在接收预约请求之前调用）
+     * 已存在的计数器原地覆盖，持有其指针的并发占用不会悬空
+     */
+    void Reconcile(const std::vector<ReserveQuota>& snapshot) {
+        for (const auto& quota : snapshot) {
+            std::string key = MakeKey(quota.hospital_id, quota.department, quota.reserve_date);
+            Shard& shard = ShardOf(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto& slot = shard.counters[key];
+            if (!slot) {
+                slot = MakeCounter(quota);
+            } else {
+                slot->remaining.store(std::max(0, quota.total_quota - quota.used_quota), std::memory_order_relaxed);
+                slot->unflushed.store(0, std::memory_order_relaxed);
+            }
+        }
+        SPDLOG_INFO("挂号配额对账完成，counters={}", snapshot.size());
+    }
+
+    /**
+     * 占用一个号源
+     * @param write_behind false 表示增量由调用方自行落库（如与订单同一事务组提交），引擎不再写回
+     */
+    QuotaAcquireResult TryAcquire(const std::string& hospital_id, const std::string& department,
+                                  const std::string& reserve_date, bool write_behind = true) {
+        std::shared_ptr<Counter> counter = FindOrLoad(hospital_id, department, reserve_date);
+        if (!counter) {
+            return QuotaAcquireResult::UNKNOWN;
+        }
+        int remaining = counter->remaining.load(std::memory_order_relaxed);
+        while (remaining > 0) {
+            if (counter->remaining.compare_exchange_weak(remaining, remaining - 1, std::memory_order_acq_rel)) {
+                if (write_behind) counter->unflushed.fetch_add(1, std::memory_order_relaxed);
+                acquired_.fetch_add(1, std::memory_order_relaxed);
+                return QuotaAcquireResult::OK;
+            }
+        }
+        sold_out_.fetch_add(1, std::memory_order_relaxed);
+        return QuotaAcquireResult::SOLD_OUT;
+    }
+
+    /**
+     * 释放一个号源（订单保存失败、取消或过期时调用）
+     * @param write_behind 与占用时一致：false 表示该号源的占用从未由引擎写回
+     */
+    void Release(const std::string& hospital_id, const std::string& department, const std::string& reserve_date,
+                 bool write_behind = true) {
+        std::shared_ptr<Counter> counter = FindOrLoad(hospital_id, department, reserve_date);
+        if (!counter) {
+            return;
+        }
+        counter->remaining.fetch_add(1, std::memory_order_acq_rel);
+        if (write_behind) counter->unflushed.fetch_sub(1, std::memory_order_relaxed);
+        released_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * 以数据库为准重新加载某个键的剩余号源（订单提交因号源已满被拒时调用，其他实例已占用的号源随之扣除）
+     */
+    void Refresh(const std::string& hospital_id, const std::string& department, const std::string& reserve_date) {
+        Loader loader;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex_);
+            loader = loader_;
+        }
+        ReserveQuota quota;
+        if (!loader || !loader(hospital_id, department, reserve_date, quota)) {
+            return;
+        }
+        std::string key = MakeKey(hospital_id, department, reserve_date);
+        Shard& shard = ShardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto& slot = shard.counters[key];
+        if (!slot) {
+            slot = MakeCounter(quota);
+        } else {
+            // 本实例尚未写回的占用不在数据库中，需一并扣除
+            int unflushed = slot->unflushed.load(std::memory_order_relaxed);
+            slot->remaining.store(std::max(0, quota.total_quota - quota.used_quota - unflushed),
+                                  std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * 查询剩余号源（未加载返回 -1，不触发加载）
+     */
+    int Remaining(const std::string& hospital_id, const std::string& department, const std::string& reserve_date) const {
+        std::string key = MakeKey(hospital_id, department, reserve_date);
+        const Shard& shard = ShardOf(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.counters.find(key);
+        return it == shard.counters.end() ? -1 : it->second->remaining.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * 把累积的增量批量写回数据库
+     * @return 写回的增量条数
+     */
+    size_t Flush() {
+        std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+        Flusher flusher;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex_);
+            flusher = flusher_;
+        }
+        if (!flusher) {
+            return 0;
+        }
+
+        std::vector<ReserveQuotaDelta> deltas;
+        std::vector<std::shared_ptr<Counter>> touched;
+        for (size_t i = 0; i < kShardCount; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            for (auto& item : shards_[i].counters) {
+                int delta = item.second->unflushed.exchange(0, std::memory_order_relaxed);
+                if (delta != 0) {
+                    const Counter* counter = item.second.get();
+                    deltas.push_back(ReserveQuotaDelta{counter->hospital_id, counter->department,
+                                                       counter->reserve_date, delta});
+                    touched.push_back(item.second);
+                }
+            }
+        }
+        if (deltas.empty()) {
+            return 0;
+        }
+
+        bool ok = false;
+        try {
+            ok = flusher(deltas);
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("挂号配额写回异常，count={}, error={}", deltas.size(), e.what());
+        }
+        if (!ok) {
+            // 写回失败：增量加回计数器，下一轮重试
+            for (size_t i = 0; i < deltas.size(); ++i) {
+                touched[i]->unflushed.fetch_add(deltas[i].used_delta, std::memory_order_relaxed);
+            }
+            return 0;
+        }
+        flushed_.fetch_add(deltas.size(), std::memory_order_relaxed);
+        return deltas.size();
+    }
+
+    /**
+     * 淘汰就诊日早于 before_date 的计数器（尚有未写回增量或仍被调用方持有的跳过，下一轮再试）
+     * @return 淘汰的计数器数量
+     */
+    size_t EvictBefore(const std::string& before_date) {
+        size_t evicted = 0;
+        for (size_t i = 0; i < kShardCount; ++i) {
+            Shard& shard = shards_[i];
+            {
+                // 先在读锁下确认有可淘汰的键，避免每轮都以写锁阻塞占用
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                bool any = std::any_of(shard.counters.begin(), shard.counters.end(), [&](const auto& item) {
+                    return item.second->reserve_date < before_date;
+                });
+                if (!any) continue;
+            }
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto it = shard.counters.begin(); it != shard.counters.end();) {
+                // 写锁下 use_count 为 1 说明只有表本身持有：没有进行中的占用/释放/写回，也不会再有新的持有者
+                const std::shared_ptr<Counter>& counter = it->second;
+                if (counter->reserve_date < before_date && counter.use_count() == 1 &&
+                    counter->unflushed.load(std::memory_order_relaxed) == 0) {
+                    it = shard.counters.erase(it);
+                    ++evicted;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        if (evicted > 0) {
+            evicted_.fetch_add(evicted, std::memory_order_relaxed);
+            SPDLOG_INFO("淘汰过期挂号配额计数器，before={}, count={}", before_date, evicted);
+        }
+        return evicted;
+    }
+
+    /**
+     * 启动后台写回线程
+     * @param today 非空时每轮写回后淘汰就诊日早于今天的计数器
+     * @param evict_hook 每轮淘汰后以同一日期调用
+     */
+    void Start(DateFn today = nullptr, EvictHook evict_hook = nullptr) {
+        if (running_.exchange(true)) {
+            return;
+        }
+        worker_ = std::thread([this, today, evict_hook] {
+            std::unique_lock<std::mutex> lock(stop_mutex_);
+            while (running_) {
+                stop_cv_.wait_for(lock, std::chrono::milliseconds(flush_interval_ms_), [this] { return !running_; });
+                lock.unlock();
+                Flush();
+                if (today) {
+                    std::string date = today();
+                    EvictBefore(date);
+                    if (evict_hook) evict_hook(date);
+                }
+                lock.lock();
+            }
+        });
+    }
+
+    /**
+     * 停止后台线程（停止前写回剩余增量）
+     */
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            if (!running_.exchange(false)) return;
+        }
+        stop_cv_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    ReserveQuotaStats GetStats() const {
+        ReserveQuotaStats stats;
+        stats.acquired = acquired_.load(std::memory_order_relaxed);
+        stats.sold_out = sold_out_.load(std::memory_order_relaxed);
+        stats.released = released_.load(std::memory_order_relaxed);
+        stats.flushed = flushed_.load(std::memory_order_relaxed);
+        stats.evicted = evicted_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kShardCount; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            stats.counters += shards_[i].counters.size();
+        }
+        return stats;
+    }
+
+private:
+    static constexpr size_t kShardCount = 32;
+
+    struct Counter {
+        std::string hospital_id;
+        std::string department;
+        std::string reserve_date;
+        std::atomic<int> remaining{0};   // 剩余号源
+        std::atomic<int> unflushed{0};   // 尚未写回的已占用增量
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<Counter>> counters;
+    };
+
+    ReserveQuotaEngine() = default;
+    ~ReserveQuotaEngine() {
+        Stop();
+        Flush();
+    }
+
+    static std::string MakeKey(const std::string& hospital_id, const std::string& department,
+                               const std::string& reserve_date) {
+        return hospital_id + '\x1f' + department + '\x1f' + reserve_date;
+    }
+
+    static std::shared_ptr<Counter> MakeCounter(const ReserveQuota& quota) {
+        std::shared_ptr<Counter> counter = std::make_shared<Counter>();
+        counter->hospital_id = quota.hospital_id;
+        counter->department = quota.department;
+        counter->reserve_date = quota.reserve_date;
+        counter->remaining.store(std::max(0, quota.total_quota - quota.used_quota), std::memory_order_relaxed);
+        return counter;
+    }
+
+    Shard& ShardOf(const std::string& key) { return shards_[std::hash<std::string>{}(key) % kShardCount]; }
+    const Shard& ShardOf(const std::string& key) const { return shards_[std::hash<std::string>{}(key) % kShardCount]; }
+
+    /**
+     * 查找计数器，不存在时通过 Loader 加载（返回的 shared_ptr 在计数器被淘汰后仍然有效）
+     */
+    std::shared_ptr<Counter> FindOrLoad(const std::string& hospital_id, const std::string& department,
+                        const std::string& reserve_date) {
+        std::string key = MakeKey(hospital_id, department, reserve_date);
+        Shard& shard = ShardOf(key);
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.counters.find(key);
+            if (it != shard.counters.end()) {
+                return it->second;
+            }
+        }
+
+        Loader loader;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex_);
+            loader = loader_;
+        }
+        ReserveQuota quota;
+        if (!loader || !loader(hospital_id, department, reserve_date, quota)) {
+            return nullptr;
+        }
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto& slot = shard.counters[key];
+        if (!slot) {
+            slot = MakeCounter(quota); // 并发加载时只保留先写入的一份
+        }
+        return slot;
+    }
+
+    Shard shards_[kShardCount];
+
+    std::mutex config_mutex_;
+    Loader loader_;
+    Flusher flusher_;
+    int flush_interval_ms_ = 500;
+
+    std::mutex flush_mutex_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    std::atomic<bool> running_{false};
+    std::thread worker_;
+
+    std::atomic<uint64_t> acquired_{0};
+    std::atomic<uint64_t> sold_out_{0};
+    std::atomic<uint64_t> released_{0};
+    std::atomic<uint64_t> flushed_{0};
+    std::atomic<uint64_t> evicted_{0};
+};
+
+#endif // RESERVE_QUOTA_ENGINE_H
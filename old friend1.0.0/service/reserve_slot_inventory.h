@@ -0,0 +1,307 @@
+#ifndef RESERVE_SLOT_INVENTORY_H
+#define RESERVE_SLOT_INVENTORY_H
+
+#include "model/reserve_quota.h"
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <inttypes.h>
+
+/**
+ * 时段占用结果
+ */
+enum class SlotClaimResult {
+    OK = 0,             // 占用成功
+    FULL = 1,           // 时段已满（未指定时段时为全部时段已满）
+    UNKNOWN_PERIOD = 2, // 该日有分时段号源，但没有指定的时段
+    NOT_SLOTTED = 3     // 该日未配置分时段号源
+};
+
+/**
+ * 时段号源视图（查询返回）
+ */
+struct ReserveSlotView {
+    std::string period;
+    int capacity = 0;
+    int free = 0;
+};
+
+/**
+ * 就诊时段号源库存：按 (医院, 科室, 日期) 保存各时段的容量与已占用计数
+ * - 时段按模板顺序排列（上午在前），“第一个有空位的时段”即从前往后第一个未满的计数器
+ * - 占用/释放为单个时段计数器上的原子操作（CAS 大于容量不加），不会超出时段容量
+ * - 同一天的时段布局加载后固定；对账时布局不变则原地校正计数，布局变化则整体替换
+ * 持久化：时段占用以订单的 reserve_period 为准，由订单落库体现，启动时按有效订单重新统计
+ * 多实例：内存计数只是本实例的预判；订单提交时时段增量与订单在同一事务内按数据库校验时段容量
+ *   （见 ReserveOrderCommitter），其他实例已约满时事务回滚，调用方归还时段并 Refresh 到数据库的占用
+ * 淘汰：EvictBefore 删除就诊日已过的日期；进行中的占用/释放持有 shared_ptr，不会悬空
+ */
+class ReserveSlotInventory {
+public:
+    // 加载某天的时段（按模板顺序，含已占用数），不存在返回 false
+    using Loader = std::function<bool(const std::string& hospital_id, const std::string& department,
+                                      const std::string& reserve_date, std::vector<ReserveSlot>& out)>;
+
+    static ReserveSlotInventory& GetInstance() {
+        static ReserveSlotInventory instance;
+        return instance;
+    }
+
+    ReserveSlotInventory(const ReserveSlotInventory&) = delete;
+    ReserveSlotInventory& operator=(const ReserveSlotInventory&) = delete;
+
+    void Configure(Loader loader) {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        loader_ = std::move(loader);
+    }
+
+    /**
+     * 以数据库快照校正（启动对账；快照中同一天的时段需按模板顺序连续排列）
+     */
+    void Reconcile(const std::vector<ReserveSlot>& snapshot) {
+        size_t begin = 0;
+        while (begin < snapshot.size()) {
+            size_t end = begin + 1;
+            while (end < snapshot.size() && SameDay(snapshot[begin], snapshot[end])) ++end;
+            std::vector<ReserveSlot> day(snapshot.begin() + begin, snapshot.begin() + end);
+            Apply(MakeKey(day[0].hospital_id, day[0].department, day[0].reserve_date), day);
+            begin = end;
+        }
+        SPDLOG_INFO("就诊时段号源对账完成，slots={}", snapshot.size());
+    }
+
+    /**
+     * 按数据库重新加载某天的时段占用（提交时数据库报告时段已满后调用）
+     */
+    void Refresh(const std::string& hospital_id, const std::string& department, const std::string& reserve_date) {
+        std::vector<ReserveSlot> day;
+        if (!Load(hospital_id, department, reserve_date, day)) {
+            return;
+        }
+        Apply(MakeKey(hospital_id, department, reserve_date), day);
+    }
+
+    /**
+     * 占用第一个有空位的时段
+     * @param period 输出占用到的时段
+     */
+    SlotClaimResult ClaimFirstFree(const std::string& hospital_id, const std::string& department,
+                                   const std::string& reserve_date, std::string& period) {
+        std::shared_ptr<SlotDay> day = FindOrLoad(hospital_id, department, reserve_date);
+        if (!day) {
+            return SlotClaimResult::NOT_SLOTTED;
+        }
+        for (size_t i = 0; i < day->count; ++i) {
+            if (TryClaim(day->slots[i])) {
+                period = day->slots[i].period;
+                return SlotClaimResult::OK;
+            }
+        }
+        return SlotClaimResult::FULL;
+    }
+
+    /**
+     * 占用指定时段
+     */
+    SlotClaimResult Claim(const std::string& hospital_id, const std::string& department,
+                          const std::string& reserve_date, const std::string& period) {
+        std::shared_ptr<SlotDay> day = FindOrLoad(hospital_id, department, reserve_date);
+        if (!day) {
+            return SlotClaimResult::NOT_SLOTTED;
+        }
+        Slot* slot = day->Find(period);
+        if (slot == nullptr) {
+            return SlotClaimResult::UNKNOWN_PERIOD;
+        }
+        return TryClaim(*slot) ? SlotClaimResult::OK : SlotClaimResult::FULL;
+    }
+
+    /**
+     * 把号源归还到原时段（取消、过期、保存失败时调用）
+     */
+    bool Release(const std::string& hospital_id, const std::string& department,
+                 const std::string& reserve_date, const std::string& period) {
+        std::shared_ptr<SlotDay> day = FindOrLoad(hospital_id, department, reserve_date);
+        Slot* slot = day ? day->Find(period) : nullptr;
+        if (slot == nullptr) {
+            return false;
+        }
+        int used = slot->used.load(std::memory_order_relaxed);
+        while (used > 0) {
+            if (slot->used.compare_exchange_weak(used, used - 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * 淘汰就诊日早于 before_date 的时段库存（之后再访问按需重新加载）
+     * @return 淘汰的日期数
+     */
+    size_t EvictBefore(const std::string& before_date) {
+        size_t evicted = 0;
+        for (size_t i = 0; i < kShardCount; ++i) {
+            std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+            for (auto it = shards_[i].days.begin(); it != shards_[i].days.end();) {
+                if (it->second->reserve_date < before_date) {
+                    it = shards_[i].days.erase(it);
+                    ++evicted;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        if (evicted > 0) {
+            SPDLOG_INFO("淘汰过期就诊时段库存，before={}, days={}", before_date, evicted);
+        }
+        return evicted;
+    }
+
+    /**
+     * 查询剩余号源不少于 min_free 的时段（按模板顺序）
+     */
+    std::vector<ReserveSlotView> SlotsWithAtLeast(const std::string& hospital_id, const std::string& department,
+                                                  const std::string& reserve_date, int min_free) {
+        std::vector<ReserveSlotView> result;
+        std::shared_ptr<SlotDay> day = FindOrLoad(hospital_id, department, reserve_date);
+        if (!day) {
+            return result;
+        }
+        for (size_t i = 0; i < day->count; ++i) {
+            const Slot& slot = day->slots[i];
+            int free = slot.capacity - slot.used.load(std::memory_order_relaxed);
+            if (free >= min_free) {
+                result.push_back(ReserveSlotView{slot.period, slot.capacity, free});
+            }
+        }
+        return result;
+    }
+
+private:
+    static constexpr size_t kShardCount = 32;
+
+    struct Slot {
+        std::string period;
+        int capacity = 0;
+        std::atomic<int> used{0};
+    };
+
+    struct SlotDay {
+        std::string reserve_date;
+        std::unique_ptr<Slot[]> slots;
+        size_t count = 0;
+
+        explicit SlotDay(const std::vector<ReserveSlot>& day)
+            : reserve_date(day[0].reserve_date), slots(new Slot[day.size()]), count(day.size()) {
+            for (size_t i = 0; i < count; ++i) {
+                slots[i].period = day[i].period;
+                slots[i].capacity = day[i].capacity;
+                slots[i].used.store(day[i].used, std::memory_order_relaxed);
+            }
+        }
+
+        Slot* Find(const std::string& period) {
+            for (size_t i = 0; i < count; ++i) {
+                if (slots[i].period == period) return &slots[i];
+            }
+            return nullptr;
+        }
+
+        bool SameLayout(const std::vector<ReserveSlot>& day) const {
+            if (day.size() != count) return false;
+            for (size_t i = 0; i < count; ++i) {
+                if (slots[i].period != day[i].period || slots[i].capacity != day[i].capacity) return false;
+            }
+            return true;
+        }
+    };
+
+    struct Shard {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<SlotDay>> days;
+    };
+
+    ReserveSlotInventory() = default;
+
+    static bool TryClaim(Slot& slot) {
+        int used = slot.used.load(std::memory_order_relaxed);
+        while (used < slot.capacity) {
+            if (slot.used.compare_exchange_weak(used, used + 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool SameDay(const ReserveSlot& a, const ReserveSlot& b) {
+        return a.hospital_id == b.hospital_id && a.department == b.department && a.reserve_date == b.reserve_date;
+    }
+
+    static std::string MakeKey(const std::string& hospital_id, const std::string& department,
+                               const std::string& reserve_date) {
+        return hospital_id + '\x1f' + department + '\x1f' + reserve_date;
+    }
+
+    Shard& ShardOf(const std::string& key) { return shards_[std::hash<std::string>{}(key) % kShardCount]; }
+
+    std::shared_ptr<SlotDay> FindOrLoad(const std::string& hospital_id, const std::string& department,
+                                        const std::string& reserve_date) {
+        std::string key = MakeKey(hospital_id, department, reserve_date);
+        Shard& shard = ShardOf(key);
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.days.find(key);
+            if (it != shard.days.end()) {
+                return it->second;
+            }
+        }
+
+        std::vector<ReserveSlot> day;
+        if (!Load(hospital_id, department, reserve_date, day)) {
+            return nullptr;
+        }
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto& slot = shard.days[key];
+        if (!slot) {
+            slot = std::make_shared<SlotDay>(day);
+        }
+        return slot;
+    }
+
+    bool Load(const std::string& hospital_id, const std::string& department, const std::string& reserve_date,
+              std::vector<ReserveSlot>& day) {
+        Loader loader;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex_);
+            loader = loader_;
+        }
+        return loader && loader(hospital_id, department, reserve_date, day) && !day.empty();
+    }
+
+    // 布局不变则原地校正计数（已取得的 SlotDay 指针继续有效），布局变化则整体替换
+    void Apply(const std::string& key, const std::vector<ReserveSlot>& day) {
+        Shard& shard = ShardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto& slot = shard.days[key];
+        if (!slot || !slot->SameLayout(day)) {
+            slot = std::make_shared<SlotDay>(day);
+        } else {
+            for (size_t i = 0; i < day.size(); ++i) {
+                slot->slots[i].used.store(day[i].used, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Shard shards_[kShardCount];
+    std::mutex config_mutex_;
+    Loader loader_;
+};
+
+#endif // RESERVE_SLOT_INVENTORY_H
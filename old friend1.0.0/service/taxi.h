@@ -5,23 +5,31 @@
 #include "dao/user_dao.h"
 #include "model/taxi_order.h"
 #include "model/taxi.h"
+#include "model/taxi_driver.h"
+#include "service/taxi_dispatcher.h"
+#include "service/driver_position_ingestor.h"
+#include "service/taxi_order_state_machine.h"
+#include "service/order_expiry_scheduler.h"
+#include "service/trip_estimator.h"
+#include "service/common_address_cache.h"
+#include "util/write_behind_buffer.h"
 #include "util/time_util.h"
+#include "util/id_generator.h"
 #include "config/config_parser.h"
 #include "core/logger.h"
 #include <stdexcept>
 #include <fmt/core.h>
-#include <random>
 #include <algorithm>
 #include <vector>
 
 // 打车服务常量定义
 constexpr int TAXI_ORDER_EXPIRE_SECONDS = 600; // 订单超时未派单自动取消（10分钟）
 constexpr int RESERVE_ORDER_MIN_ADVANCE_MINUTES = 30; // 预约单最小提前时间（30分钟）
-constexpr double MAX_DISPATCH_DISTANCE = 5.0; // 司机匹配最大距离（5km，可配置）
-constexpr double BASE_FEE = 10.0; // 起步价（元）
-constexpr double DISTANCE_FEE_PER_KM = 2.3; // 里程费（元/km）
-constexpr double TIME_FEE_PER_MIN = 0.5; // 时长费（元/分钟）
-constexpr double ELDERLY_SERVICE_EXTRA_FEE = 5.0; // 老年专项服务费（元，可选）
+constexpr Money BASE_FEE = Money::FromYuan(10); // 起步价
+constexpr Money DISTANCE_FEE_PER_KM = Money::FromCents(230); // 里程费（每 km）
+constexpr Money TIME_FEE_PER_MIN = Money::FromCents(50); // 时长费（每分钟）
+constexpr Money ELDERLY_SERVICE_EXTRA_FEE = Money::FromYuan(5); // 老年专项服务费（可选）
+constexpr Money ELDERLY_DISCOUNT = Money::FromYuan(3); // 老年人固定优惠
 
 /**
  * 打车服务层：封装打车全流程业务逻辑，适配老年人快捷出行需求
@@ -29,8 +37,16 @@ constexpr double ELDERLY_SERVICE_EXTRA_FEE = 5.0; // 老年专项服务费（元
 class TaxiService {
 public:
     // 依赖注入：通过抽象DAO和工具类隔离依赖，便于测试
-    TaxiService(ITaxiDao* taxi_dao, IUserDao* user_dao, ITimeUtil* time_util)
-        : taxi_dao_(taxi_dao), user_dao_(user_dao), time_util_(time_util) {}
+    TaxiService(ITaxiDao* taxi_dao, IUserDao* user_dao, ITimeUtil* time_util, TaxiDispatcher* dispatcher = nullptr)
+        : taxi_dao_(taxi_dao), user_dao_(user_dao), time_util_(time_util), dispatcher_(dispatcher),
+          state_machine_(taxi_dao),
+          position_ingestor_(dispatcher != nullptr ? &dispatcher->LocationIndex() : nullptr),
+          addr_use_buffer_([taxi_dao](const AddrUseBuffer::Batch& batch) {
+              return taxi_dao->BatchUpdateCommonAddressLastUse(batch);
+          }),
+          dest_use_buffer_([taxi_dao](const DestUseBuffer::Batch& batch) {
+              return taxi_dao->BatchUpdateQuickDestinationLastUse(batch);
+          }) {}
 
     // ====================== 地址管理相关（常用地址） ======================
     /**
@@ -59,6 +75,7 @@ public:
         // 3. 若设置为默认地址，取消其他默认地址
         if (new_addr.is_default) {
             taxi_dao_->CancelOtherDefaultCommonAddress(user_id);
+            address_cache_.OnDefaultCleared(user_id); // 之后保存失败或抛异常时，缓存也不会保留旧的默认标记
         }
 
         // 4. 保存到DAO
@@ -67,6 +84,8 @@ public:
             throw std::runtime_error("常用地址添加失败，请重试");
         }
 
+        address_cache_.OnAdded(user_id, new_addr);
+
         SPDLOG_INFO("用户添加常用地址成功，user_id={}, addr_id={}, name={}", 
             user_id, new_addr.addr_id, new_addr.display_name);
         return new_addr.addr_id;
@@ -80,17 +99,12 @@ public:
             throw std::invalid_argument("用户ID不能为空");
         }
 
-        std::vector<TaxiCommonAddress> addrs = taxi_dao_->QueryCommonAddressesByUserId(user_id);
-        // 排序：默认地址 → 优先级（1最高）→ 最近使用时间（倒序）
-        std::sort(addrs.begin(), addrs.end(), [](const TaxiCommonAddress& a, const TaxiCommonAddress& b) {
-            if (a.is_default != b.is_default) return a.is_default;
-            if (a.priority != b.priority) return a.priority < b.priority;
-            return a.last_use_time > b.last_use_time;
-        });
+        // 已排序列表：默认地址 → 优先级（1最高）→ 最近使用时间（倒序）
+        CommonAddressCache::AddressListPtr addrs = LoadCommonAddresses(user_id);
 
         // 转换为DTO（脱敏+简化字段，返回给前端）
         std::vector<TaxiCommonAddressDTO> dto_list;
-        for (const auto& addr : addrs) {
+        for (const auto& addr : *addrs) {
             TaxiCommonAddressDTO dto;
             dto.addr_id = addr.addr_id;
             dto.display_name = addr.display_name;
@@ -104,6 +118,20 @@ public:
         return dto_list;
     }
 
+    /**
+     * 常用地址缓存命中统计
+     */
+    CommonAddressCacheStats GetCommonAddressCacheStats() const {
+        return address_cache_.GetStats();
+    }
+
+    /**
+     * 使用户常用地址缓存失效（地址在其他入口被修改/删除后调用）
+     */
+    void InvalidateCommonAddressCache(const std::string& user_id) {
+        address_cache_.Invalidate(user_id);
+    }
+
     // ====================== 订单相关（下单→派单→接驾→完成） ======================
     /**
      * 创建打车订单（支持常用地址/快捷目的地/手动输入地址）
@@ -135,9 +163,10 @@ public:
         order.create_time = time_util_->GetCurrentTimestamp();
         order.expire_time = order.create_time + TAXI_ORDER_EXPIRE_SECONDS;
 
-        // 5. 预计算费用（预估距离）
-        double estimate_distance = start_loc.CalculateDistanceTo(end_loc);
-        CalculateEstimateFee(order, estimate_distance);
+        // 5. 预计算费用（按起终点网格对学习到的绕行系数与每公里耗时预估）
+        TripEstimate estimate = trip_estimator_.Estimate(start_loc.latitude, start_loc.longitude,
+            end_loc.latitude, end_loc.longitude);
+        CalculateEstimateFee(order, estimate);
 
         // 6. 保存订单
         bool save_ok = taxi_dao_->SaveTaxiOrder(order);
@@ -145,7 +174,11 @@ public:
             throw std::runtime_error("订单创建失败，请重试");
         }
 
-        DispatchOrder(order.order_id);
+        // 7. 登记超时未派单自动过期，派单成功后撤销
+        OrderExpiryScheduler::GetInstance().Schedule(OrderExpiryKind::TAXI_ORDER, order.order_id, order.expire_time);
+        if (DispatchOrder(order)) {
+            OrderExpiryScheduler::GetInstance().Cancel(OrderExpiryKind::TAXI_ORDER, order.order_id);
+        }
 
         SPDLOG_INFO("创建打车订单成功，order_id={}, user_id={}, start={}, end={}", 
             order.order_id, input.user_id, start_loc.address, end_loc.address);
@@ -159,6 +192,55 @@ public:
         order.update_time = order.accept_time;
 }
 
+    /**
+     * 注册打车订单到期处理，从数据库恢复待派单订单的到期定时器并启动调度线程（服务启动时调用一次）
+     */
+    void InitOrderExpiry() {
+        IdGenerator::Init(); // 订单号发号器启动检查：NODE_ID 非法时启动失败，而不是在首次下单时
+        OrderExpiryScheduler& scheduler = OrderExpiryScheduler::GetInstance();
+        scheduler.SetHandler(OrderExpiryKind::TAXI_ORDER, [this](const std::vector<std::string>& order_ids) {
+            ExpireTaxiOrders(order_ids);
+        });
+        scheduler.Restore(OrderExpiryKind::TAXI_ORDER, taxi_dao_->QueryPendingTaxiOrderExpiries());
+        scheduler.Start();
+    }
+
+    /**
+     * 用最近完成的订单预热行程预估器（服务启动时调用一次，之后随确认送达增量学习）
+     */
+    void WarmUpTripEstimator(size_t limit = 100000) {
+        std::vector<TaxiOrder> orders = taxi_dao_->QueryRecentCompletedOrders(limit);
+        for (const auto& order : orders) {
+            trip_estimator_.Learn(order.start_location.latitude, order.start_location.longitude,
+                order.end_location.latitude, order.end_location.longitude, order.distance, order.duration);
+        }
+        SPDLOG_INFO("行程预估器预热完成，orders={}, pairs={}", orders.size(), trip_estimator_.PairCount());
+    }
+
+    /**
+     * 司机上报位置（空闲司机进入派单索引）
+     */
+    void ReportDriverLocation(const std::string& driver_id, const TaxiLocation& location) {
+        if (driver_id.empty()) {
+            throw std::invalid_argument("司机ID不能为空");
+        }
+        if (dispatcher_ != nullptr) {
+            dispatcher_->UpdateDriverLocation(driver_id, location);
+        }
+    }
+
+    /**
+     * 司机GPS批量上报（高频接入：无锁入队，后台按司机合并后更新派单索引中的空闲司机位置）
+     * @return 成功入队的条数（队列满时丢弃，司机下一次上报会覆盖）
+     */
+    size_t ReportDriverLocations(const std::vector<DriverPositionUpdate>& batch) {
+        if (dispatcher_ == nullptr) {
+            return 0;
+        }
+        position_ingestor_.Start();
+        return position_ingestor_.Ingest(batch);
+    }
+
     /**
      * 确认送达（到达目的地，结束行程）
      */
@@ -180,19 +262,44 @@ public:
         order.duration = actual_duration;
         CalculateActualFee(order);
 
-        // 3. 更新订单状态
+        // 3. 更新订单状态（条件更新：仅在订单仍为“已接驾”时写入结算字段）
         order.status = TaxiOrder::OrderStatus::COMPLETED;
         order.complete_time = time_util_->GetCurrentTimestamp();
         order.update_time = order.complete_time;
         order.pay_status = "未支付"; // 触发支付流程
-
-      
-
-        // 4. 原子更新
-        bool update_order_ok = taxi_dao_->UpdateTaxiOrder(order);
-        bool update_driver_ok = taxi_dao_->UpdateDriver(driver);
-        if (!update_order_ok || !update_driver_ok) {
-            throw std::runtime_error("确认送达失败，请重试");
+        TaxiOrderPatch patch;
+        patch.Set("distance", order.distance)
+             .Set("duration", static_cast<int64_t>(order.duration))
+             .Set("base_fee", order.base_fee)
+             .Set("distance_fee", order.distance_fee)
+             .Set("time_fee", order.time_fee)
+             .Set("extra_fee", order.extra_fee)
+             .Set("discount_fee", order.discount_fee)
+             .Set("total_fee", order.total_fee)
+             .Set("pay_status", order.pay_status)
+             .Set("complete_time", order.complete_time)
+             .Set("update_time", order.update_time);
+        UpdateOrderStatus(order_id, driver_id, TaxiOrder::OrderStatus::PICKED_UP,
+            TaxiOrder::OrderStatus::COMPLETED, "确认送达", patch);
+        trip_estimator_.Learn(order.start_location.latitude, order.start_location.longitude,
+            order.end_location.latitude, order.end_location.longitude, order.distance, order.duration);
+
+        // 4. 司机恢复空闲，位置更新为送达点
+        TaxiDriver driver = taxi_dao_->QueryDriverById(driver_id);
+        driver.status = TaxiDriver::DriverStatus::AVAILABLE;
+        driver.location = order.end_location;
+        driver.update_time = order.update_time;
+        bool driver_saved = taxi_dao_->UpdateDriver(driver);
+        if (!driver_saved) {
+            SPDLOG_ERROR("司机状态恢复失败，driver_id={}, order_id={}", driver_id, order_id);
+        }
+        if (dispatcher_ != nullptr) {
+            // 落库成功才在派单引擎中置为空闲；失败时丢弃内存状态，司机下一次上报时以数据库为准
+            if (driver_saved) {
+                dispatcher_->SetDriverAvailable(driver_id, order.end_location);
+            } else {
+                dispatcher_->ForgetDriver(driver_id);
+            }
         }
 
         SPDLOG_INFO("订单完成，order_id={}, actual_distance={}km, total_fee={}元", 
@@ -211,14 +318,14 @@ private:
             if (id.empty()) {
                 throw std::invalid_argument("常用地址ID不能为空");
             }
-            TaxiCommonAddress addr = taxi_dao_->QueryCommonAddressById(user_id, id);
-            if (addr.addr_id.empty()) {
+            TaxiCommonAddress addr;
+            if (!FindCommonAddress(user_id, id, addr)) {
                 throw std::runtime_error("常用地址不存在");
             }
-            // 更新最近使用时间
-            addr.last_use_time = time_util_->GetCurrentTimestamp();
-            addr.update_time = addr.last_use_time;
-            taxi_dao_->UpdateCommonAddress(addr);
+            // 更新最近使用时间（写回缓冲合并后批量落库，不阻塞下单）
+            int64_t now = time_util_->GetCurrentTimestamp();
+            addr_use_buffer_.Touch(addr.addr_id, now);
+            address_cache_.OnUsed(user_id, addr.addr_id, now);
             return addr.location;
         } else if (type == "quick_dest") {
             // 快捷目的地ID
@@ -231,8 +338,7 @@ private:
             }
             // 若为用户收藏，更新最近使用时间
             if (!user_id.empty() && dest.is_user_collect) {
-                dest.user_last_use_time = time_util_->GetCurrentTimestamp();
-                taxi_dao_->UpdateUserCollectedQuickDestination(dest);
+                dest_use_buffer_.Touch(std::make_pair(user_id, dest.dest_id), time_util_->GetCurrentTimestamp());
             }
             return dest.location;
         } else if (type == "manual") {
@@ -246,36 +352,96 @@ private:
         }
     }
 
+    /**
+     * 派单（未配置派单引擎或附近无司机时，订单保持待派单）
+     */
+    bool DispatchOrder(TaxiOrder& order) {
+        if (dispatcher_ == nullptr) {
+            return false;
+        }
+        return dispatcher_->Dispatch(order);
+    }
+
+    /**
+     * 批量过期超时未派单的订单（条件更新，仅处理仍为“待派单”的订单）
+     */
+    void ExpireTaxiOrders(const std::vector<std::string>& order_ids) {
+        if (dispatcher_ != nullptr) {
+            for (const auto& order_id : order_ids) {
+                dispatcher_->CancelPending(order_id);
+            }
+        }
+        int64_t now = time_util_->GetCurrentTimestamp();
+        TaxiOrderPatch patch;
+        patch.Set("cancelor", std::string("system"))
+             .Set("cancel_reason", std::string("超时未派单"))
+             .Set("cancel_time", now)
+             .Set("update_time", now);
+        size_t expired = state_machine_.TransitionBatch(order_ids,
+            TaxiOrder::OrderStatus::PENDING_DISPATCH, TaxiOrder::OrderStatus::EXPIRED, patch);
+        SPDLOG_INFO("打车订单超时过期，expired={}, total={}", expired, order_ids.size());
+    }
+
+    /**
+     * 读取用户已排序的常用地址列表（缓存未命中时查库，并覆盖尚未落库的最近使用时间）
+     */
+    CommonAddressCache::AddressListPtr LoadCommonAddresses(const std::string& user_id) {
+        uint64_t load_ticket = 0;
+        CommonAddressCache::AddressListPtr cached = address_cache_.Get(user_id, load_ticket);
+        if (cached) {
+            return cached;
+        }
+        std::vector<TaxiCommonAddress> addrs = taxi_dao_->QueryCommonAddressesByUserId(user_id);
+        for (auto& addr : addrs) {
+            addr_use_buffer_.Get(addr.addr_id, addr.last_use_time);
+        }
+        return address_cache_.Put(user_id, std::move(addrs), load_ticket);
+    }
+
+    /**
+     * 按ID查找用户常用地址（先查缓存列表，未找到时回查数据库并使该用户缓存失效）
+     */
+    bool FindCommonAddress(const std::string& user_id, const std::string& addr_id, TaxiCommonAddress& out) {
+        CommonAddressCache::AddressListPtr addrs = LoadCommonAddresses(user_id);
+        for (const auto& addr : *addrs) {
+            if (addr.addr_id == addr_id) {
+                out = addr;
+                return true;
+            }
+        }
+        out = taxi_dao_->QueryCommonAddressById(user_id, addr_id);
+        if (out.addr_id.empty()) {
+            return false;
+        }
+        address_cache_.Invalidate(user_id); // 其他实例新增的地址，下次读取时重新加载
+        return true;
+    }
+
     /**
      * 生成常用地址ID
      */
     std::string GenerateCommonAddrId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("COMMON_ADDR{}{}", time_util_->GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("COMMON_ADDR");
     }
 
     /**
      * 生成订单ID
      */
     std::string GenerateOrderId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(100000, 999999);
-        return fmt::format("TAXI_ORDER{}{}", time_util_->GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("TAXI_ORDER");
     }
 
     /**
      * 预计算订单费用（基于预估距离）
      */
-    void CalculateEstimateFee(TaxiOrder& order, double estimate_distance) {
+    void CalculateEstimateFee(TaxiOrder& order, const TripEstimate& estimate) {
         order.base_fee = BASE_FEE;
-        order.distance_fee = estimate_distance * DISTANCE_FEE_PER_KM;
-        order.time_fee = 10 * TIME_FEE_PER_MIN; // 预估时长10分钟（可优化为基于距离和路况）
-        order.extra_fee = order.need_elderly_service ? ELDERLY_SERVICE_EXTRA_FEE : 0.0;
-        order.discount_fee = 0.0; // 优惠逻辑可扩展
-        order.total_fee = round((order.base_fee + order.distance_fee + order.time_fee + order.extra_fee - order.discount_fee) * 100) / 100;
+        // 预估距离取整到 0.1 km
+        order.distance_fee = DISTANCE_FEE_PER_KM.MulRatio(std::llround(estimate.distance_km * 10), 10);
+        order.time_fee = TIME_FEE_PER_MIN * std::llround(estimate.duration_min);
+        order.extra_fee = ELDERLY_SERVICE_EXTRA_FEE * static_cast<int64_t>(order.need_elderly_service);
+        order.discount_fee = Money(); // 优惠逻辑可扩展
+        order.total_fee = order.base_fee + order.distance_fee + order.time_fee + order.extra_fee - order.discount_fee;
     }
 
     /**
@@ -283,25 +449,28 @@ private:
      */
     void CalculateActualFee(TaxiOrder& order) {
         order.base_fee = BASE_FEE;
-        order.distance_fee = order.distance * DISTANCE_FEE_PER_KM;
-        order.time_fee = order.duration * TIME_FEE_PER_MIN;
-        order.extra_fee = order.need_elderly_service ? ELDERLY_SERVICE_EXTRA_FEE : 0.0;
+        // 实际距离按米计价，四舍五入到分；各项均为整数分，总价精确相加
+        order.distance_fee = DISTANCE_FEE_PER_KM.MulRatio(std::llround(order.distance * 1000), 1000);
+        order.time_fee = TIME_FEE_PER_MIN * order.duration;
+        order.extra_fee = ELDERLY_SERVICE_EXTRA_FEE * static_cast<int64_t>(order.need_elderly_service);
         // 优惠逻辑（如老年优惠、优惠券等，可扩展）
         order.discount_fee = CalculateDiscount(order);
-        order.total_fee = round((order.base_fee + order.distance_fee + order.time_fee + order.extra_fee - order.discount_fee) * 100) / 100;
+        order.total_fee = order.base_fee + order.distance_fee + order.time_fee + order.extra_fee - order.discount_fee;
     }
 
     /**
      * 计算优惠金额（示例：老年人固定优惠3元）
      */
-    double CalculateDiscount(const TaxiOrder& order) {
+    Money CalculateDiscount(const TaxiOrder& order) {
         // 假设老年人用户享受固定优惠，可通过用户中心接口查询用户类型
         bool is_elderly = user_dao_->IsElderlyUser(order.user_id);
-        return is_elderly ? 3.0 : 0.0;
+        return ELDERLY_DISCOUNT * static_cast<int64_t>(is_elderly);
     }
 
     /**
      * 通用订单状态更新函数（减少重复代码）
+     * 通过状态机一次条件更新完成：状态比较并交换 + 仅写入 patch 中的变化列
+     * 只有更新未命中时才回查订单，用于给出准确的失败原因
      */
     bool UpdateOrderStatus(
         const std::string& order_id,
@@ -309,23 +478,19 @@ private:
         TaxiOrder::OrderStatus expect_status,
         TaxiOrder::OrderStatus target_status,
         const std::string& operation_name,
-        std::function<void(TaxiOrder&)> update_func) {
-        TaxiOrder order = taxi_dao_->QueryTaxiOrderById(order_id);
-        if (order.order_id.empty()) {
-            throw std::runtime_error("订单不存在");
+        const TaxiOrderPatch& patch = TaxiOrderPatch()) {
+        TaxiTransitionResult result = state_machine_.Transition(order_id, expect_status, target_status, patch);
+        if (result == TaxiTransitionResult::ILLEGAL) {
+            throw std::runtime_error(fmt::format("订单状态{}不允许{}", OrderStatusToString(expect_status), operation_name));
         }
-        if (order.status != expect_status) {
+        if (result == TaxiTransitionResult::CONFLICT) {
+            TaxiOrder order = taxi_dao_->QueryTaxiOrderById(order_id);
+            if (order.order_id.empty()) {
+                throw std::runtime_error("订单不存在");
+            }
             throw std::runtime_error(fmt::format("订单当前状态{}，无法{}", OrderStatusToString(order.status), operation_name));
         }
 
-        // 执行自定义更新逻辑
-        update_func(order);
-
-        bool update_ok = taxi_dao_->UpdateTaxiOrder(order);
-        if (!update_ok) {
-            throw std::runtime_error(fmt::format("{}失败，请重试", operation_name));
-        }
-
         SPDLOG_INFO("订单{}成功，order_id={}, operator_id={}", operation_name, order_id, operator_id);
         return true;
     }
@@ -366,6 +531,22 @@ private:
     IUserDao* user_dao_;    // 用户模块DAO抽象接口
     ITimeUtil* time_util_; 
   // 时间工具抽象接口
+    TaxiDispatcher* dispatcher_; // 派单引擎（可为空）
+    TaxiOrderStateMachine state_machine_; // 订单状态机（条件更新 + 转换统计）
+    TripEstimator trip_estimator_;        // 行程距离/时长预估（按网格对增量学习）
+    DriverPositionIngestor position_ingestor_; // 司机GPS批量接入（首次上报时启动）
+
+    struct UserDestHash {
+        size_t operator()(const std::pair<std::string, std::string>& key) const {
+            return std::hash<std::string>{}(key.first) * 31 + std::hash<std::string>{}(key.second);
+        }
+    };
+    using AddrUseBuffer = WriteBehindBuffer<std::string>;
+    using DestUseBuffer = WriteBehindBuffer<std::pair<std::string, std::string>, UserDestHash>;
+    CommonAddressCache address_cache_;   // 用户常用地址缓存（已排序列表）
+    // 最近使用时间写回缓冲（DAO 批量条件更新：仅当新值更大时写入 last_use_time/update_time）
+    AddrUseBuffer addr_use_buffer_;       // addr_id → 最近使用时间
+    DestUseBuffer dest_use_buffer_;       // (user_id, dest_id) → 最近使用时间
 };
 
 // ====================== 数据传输对象（DTO）和输入参数结构体 ======================
@@ -407,12 +588,12 @@ struct TaxiOrderDTO {
     bool is_reserve_order;              // 是否预约单
     std::string start_time;             // 出发时间
     std::string status;                 // 订单状态（字符串形式）
-    double base_fee;                    // 起步价
-    double distance_fee;                // 里程费
-    double time_fee;                    // 时长费
-    double extra_fee;                   // 附加费
-    double discount_fee;                // 优惠金额
-    double total_fee;                   // 总费用
+    Money base_fee;                     // 起步价
+    Money distance_fee;                 // 里程费
+    Money time_fee;                     // 时长费
+    Money extra_fee;                    // 附加费
+    Money discount_fee;                 // 优惠金额
+    Money total_fee;                    // 总费用
     std::string pay_status;             // 支付状态
     std::string create_time;            // 创建时间（yyyy-MM-dd HH:mm:ss）
 };
@@ -0,0 +1,502 @@
+#ifndef TAXI_DISPATCHER_H
+#define TAXI_DISPATCHER_H
+
+#include "dao/taxi_dao.h"
+#include "model/taxi_order.h"
+#include "model/taxi_driver.h"
+#include "service/driver_location_index.h"
+#include "service/batch_matcher.h"
+#include "service/taxi_order_state_machine.h"
+#include "util/time_util.h"
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+constexpr double MAX_DISPATCH_DISTANCE = 5.0; // 司机匹配最大距离（5km，可配置）
+constexpr int DRIVER_UPDATE_MAX_ATTEMPTS = 3;  // 派单后写入司机“服务中”状态的最大尝试次数
+
+/**
+ * 派单参数
+ */
+struct TaxiDispatchOptions {
+    enum class Mode {
+        GREEDY = 0, // 逐单派单：下单即匹配最近空闲司机
+        BATCH = 1   // 批量派单：按时间窗口收集订单，整体求解最小总接驾距离
+    };
+    // 模拟结果（taxi_dispatch_sim_bench）：运力充足时两种模式接驾距离相近，批量模式多等约半个窗口；
+    // 运力不足时批量模式平均接驾距离约为逐单的 40%，流失率明显更低
+    Mode mode = Mode::GREEDY;
+    double max_dispatch_distance = MAX_DISPATCH_DISTANCE; // 司机匹配最大距离（km）
+    size_t max_candidates = 10;                           // 每单最多考虑的候选司机数
+    int batch_window_ms = 2000;                           // 批量模式收集窗口（毫秒）
+    BatchMatcher::Algorithm batch_algorithm = BatchMatcher::Algorithm::HUNGARIAN; // 批量模式求解算法（默认匈牙利算法，见 BatchMatcher 说明）
+};
+
+/**
+ * 派单统计（用于对比逐单/批量两种模式的效果）
+ */
+struct TaxiDispatchStats {
+    uint64_t matched_orders = 0;         // 成功派单数
+    double total_pickup_distance = 0.0;  // 累计接驾距离（km）
+    double total_match_latency_ms = 0.0; // 累计匹配耗时（毫秒，批量模式含排队等待）
+
+    double AvgPickupDistance() const {
+        return matched_orders == 0 ? 0.0 : total_pickup_distance / matched_orders;
+    }
+    double AvgMatchLatencyMs() const {
+        return matched_orders == 0 ? 0.0 : total_match_latency_ms / matched_orders;
+    }
+};
+
+/**
+ * 派单引擎：基于司机位置索引，为待派单订单匹配上车点附近的空闲司机
+ * 司机位置由司机端上报写入索引；派单时先从索引“抢占”司机，再落库，失败则归还
+ * - 逐单模式：Dispatch 同步匹配最近司机
+ * - 批量模式：Dispatch 只入队，后台线程每个窗口调用 RunBatchTick 统一求解
+ */
+class TaxiDispatcher {
+public:
+    TaxiDispatcher(ITaxiDao* taxi_dao, ITimeUtil* time_util, TaxiDispatchOptions options = TaxiDispatchOptions())
+        : taxi_dao_(taxi_dao), time_util_(time_util), options_(options), state_machine_(taxi_dao) {}
+
+    ~TaxiDispatcher() { Stop(); }
+
+    TaxiDispatcher(const TaxiDispatcher&) = delete;
+    TaxiDispatcher& operator=(const TaxiDispatcher&) = delete;
+
+    /**
+     * 启动批量派单后台线程（逐单模式下无需调用）
+     */
+    void Start() {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        if (options_.mode != TaxiDispatchOptions::Mode::BATCH || running_) {
+            return;
+        }
+        running_ = true;
+        worker_ = std::thread([this] { BatchLoop(); });
+    }
+
+    /**
+     * 停止后台线程（未派出的订单保留在队列中）
+     */
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        stop_cv_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    /**
+     * 司机上报位置（仅空闲司机会进入索引）
+     * 已在索引中的司机直接移动；其余司机按内存中的接单状态判断，服务中/离线司机的上报被忽略
+     * 接单状态由派单、送达、上线/下线维护，只有首次见到的司机才查库（查库失败时忽略本次上报，下次重试）
+     */
+    void UpdateDriverLocation(const std::string& driver_id, const TaxiLocation& location) {
+        if (index_.MoveIfPresent(driver_id, location.latitude, location.longitude)) {
+            return;
+        }
+        // 与 AssignDriver 互斥：派单写入“服务中”之前读到的旧“空闲”状态不会把司机加回索引
+        DriverShard& shard = DriverShardOf(driver_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.status.find(driver_id);
+        if (it == shard.status.end()) {
+            TaxiDriver driver;
+            try {
+                driver = taxi_dao_->QueryDriverById(driver_id);
+            } catch (const std::exception& e) {
+                SPDLOG_WARN("查询司机失败，忽略本次位置上报，driver_id={}, error={}", driver_id, e.what());
+                return;
+            }
+            if (driver.driver_id.empty()) {
+                return; // 未注册的司机不缓存，避免无效ID占用内存
+            }
+            it = shard.status.emplace(driver_id, driver.status).first;
+        }
+        if (it->second == TaxiDriver::DriverStatus::AVAILABLE) {
+            index_.UpdatePosition(driver_id, location.latitude, location.longitude);
+        }
+    }
+
+    /**
+     * 司机恢复空闲（上线出车、送达后由调用方在司机状态落库成功后调用），进入索引
+     */
+    void SetDriverAvailable(const std::string& driver_id, const TaxiLocation& location) {
+        DriverShard& shard = DriverShardOf(driver_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.status[driver_id] = TaxiDriver::DriverStatus::AVAILABLE;
+        index_.UpdatePosition(driver_id, location.latitude, location.longitude);
+    }
+
+    /**
+     * 司机下线/暂停接单（移出索引）
+     */
+    void SetDriverOffline(const std::string& driver_id) {
+        DriverShard& shard = DriverShardOf(driver_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.status[driver_id] = TaxiDriver::DriverStatus::OFFLINE;
+        index_.Remove(driver_id);
+    }
+
+    /**
+     * 丢弃司机的内存状态（司机状态落库结果不确定时调用），下一次上报重新查库
+     */
+    void ForgetDriver(const std::string& driver_id) {
+        DriverShard& shard = DriverShardOf(driver_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.status.erase(driver_id);
+        index_.Remove(driver_id);
+    }
+
+    /**
+     * 为订单派单
+     * @return true=已派单（订单填充司机信息并置为已派单）；
+     *         false=附近暂无司机，或批量模式下已入队等待下一个窗口（订单保持待派单）
+     */
+    bool Dispatch(TaxiOrder& order) {
+        if (order.status != TaxiOrder::OrderStatus::PENDING_DISPATCH) {
+            return false;
+        }
+        if (options_.mode == TaxiDispatchOptions::Mode::BATCH) {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_.push_back(PendingOrder{order, std::chrono::steady_clock::now()});
+            return false;
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        auto candidates = index_.QueryWithinRadius(order.start_location.latitude,
+            order.start_location.longitude, options_.max_dispatch_distance, options_.max_candidates);
+        for (const auto& candidate : candidates) {
+            AssignResult result = AssignDriver(order, candidate, begin);
+            if (result == AssignResult::ASSIGNED) {
+                return true;
+            }
+            if (result == AssignResult::ORDER_CLOSED || result == AssignResult::RETRY_LATER) {
+                return false; // 订单已关闭，或数据库暂时不可用（订单保持待派单）
+            }
+        }
+
+        SPDLOG_INFO("附近{}km内暂无可派司机，order_id={}", options_.max_dispatch_distance, order.order_id);
+        return false;
+    }
+
+    /**
+     * 从批量队列中撤回订单（用户取消/订单过期时调用）
+     */
+    void CancelPending(const std::string& order_id) {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        for (size_t i = 0; i < pending_.size(); ++i) {
+            if (pending_[i].order.order_id == order_id) {
+                pending_.erase(pending_.begin() + i);
+                return;
+            }
+        }
+    }
+
+    /**
+     * 执行一轮批量匹配：取出当前队列，按订单×候选司机的接驾距离求解最优指派
+     * 本轮未匹配或抢占失败的订单放回队列，等待下一个窗口
+     * @return 本轮成功派单数
+     */
+    size_t RunBatchTick() {
+        std::vector<PendingOrder> batch;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            batch.swap(pending_);
+        }
+        if (batch.empty()) {
+            return 0;
+        }
+
+        // 1. 汇总每单的候选司机（同一司机只占一列），得到 订单×司机 的稀疏候选边
+        //    不构造整体稠密矩阵：1000 单 × 上万司机时矩阵达千万格，按连通分量拆分后各自求解
+        std::vector<DriverLocationIndex::Candidate> drivers;
+        std::unordered_map<std::string, size_t> driver_column;
+        BatchMatcher::Edges edges(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const TaxiLocation& pickup = batch[i].order.start_location;
+            for (auto& candidate : index_.QueryWithinRadius(pickup.latitude, pickup.longitude,
+                                                            options_.max_dispatch_distance, options_.max_candidates)) {
+                auto it = driver_column.find(candidate.driver_id);
+                if (it == driver_column.end()) {
+                    it = driver_column.emplace(candidate.driver_id, drivers.size()).first;
+                    drivers.push_back(candidate);
+                }
+                edges[i].emplace_back(it->second, candidate.distance);
+            }
+        }
+
+        std::vector<int> assignment = BatchMatcher::SolveSparse(drivers.size(), edges, options_.batch_algorithm);
+
+        // 2. 按求解结果逐单抢占司机并落库
+        size_t matched = 0;
+        std::vector<PendingOrder> retry;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            int j = assignment[i];
+            if (j >= 0) {
+                DriverLocationIndex::Candidate candidate = drivers[j];
+                for (const auto& edge : edges[i]) {
+                    if (edge.first == static_cast<size_t>(j)) candidate.distance = edge.second;
+                }
+                AssignResult result = AssignDriver(batch[i].order, candidate, batch[i].enqueue_time);
+                if (result == AssignResult::ASSIGNED) {
+                    ++matched;
+                    continue;
+                }
+                if (result == AssignResult::ORDER_CLOSED) {
+                    continue; // 订单已取消/过期，不再重试
+                }
+                // 司机被抢占或数据库暂时不可用：留到下一个窗口
+            }
+            retry.push_back(std::move(batch[i]));
+        }
+        if (!retry.empty()) {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_.insert(pending_.end(), std::make_move_iterator(retry.begin()), std::make_move_iterator(retry.end()));
+        }
+
+        SPDLOG_INFO("批量派单完成，batch_size={}, matched={}, drivers={}", batch.size(), matched, drivers.size());
+        return matched;
+    }
+
+    /**
+     * 派单索引（供GPS接入管道批量更新司机位置）
+     */
+    DriverLocationIndex& LocationIndex() { return index_; }
+
+    /**
+     * 当前可派司机数
+     */
+    size_t AvailableDriverCount() const { return index_.Size(); }
+
+    /**
+     * 批量队列中等待派单的订单数
+     */
+    size_t PendingOrderCount() const {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        return pending_.size();
+    }
+
+    /**
+     * 获取派单统计（平均接驾距离、平均匹配耗时）
+     */
+    TaxiDispatchStats GetStats() const {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return stats_;
+    }
+
+private:
+    struct PendingOrder {
+        TaxiOrder order;
+        std::chrono::steady_clock::time_point enqueue_time; // 入队时间（统计匹配耗时）
+    };
+
+    enum class AssignResult {
+        ASSIGNED = 0,           // 派单成功
+        DRIVER_UNAVAILABLE = 1, // 司机已被抢占或不可接单，可尝试下一位
+        ORDER_CLOSED = 2,       // 订单已不在待派单状态，停止派单
+        RETRY_LATER = 3         // 数据库异常等暂时性失败，订单保持待派单，稍后重试
+    };
+
+    /**
+     * 抢占候选司机并落库（并发派单时只有一个订单能成功移除该司机）
+     */
+    AssignResult AssignDriver(TaxiOrder& order, const DriverLocationIndex::Candidate& candidate,
+                      std::chrono::steady_clock::time_point begin) {
+        if (!index_.Remove(candidate.driver_id)) {
+            return AssignResult::DRIVER_UNAVAILABLE;
+        }
+        DriverShard& shard = DriverShardOf(candidate.driver_id);
+        std::lock_guard<std::mutex> driver_lock(shard.mutex);
+        TaxiDriver driver;
+        try {
+            driver = taxi_dao_->QueryDriverById(candidate.driver_id);
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("查询司机失败，driver_id={}, error={}", candidate.driver_id, e.what());
+            index_.UpdatePosition(candidate.driver_id, candidate.latitude, candidate.longitude);
+            return AssignResult::RETRY_LATER;
+        }
+        if (driver.driver_id.empty() || driver.status != TaxiDriver::DriverStatus::AVAILABLE) {
+            if (driver.driver_id.empty()) {
+                shard.status.erase(candidate.driver_id);
+            } else {
+                shard.status[candidate.driver_id] = driver.status;
+            }
+            return AssignResult::DRIVER_UNAVAILABLE; // 索引信息过期，司机已不可接单
+        }
+
+        // 条件更新：订单仍为“待派单”才写入司机信息（用户已取消/已过期时不会覆盖）
+        int64_t now = time_util_->GetCurrentTimestamp();
+        TaxiOrderPatch patch;
+        patch.Set("driver_id", driver.driver_id)
+             .Set("driver_name", driver.driver_name)
+             .Set("license_plate", driver.license_plate)
+             .Set("driver_phone", driver.driver_phone)
+             .Set("dispatch_time", now)
+             .Set("update_time", now);
+        TaxiTransitionResult result = TryTransition(order.order_id,
+            TaxiOrder::OrderStatus::PENDING_DISPATCH, TaxiOrder::OrderStatus::DISPATCHED, patch);
+        if (result != TaxiTransitionResult::OK) {
+            index_.UpdatePosition(candidate.driver_id, candidate.latitude, candidate.longitude);
+            // 条件更新未命中不一定是订单已关闭（也可能是数据库异常），以订单当前状态为准
+            if (IsOrderPending(order.order_id)) {
+                SPDLOG_WARN("派单写入失败，订单仍待派单，稍后重试，order_id={}", order.order_id);
+                return AssignResult::RETRY_LATER;
+            }
+            SPDLOG_INFO("订单已不在待派单状态，放弃派单，order_id={}", order.order_id);
+            return AssignResult::ORDER_CLOSED;
+        }
+        order.driver_id = driver.driver_id;
+        order.driver_name = driver.driver_name;
+        order.license_plate = driver.license_plate;
+        order.driver_phone = driver.driver_phone;
+        order.status = TaxiOrder::OrderStatus::DISPATCHED;
+        order.dispatch_time = now;
+
+        driver.status = TaxiDriver::DriverStatus::BUSY;
+        driver.update_time = now;
+        shard.status[driver.driver_id] = TaxiDriver::DriverStatus::BUSY;
+        if (!SaveDriver(driver)) {
+            // 补偿：司机仍是“空闲”，订单退回待派单并归还司机，避免订单挂在一个可被再次派单的司机上
+            TaxiOrderPatch rollback;
+            rollback.Set("driver_id", std::string())
+                    .Set("driver_name", std::string())
+                    .Set("license_plate", std::string())
+                    .Set("driver_phone", std::string())
+                    .Set("dispatch_time", static_cast<int64_t>(0))
+                    .Set("update_time", now);
+            if (TryTransition(order.order_id, TaxiOrder::OrderStatus::DISPATCHED,
+                              TaxiOrder::OrderStatus::PENDING_DISPATCH, rollback) == TaxiTransitionResult::OK) {
+                order.driver_id.clear();
+                order.driver_name.clear();
+                order.license_plate.clear();
+                order.driver_phone.clear();
+                order.status = TaxiOrder::OrderStatus::PENDING_DISPATCH;
+                order.dispatch_time = 0;
+                shard.status[driver.driver_id] = TaxiDriver::DriverStatus::AVAILABLE;
+                index_.UpdatePosition(candidate.driver_id, candidate.latitude, candidate.longitude);
+                SPDLOG_ERROR("司机状态更新失败，订单已退回待派单，order_id={}, driver_id={}",
+                    order.order_id, driver.driver_id);
+                return AssignResult::RETRY_LATER;
+            }
+            // 订单已被司机/用户推进（接单、取消等），保留派单结果，司机状态需对账修复
+            SPDLOG_ERROR("司机状态更新失败且订单无法退回，需对账修复，order_id={}, driver_id={}",
+                order.order_id, driver.driver_id);
+        }
+
+        double latency_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.matched_orders++;
+            stats_.total_pickup_distance += candidate.distance;
+            stats_.total_match_latency_ms += latency_ms;
+        }
+        SPDLOG_INFO("派单成功，order_id={}, driver_id={}, pickup_distance={:.2f}km",
+            order.order_id, driver.driver_id, candidate.distance);
+        return AssignResult::ASSIGNED;
+    }
+
+    /**
+     * 执行状态转换（数据库异常按冲突处理，由调用方查库确认订单状态）
+     */
+    TaxiTransitionResult TryTransition(const std::string& order_id, TaxiOrder::OrderStatus from,
+                                       TaxiOrder::OrderStatus to, const TaxiOrderPatch& patch) {
+        try {
+            return state_machine_.Transition(order_id, from, to, patch);
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("订单状态更新异常，order_id={}, error={}", order_id, e.what());
+            return TaxiTransitionResult::CONFLICT;
+        }
+    }
+
+    /**
+     * 订单是否仍为待派单（查询失败时按仍待派单处理，交给后续重试/过期）
+     */
+    bool IsOrderPending(const std::string& order_id) {
+        try {
+            TaxiOrder current = taxi_dao_->QueryTaxiOrderById(order_id);
+            return current.status == TaxiOrder::OrderStatus::PENDING_DISPATCH;
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("查询订单失败，order_id={}, error={}", order_id, e.what());
+            return true;
+        }
+    }
+
+    /**
+     * 写入司机状态（失败或异常时重试，共 DRIVER_UPDATE_MAX_ATTEMPTS 次）
+     */
+    bool SaveDriver(const TaxiDriver& driver) {
+        for (int attempt = 1; attempt <= DRIVER_UPDATE_MAX_ATTEMPTS; ++attempt) {
+            try {
+                if (taxi_dao_->UpdateDriver(driver)) {
+                    return true;
+                }
+            } catch (const std::exception& e) {
+                SPDLOG_WARN("司机状态写入异常，driver_id={}, attempt={}, error={}", driver.driver_id, attempt, e.what());
+            }
+            if (attempt < DRIVER_UPDATE_MAX_ATTEMPTS) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10 * attempt));
+            }
+        }
+        return false;
+    }
+
+    /**
+     * 按司机分片：分片锁使派单落库与“按状态加入索引”互斥，status 为分片内司机的接单状态
+     */
+    struct DriverShard {
+        std::mutex mutex;
+        std::unordered_map<std::string, TaxiDriver::DriverStatus> status;
+    };
+
+    DriverShard& DriverShardOf(const std::string& driver_id) {
+        return driver_shards_[std::hash<std::string>{}(driver_id) % kDriverShardCount];
+    }
+
+    /**
+     * 批量模式后台线程：每个窗口执行一轮匹配
+     */
+    void BatchLoop() {
+        std::unique_lock<std::mutex> lock(pending_mutex_);
+        while (running_) {
+            stop_cv_.wait_for(lock, std::chrono::milliseconds(options_.batch_window_ms), [this] { return !running_; });
+            if (!running_) break;
+            lock.unlock();
+            try {
+                RunBatchTick();
+            } catch (const std::exception& e) {
+                SPDLOG_ERROR("批量派单异常: {}", e.what());
+            }
+            lock.lock();
+        }
+    }
+
+    ITaxiDao* taxi_dao_;          // 打车模块DAO抽象接口
+    ITimeUtil* time_util_;        // 时间工具抽象接口
+    TaxiDispatchOptions options_; // 派单参数
+    DriverLocationIndex index_;   // 空闲司机位置索引
+    TaxiOrderStateMachine state_machine_; // 订单状态机（派单使用条件更新）
+
+    static constexpr size_t kDriverShardCount = 64;
+    DriverShard driver_shards_[kDriverShardCount]; // 司机接单状态（首次见到时查库，之后随状态转换更新）
+
+    mutable std::mutex pending_mutex_;  // 保护批量队列与后台线程状态
+    std::vector<PendingOrder> pending_; // 批量模式待派订单
+    std::condition_variable stop_cv_;
+    bool running_ = false;
+    std::thread worker_;
+
+    mutable std::mutex stats_mutex_;    // 保护派单统计
+    TaxiDispatchStats stats_;
+};
+
+#endif // TAXI_DISPATCHER_H
@@ -0,0 +1,197 @@
+#ifndef TAXI_ORDER_STATE_MACHINE_H
+#define TAXI_ORDER_STATE_MACHINE_H
+
+#include "dao/taxi_dao.h"
+#include "model/taxi_order.h"
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <fmt/core.h>
+#include <inttypes.h>
+
+/**
+ * 订单局部更新：只包含本次状态转换需要修改的列（列名与 TAXI_ORDER 表一致）
+ * DAO 据此拼接 UPDATE TAXI_ORDER SET status=?, <列>=? ... WHERE order_id=? AND status=?
+ */
+struct TaxiOrderPatch {
+    std::vector<std::pair<std::string, std::string>> columns; // 列名 → 值（已格式化）
+
+    TaxiOrderPatch& Set(const std::string& column, const std::string& value) {
+        columns.emplace_back(column, value);
+        return *this;
+    }
+    TaxiOrderPatch& Set(const std::string& column, int64_t value) {
+        columns.emplace_back(column, std::to_string(value));
+        return *this;
+    }
+    TaxiOrderPatch& Set(const std::string& column, double value) {
+        columns.emplace_back(column, fmt::format("{:.2f}", value));
+        return *this;
+    }
+    TaxiOrderPatch& Set(const std::string& column, Money value) {
+        columns.emplace_back(column, value.ToString()); // DECIMAL(10,2) 精确写入
+        return *this;
+    }
+};
+
+/**
+ * 状态转换结果
+ */
+enum class TaxiTransitionResult {
+    OK = 0,        // 转换成功
+    ILLEGAL = 1,   // 转换不在合法转换表中
+    CONFLICT = 2   // 条件更新未命中（订单不存在或状态已被并发修改）
+};
+
+/**
+ * 单个转换的统计
+ */
+struct TaxiTransitionStats {
+    TaxiOrder::OrderStatus from;
+    TaxiOrder::OrderStatus to;
+    std::string name;
+    uint64_t attempts = 0;         // 尝试次数
+    uint64_t successes = 0;        // 成功次数
+    uint64_t conflicts = 0;        // 并发冲突次数
+    uint64_t total_latency_us = 0; // 累计耗时（微秒）
+};
+
+/**
+ * 打车订单状态机：合法转换以表格声明，每次转换通过 DAO 的条件更新一次完成
+ * （状态比较并交换 + 仅写入变化列），不再“先查询、再整行写回”，
+ * 司机接单与用户取消等并发操作中只有一方能成功，另一方得到 CONFLICT
+ *
+ * DAO 约定：ITaxiDao::CompareAndSetTaxiOrderStatus(order_id, expect, target, patch)
+ * 在一条 UPDATE 语句中完成，影响行数为1时返回 true
+ */
+class TaxiOrderStateMachine {
+public:
+    explicit TaxiOrderStateMachine(ITaxiDao* taxi_dao) : taxi_dao_(taxi_dao) {}
+
+    /**
+     * 判断状态转换是否合法
+     */
+    static bool IsLegal(TaxiOrder::OrderStatus from, TaxiOrder::OrderStatus to) {
+        return FindTransition(from, to) >= 0;
+    }
+
+    /**
+     * 执行状态转换（单次条件更新）
+     */
+    TaxiTransitionResult Transition(const std::string& order_id,
+                                    TaxiOrder::OrderStatus from,
+                                    TaxiOrder::OrderStatus to,
+                                    const TaxiOrderPatch& patch = TaxiOrderPatch()) {
+        int idx = FindTransition(from, to);
+        if (idx < 0) {
+            SPDLOG_WARN("非法订单状态转换，order_id={}, {} -> {}", order_id,
+                OrderStatusToString(from), OrderStatusToString(to));
+            return TaxiTransitionResult::ILLEGAL;
+        }
+
+        Counters& counters = counters_[idx];
+        counters.attempts.fetch_add(1, std::memory_order_relaxed);
+        auto begin = std::chrono::steady_clock::now();
+        bool updated = taxi_dao_->CompareAndSetTaxiOrderStatus(order_id, from, to, patch);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        counters.total_latency_us.fetch_add(static_cast<uint64_t>(elapsed), std::memory_order_relaxed);
+
+        if (!updated) {
+            counters.conflicts.fetch_add(1, std::memory_order_relaxed);
+            return TaxiTransitionResult::CONFLICT;
+        }
+        counters.successes.fetch_add(1, std::memory_order_relaxed);
+        return TaxiTransitionResult::OK;
+    }
+
+    /**
+     * 批量执行同一种状态转换（一条 UPDATE ... WHERE order_id IN (...) AND status=?）
+     * DAO 约定：ITaxiDao::BatchCompareAndSetTaxiOrderStatus 返回实际更新的行数
+     * @return 成功转换的订单数（其余计为冲突）
+     */
+    size_t TransitionBatch(const std::vector<std::string>& order_ids,
+                           TaxiOrder::OrderStatus from,
+                           TaxiOrder::OrderStatus to,
+                           const TaxiOrderPatch& patch = TaxiOrderPatch()) {
+        int idx = FindTransition(from, to);
+        if (idx < 0 || order_ids.empty()) {
+            return 0;
+        }
+        Counters& counters = counters_[idx];
+        counters.attempts.fetch_add(order_ids.size(), std::memory_order_relaxed);
+        auto begin = std::chrono::steady_clock::now();
+        size_t updated = taxi_dao_->BatchCompareAndSetTaxiOrderStatus(order_ids, from, to, patch);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        counters.total_latency_us.fetch_add(static_cast<uint64_t>(elapsed), std::memory_order_relaxed);
+        counters.successes.fetch_add(updated, std::memory_order_relaxed);
+        counters.conflicts.fetch_add(order_ids.size() - updated, std::memory_order_relaxed);
+        return updated;
+    }
+
+    /**
+     * 获取各转换的统计（按转换表顺序）
+     */
+    std::vector<TaxiTransitionStats> GetStats() const {
+        std::vector<TaxiTransitionStats> result;
+        for (size_t i = 0; i < kTransitionCount; ++i) {
+            TaxiTransitionStats stats;
+            stats.from = kTransitions[i].from;
+            stats.to = kTransitions[i].to;
+            stats.name = kTransitions[i].name;
+            stats.attempts = counters_[i].attempts.load(std::memory_order_relaxed);
+            stats.successes = counters_[i].successes.load(std::memory_order_relaxed);
+            stats.conflicts = counters_[i].conflicts.load(std::memory_order_relaxed);
+            stats.total_latency_us = counters_[i].total_latency_us.load(std::memory_order_relaxed);
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+private:
+    struct TransitionDef {
+        TaxiOrder::OrderStatus from;
+        TaxiOrder::OrderStatus to;
+        const char* name;
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> attempts{0};
+        std::atomic<uint64_t> successes{0};
+        std::atomic<uint64_t> conflicts{0};
+        std::atomic<uint64_t> total_latency_us{0};
+    };
+
+    using S = TaxiOrder::OrderStatus;
+    // 合法状态转换表
+    static constexpr TransitionDef kTransitions[] = {
+        {S::PENDING_DISPATCH, S::DISPATCHED,      "派单"},
+        {S::PENDING_DISPATCH, S::CANCELED,        "取消订单"},
+        {S::PENDING_DISPATCH, S::EXPIRED,         "订单过期"},
+        {S::PENDING_DISPATCH, S::FAILED,          "派单失败"},
+        {S::DISPATCHED,       S::DRIVER_ACCEPTED, "司机接单"},
+        {S::DISPATCHED,       S::PENDING_DISPATCH,"司机拒单改派"},
+        {S::DISPATCHED,       S::CANCELED,        "取消订单"},
+        {S::DRIVER_ACCEPTED,  S::PICKED_UP,       "确认接驾"},
+        {S::DRIVER_ACCEPTED,  S::CANCELED,        "取消订单"},
+        {S::PICKED_UP,        S::COMPLETED,       "确认送达"},
+    };
+    static constexpr size_t kTransitionCount = sizeof(kTransitions) / sizeof(kTransitions[0]);
+
+    static int FindTransition(TaxiOrder::OrderStatus from, TaxiOrder::OrderStatus to) {
+        for (size_t i = 0; i < kTransitionCount; ++i) {
+            if (kTransitions[i].from == from && kTransitions[i].to == to) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    ITaxiDao* taxi_dao_;                    // 打车模块DAO抽象接口
+    Counters counters_[kTransitionCount];   // 与转换表一一对应的统计
+};
+
+#endif // TAXI_ORDER_STATE_MACHINE_H
@@ -0,0 +1,195 @@
+#ifndef TRIP_ESTIMATOR_H
+#define TRIP_ESTIMATOR_H
+
+#include "util/geo_util.h"
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * 行程预估结果
+ */
+struct TripEstimate {
+    double distance_km = 0.0;   // 预估行驶距离（km）
+    double duration_min = 0.0;  // 预估行驶时长（分钟）
+    uint32_t samples = 0;       // 起终点网格对已学习的样本数（0 表示仅使用全局系数）
+};
+
+/**
+ * 行程距离/时长预估器：按“起点网格 → 终点网格”学习绕行系数（实际里程 / 直线距离）
+ * 与每公里耗时，用已完成订单增量更新（指数滑动平均）
+ * - 报价时一次哈希查找，不访问数据库
+ * - 网格对表为固定容量的组相联表（每组4路），满时淘汰组内样本最少的一项，内存上限固定
+ * - 样本不足时与全局系数按样本数加权，避免个别订单导致报价大幅波动
+ */
+class TripEstimator {
+public:
+    /**
+     * @param cell_deg 网格边长（度），默认约2km
+     * @param max_pairs 最多保存的网格对数量（向上取整为4的倍数的2的幂）
+     */
+    explicit TripEstimator(double cell_deg = 0.02, size_t max_pairs = 1 << 18)
+        : cell_deg_(cell_deg) {
+        size_t sets = 1;
+        while (sets * kWays < max_pairs) sets <<= 1;
+        set_mask_ = sets - 1;
+        entries_.resize(sets * kWays);
+    }
+
+    TripEstimator(const TripEstimator&) = delete;
+    TripEstimator& operator=(const TripEstimator&) = delete;
+
+    /**
+     * 预估行程距离与时长
+     */
+    TripEstimate Estimate(double start_lat, double start_lon, double end_lat, double end_lon) const {
+        double straight = GeoUtil::HaversineKm(start_lat, start_lon, end_lat, end_lon);
+        double global_ratio = global_ratio_.load(std::memory_order_relaxed);
+        double global_min_per_km = global_min_per_km_.load(std::memory_order_relaxed);
+
+        double ratio = global_ratio;
+        double min_per_km = global_min_per_km;
+        uint32_t samples = 0;
+        uint64_t key = PairKey(start_lat, start_lon, end_lat, end_lon);
+        size_t set = key & set_mask_;
+        {
+            std::lock_guard<std::mutex> lock(locks_[set % kLockCount]);
+            const Entry* entry = Find(set, key);
+            if (entry != nullptr) {
+                samples = entry->samples;
+                double weight = static_cast<double>(samples) / (samples + kPriorSamples);
+                ratio = weight * entry->ratio + (1 - weight) * global_ratio;
+                min_per_km = weight * entry->min_per_km + (1 - weight) * global_min_per_km;
+            }
+        }
+
+        TripEstimate estimate;
+        estimate.distance_km = straight * ratio;
+        estimate.duration_min = std::max(1.0, estimate.distance_km * min_per_km);
+        estimate.samples = samples;
+        return estimate;
+    }
+
+    /**
+     * 用一笔已完成订单更新系数（异常样本直接丢弃）
+     * @param distance_km 实际行驶距离（km）
+     * @param duration_min 实际行驶时长（分钟）
+     */
+    void Learn(double start_lat, double start_lon, double end_lat, double end_lon,
+               double distance_km, double duration_min) {
+        double straight = GeoUtil::HaversineKm(start_lat, start_lon, end_lat, end_lon);
+        if (straight < kMinLearnKm || distance_km < kMinLearnKm || duration_min <= 0) {
+            return;
+        }
+        double ratio = distance_km / straight;
+        double min_per_km = duration_min / distance_km;
+        if (ratio < kMinRatio || ratio > kMaxRatio || min_per_km < kMinMinPerKm || min_per_km > kMaxMinPerKm) {
+            return;
+        }
+
+        uint64_t key = PairKey(start_lat, start_lon, end_lat, end_lon);
+        size_t set = key & set_mask_;
+        {
+            std::lock_guard<std::mutex> lock(locks_[set % kLockCount]);
+            Entry* entry = FindOrEvict(set, key);
+            entry->samples = std::min<uint32_t>(entry->samples + 1, kMaxSamples);
+            double alpha = std::max(1.0 / entry->samples, kMinAlpha);
+            entry->ratio += alpha * (ratio - entry->ratio);
+            entry->min_per_km += alpha * (min_per_km - entry->min_per_km);
+        }
+        {
+            std::lock_guard<std::mutex> lock(global_mutex_);
+            double global_ratio = global_ratio_.load(std::memory_order_relaxed);
+            double global_min_per_km = global_min_per_km_.load(std::memory_order_relaxed);
+            global_ratio_.store(global_ratio + kGlobalAlpha * (ratio - global_ratio), std::memory_order_relaxed);
+            global_min_per_km_.store(global_min_per_km + kGlobalAlpha * (min_per_km - global_min_per_km),
+                                     std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * 已保存的网格对数量
+     */
+    size_t PairCount() const {
+        size_t count = 0;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            std::lock_guard<std::mutex> lock(locks_[(i / kWays) % kLockCount]);
+            if (entries_[i].key != 0) ++count;
+        }
+        return count;
+    }
+
+private:
+    static constexpr size_t kWays = 4;              // 每组路数
+    static constexpr size_t kLockCount = 64;        // 锁分片数
+    static constexpr double kPriorSamples = 5.0;    // 与全局系数加权时的先验样本数
+    static constexpr double kMinAlpha = 0.05;       // 网格对滑动平均的最小权重（约最近20单）
+    static constexpr double kGlobalAlpha = 0.001;   // 全局系数滑动平均权重
+    static constexpr uint32_t kMaxSamples = 1000000;
+    static constexpr double kMinLearnKm = 0.3;      // 过短行程不参与学习
+    static constexpr double kMinRatio = 1.0;        // 绕行系数合理范围
+    static constexpr double kMaxRatio = 4.0;
+    static constexpr double kMinMinPerKm = 0.5;     // 每公里耗时合理范围（120km/h ~ 3km/h）
+    static constexpr double kMaxMinPerKm = 20.0;
+
+    struct Entry {
+        uint64_t key = 0;        // 0 表示空位
+        uint32_t samples = 0;
+        double ratio = 0.0;      // 绕行系数
+        double min_per_km = 0.0; // 每公里耗时（分钟）
+    };
+
+    static uint64_t Mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t CellKey(double latitude, double longitude) const {
+        uint32_t row = static_cast<uint32_t>(static_cast<int32_t>(std::floor(latitude / cell_deg_)));
+        uint32_t col = static_cast<uint32_t>(static_cast<int32_t>(std::floor(longitude / cell_deg_)));
+        return (static_cast<uint64_t>(row) << 32) | col;
+    }
+
+    uint64_t PairKey(double start_lat, double start_lon, double end_lat, double end_lon) const {
+        uint64_t key = Mix(CellKey(start_lat, start_lon) ^ Mix(CellKey(end_lat, end_lon)));
+        return key == 0 ? 1 : key;
+    }
+
+    const Entry* Find(size_t set, uint64_t key) const {
+        const Entry* base = &entries_[set * kWays];
+        for (size_t i = 0; i < kWays; ++i) {
+            if (base[i].key == key) return &base[i];
+        }
+        return nullptr;
+    }
+
+    Entry* FindOrEvict(size_t set, uint64_t key) {
+        Entry* base = &entries_[set * kWays];
+        Entry* victim = &base[0];
+        for (size_t i = 0; i < kWays; ++i) {
+            if (base[i].key == key) return &base[i];
+            if (base[i].samples < victim->samples) victim = &base[i];
+        }
+        victim->key = key;
+        victim->samples = 0;
+        victim->ratio = global_ratio_.load(std::memory_order_relaxed);
+        victim->min_per_km = global_min_per_km_.load(std::memory_order_relaxed);
+        return victim;
+    }
+
+    double cell_deg_;                              // 网格边长（度）
+    size_t set_mask_ = 0;                          // 组数 - 1
+    std::vector<Entry> entries_;                   // 组相联表（组数 × kWays）
+    mutable std::mutex locks_[kLockCount];         // 按组分片的锁
+
+    std::mutex global_mutex_;                      // 全局系数写锁（读不加锁）
+    std::atomic<double> global_ratio_{1.3};        // 全局绕行系数（冷启动默认值）
+    std::atomic<double> global_min_per_km_{2.4};   // 全局每公里耗时（冷启动约25km/h）
+};
+
+#endif // TRIP_ESTIMATOR_H
@@ -6,6 +6,7 @@
 #include "dao/user_dao.h"
 #include "dao/address_dao.h"
 #include "util/time_util.h"
+#include "util/id_generator.h"
 #include "util/crypto_util.h"
 #include "core/logger.h"
 #include <fmt/core.h>
@@ -395,10 +396,7 @@ private:
      * 生成地址ID
      */
     static std::string GenerateAddressId() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1000, 9999);
-        return fmt::format("ADDR{}{}", TimeUtil::GetCurrentTimestamp(), dis(gen));
+        return IdGenerator::GetInstance().NextString("ADDR");
     }
 };
 
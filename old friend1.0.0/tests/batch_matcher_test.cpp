@@ -0,0 +1,111 @@
+#include "service/batch_matcher.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// 随机稀疏实例：rows 个订单各连 degree 个候选司机（列号集中在 cluster 宽的窗口内，形成多个分量）
+BatchMatcher::Edges RandomEdges(std::mt19937& rng, size_t rows, size_t cols, size_t degree, size_t cluster) {
+    BatchMatcher::Edges edges(rows);
+    std::uniform_real_distribution<double> distance(0.1, 5.0);
+    for (size_t i = 0; i < rows; ++i) {
+        size_t base = (i * cols / rows) / cluster * cluster;
+        for (size_t k = 0; k < degree; ++k) {
+            size_t j = std::min(cols - 1, base + rng() % cluster);
+            bool duplicate = false;
+            for (const auto& edge : edges[i]) duplicate = duplicate || edge.first == j;
+            if (!duplicate) edges[i].emplace_back(j, distance(rng));
+        }
+    }
+    return edges;
+}
+
+std::vector<std::vector<double>> Dense(size_t cols, const BatchMatcher::Edges& edges) {
+    std::vector<std::vector<double>> cost(edges.size(), std::vector<double>(cols, BatchMatcher::kInfeasible));
+    for (size_t i = 0; i < edges.size(); ++i) {
+        for (const auto& edge : edges[i]) cost[i][edge.first] = edge.second;
+    }
+    return cost;
+}
+
+// 校验指派合法（每个司机最多一单、只走候选边），返回 (匹配数, 总距离)
+std::pair<size_t, double> Evaluate(size_t cols, const BatchMatcher::Edges& edges, const std::vector<int>& assignment) {
+    std::vector<int> used(cols, 0);
+    size_t matched = 0;
+    double total = 0.0;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (assignment[i] < 0) continue;
+        size_t j = static_cast<size_t>(assignment[i]);
+        EXPECT_EQ(used[j]++, 0) << "司机被重复指派，col=" << j;
+        bool found = false;
+        for (const auto& edge : edges[i]) {
+            if (edge.first == j) {
+                total += edge.second;
+                found = true;
+            }
+        }
+        EXPECT_TRUE(found) << "指派了非候选司机，row=" << i;
+        ++matched;
+    }
+    return {matched, total};
+}
+
+// 按分量拆分求解与整体稠密矩阵求解的匹配数、总距离一致
+TEST(BatchMatcherTest, SparseMatchesDenseOptimum) {
+    std::mt19937 rng(42);
+    for (int round = 0; round < 50; ++round) {
+        size_t rows = 5 + rng() % 60;
+        size_t cols = 5 + rng() % 120;
+        BatchMatcher::Edges edges = RandomEdges(rng, rows, cols, 1 + rng() % 6, 4 + rng() % 12);
+        auto dense = Evaluate(cols, edges, BatchMatcher::Solve(Dense(cols, edges), BatchMatcher::Algorithm::HUNGARIAN));
+        auto sparse = Evaluate(cols, edges, BatchMatcher::SolveSparse(cols, edges, BatchMatcher::Algorithm::HUNGARIAN));
+        EXPECT_EQ(sparse.first, dense.first) << "round=" << round;
+        EXPECT_NEAR(sparse.second, dense.second, 1e-9) << "round=" << round;
+    }
+}
+
+// 超出稠密格数上限的分量走最短增广路：订单都能匹配时总距离与匈牙利算法相同
+TEST(BatchMatcherTest, ShortestPathMatchesHungarianWhenAllOrdersFit) {
+    std::mt19937 rng(7);
+    for (int round = 0; round < 50; ++round) {
+        size_t rows = 5 + rng() % 40;
+        size_t cols = rows + rng() % 40;
+        // 每单都连到“自己的”司机，保证完全匹配存在
+        BatchMatcher::Edges edges = RandomEdges(rng, rows, cols, 1 + rng() % 6, cols);
+        for (size_t i = 0; i < rows; ++i) {
+            bool has_own = false;
+            for (const auto& edge : edges[i]) has_own = has_own || edge.first == i;
+            if (!has_own) edges[i].emplace_back(i, 4.0 + static_cast<double>(rng() % 100) / 100.0);
+        }
+        auto dense = Evaluate(cols, edges, BatchMatcher::Solve(Dense(cols, edges), BatchMatcher::Algorithm::HUNGARIAN));
+        auto sparse = Evaluate(cols, edges, BatchMatcher::SolveSparse(cols, edges, BatchMatcher::Algorithm::HUNGARIAN, 0));
+        EXPECT_EQ(sparse.first, rows) << "round=" << round;
+        EXPECT_EQ(dense.first, rows) << "round=" << round;
+        EXPECT_NEAR(sparse.second, dense.second, 1e-9) << "round=" << round;
+    }
+}
+
+// 司机不足时最短增广路保证先入队的订单优先，且不会为了后来的订单拆掉已有匹配
+TEST(BatchMatcherTest, ShortestPathKeepsEarlierOrdersWhenDriversAreShort) {
+    // 两单争一个司机：订单 0 先入队，即使订单 1 更近也由订单 0 得到司机
+    BatchMatcher::Edges edges = {{{0, 3.0}}, {{0, 1.0}}};
+    std::vector<int> assignment = BatchMatcher::SolveSparse(1, edges, BatchMatcher::Algorithm::HUNGARIAN, 0);
+    EXPECT_EQ(assignment[0], 0);
+    EXPECT_EQ(assignment[1], -1);
+
+    // 增广会为后来的订单调整已有指派：订单 0 让出司机 0 改派司机 1
+    edges = {{{0, 1.0}, {1, 2.0}}, {{0, 1.5}}};
+    assignment = BatchMatcher::SolveSparse(2, edges, BatchMatcher::Algorithm::HUNGARIAN, 0);
+    EXPECT_EQ(assignment[0], 1);
+    EXPECT_EQ(assignment[1], 0);
+}
+
+// 没有候选司机的订单、没有订单的司机都不影响求解
+TEST(BatchMatcherTest, HandlesIsolatedOrdersAndDrivers) {
+    BatchMatcher::Edges edges = {{}, {{3, 1.0}}, {}};
+    std::vector<int> assignment = BatchMatcher::SolveSparse(5, edges, BatchMatcher::Algorithm::AUCTION);
+    EXPECT_EQ(assignment, (std::vector<int>{-1, 3, -1}));
+    EXPECT_TRUE(BatchMatcher::SolveSparse(0, BatchMatcher::Edges(), BatchMatcher::Algorithm::HUNGARIAN).empty());
+}
+
+} // namespace
@@ -0,0 +1,102 @@
+#include "service/driver_position_ingestor.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+
+namespace {
+
+double Percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// 司机 i 在第 round 轮的位置：约 50km 见方的城区内均匀分布，每轮小幅移动
+DriverPositionUpdate PositionOf(size_t i, int64_t round) {
+    DriverPositionUpdate update;
+    update.driver_id = "D" + std::to_string(i);
+    update.latitude = 31.0 + static_cast<double>(i % 250) * 0.002 + static_cast<double>(round % 10) * 0.0001;
+    update.longitude = 121.2 + static_cast<double>(i / 250 % 250) * 0.002;
+    update.timestamp = round;
+    return update;
+}
+
+/**
+ * GPS 接入吞吐与并发派单查询延迟：drivers 个空闲司机在索引中，每轮每个司机上报一次；
+ * 同时 readers 个线程持续做 3km 半径、取最近 10 个的派单查询
+ * 输出：每秒应用的上报数、查询 p50/p99（us）、轮末仍在记录时间戳的司机数
+ */
+void BM_IngestWithReaders(benchmark::State& state) {
+    const size_t drivers = static_cast<size_t>(state.range(0));
+    const int readers = static_cast<int>(state.range(1));
+    DriverLocationIndex index;
+    for (size_t i = 0; i < drivers; ++i) {
+        DriverPositionUpdate update = PositionOf(i, 0);
+        index.UpdatePosition(update.driver_id, update.latitude, update.longitude);
+    }
+    DriverPositionIngestor ingestor(&index);
+    ingestor.Start();
+
+    // 每轮的上报预先构造，计时只包含入队与应用
+    const int64_t rounds = 8;
+    std::vector<std::vector<DriverPositionUpdate>> batches(rounds);
+    for (int64_t r = 0; r < rounds; ++r) {
+        batches[r].reserve(drivers);
+        for (size_t i = 0; i < drivers; ++i) batches[r].push_back(PositionOf(i, r + 1));
+    }
+
+    std::atomic<bool> stop{false};
+    std::vector<std::vector<double>> latencies(readers);
+    std::vector<std::thread> reader_threads;
+    for (int t = 0; t < readers; ++t) {
+        reader_threads.emplace_back([&, t] {
+            size_t k = static_cast<size_t>(t);
+            while (!stop.load(std::memory_order_relaxed)) {
+                DriverPositionUpdate at = PositionOf(k++ * 7919 % drivers, 0);
+                auto start = std::chrono::steady_clock::now();
+                auto candidates = index.QueryWithinRadius(at.latitude, at.longitude, 3.0, 10);
+                benchmark::DoNotOptimize(candidates);
+                latencies[t].push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+        });
+    }
+
+    int64_t round = 0;
+    DriverIngestStats before = ingestor.GetStats();
+    for (auto _ : state) {
+        const auto& batch = batches[round++ % rounds];
+        DriverIngestStats now = ingestor.GetStats();
+        const uint64_t target = now.applied + now.stale + now.dropped + batch.size();
+        ingestor.Ingest(batch);
+        // 等待本轮上报全部被处理（应用、判为旧位置或入队时被丢弃）
+        for (now = ingestor.GetStats(); now.applied + now.stale + now.dropped < target; now = ingestor.GetStats()) {
+            std::this_thread::yield();
+        }
+    }
+    stop = true;
+    for (auto& thread : reader_threads) thread.join();
+    ingestor.Stop();
+
+    DriverIngestStats after = ingestor.GetStats();
+    std::vector<double> all;
+    for (auto& values : latencies) all.insert(all.end(), values.begin(), values.end());
+    state.SetItemsProcessed(static_cast<int64_t>(after.applied - before.applied));
+    state.counters["dropped"] = static_cast<double>(after.dropped - before.dropped);
+    state.counters["query_p50_us"] = Percentile(all, 0.50);
+    state.counters["query_p99_us"] = Percentile(all, 0.99);
+    state.counters["queries"] = static_cast<double>(all.size());
+    state.counters["tracked"] = static_cast<double>(after.tracked);
+}
+
+BENCHMARK(BM_IngestWithReaders)
+    ->ArgNames({"drivers", "readers"})
+    ->Args({50000, 0})
+    ->Args({50000, 2})
+    ->Args({50000, 8})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,59 @@
+#include "util/geo_batch.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+// 以北京为中心、±1 度范围内的候选点（同城医院/司机的典型分布）
+const GeoPointArray& Candidates(size_t n) {
+    static std::unordered_map<size_t, GeoPointArray> cache;
+    GeoPointArray& points = cache[n];
+    if (points.Size() == 0) {
+        std::mt19937 rng(static_cast<uint32_t>(n));
+        std::uniform_real_distribution<double> offset(-1.0, 1.0);
+        points.Reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            points.Add(39.9042 + offset(rng), 116.4074 + offset(rng));
+        }
+    }
+    return points;
+}
+
+// 基准：逐点调用 GeoUtil::HaversineKm（改造前的写法）
+void BM_HaversinePerPoint(benchmark::State& state) {
+    const GeoPointArray& points = Candidates(static_cast<size_t>(state.range(0)));
+    std::vector<double> out(points.Size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < points.Size(); ++i) {
+            out[i] = GeoUtil::HaversineKm(39.95, 116.35, points.latitude[i], points.longitude[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.Size()));
+}
+
+void BM_GeoBatch(benchmark::State& state, GeoBatch::Kernel kernel) {
+    const GeoPointArray& points = Candidates(static_cast<size_t>(state.range(0)));
+    std::vector<double> out;
+    for (auto _ : state) {
+        GeoBatch::DistancesKmWith(kernel, 39.95, 116.35, points, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.Size()));
+    state.SetLabel(kernel > GeoBatch::ActiveKernel() ? "CPU不支持，已退化" : "");
+}
+
+BENCHMARK(BM_HaversinePerPoint)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_GeoBatch, Scalar, GeoBatch::Kernel::SCALAR)
+    ->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_GeoBatch, Sse2, GeoBatch::Kernel::SSE2)
+    ->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_GeoBatch, Avx2, GeoBatch::Kernel::AVX2)
+    ->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+#include "service/hospital_catalog.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <cstdio>
+#include <sys/wait.h>
+
+namespace {
+
+// n 家医院：每家 2-6 个科室（共 40 个）、7 个可预约日期，字符串长度接近线上数据
+const std::vector<Hospital>& Hospitals(size_t n) {
+    static std::unordered_map<size_t, std::vector<Hospital>> cache;
+    std::vector<Hospital>& hospitals = cache[n];
+    if (hospitals.empty()) {
+        std::mt19937 rng(static_cast<uint32_t>(n));
+        std::uniform_real_distribution<double> offset(-1.0, 1.0);
+        hospitals.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            Hospital& hosp = hospitals[i];
+            hosp.id = "HOSP" + std::to_string(100000000 + i);
+            hosp.name = "第" + std::to_string(i) + "人民医院（老年友善示范单位）";
+            hosp.level = i % 3 == 0 ? "三级甲等" : "二级甲等";
+            hosp.type = i % 4 == 0 ? "专科医院" : "综合医院";
+            hosp.status = "enabled";
+            hosp.address = "上海市某区某某路" + std::to_string(i % 2000) + "号（近地铁站）";
+            hosp.phone = "021-6" + std::to_string(1000000 + i % 9000000);
+            hosp.emergency_phone = "021-120";
+            hosp.elderly_service = "绿色通道、陪诊服务、无障碍设施";
+            hosp.opening_hours = i % 5 == 0 ? "周一至周日 00:00-24:00" : "周一至周五 08:00-17:00";
+            hosp.latitude = 31.2 + offset(rng);
+            hosp.longitude = 121.4 + offset(rng);
+            hosp.daily_quota = 200;
+            hosp.available_quota = static_cast<int>(i % 50);
+            hosp.advance_days = 7;
+            hosp.is_elderly_friendly = i % 2 == 0;
+            for (int d = 0; d < 7; ++d) hosp.reserve_days.push_back("2026-10-" + std::to_string(20 + d));
+            for (size_t d = 0, count = 2 + i % 5; d < count; ++d) {
+                hosp.departments.push_back("科室" + std::to_string((i * 7 + d * 13) % 40));
+            }
+        }
+    }
+    return hospitals;
+}
+
+struct LoadResult {
+    double seconds = 0;
+    double rss_mb = 0;      // 加载前后 RSS 之差
+    double anon_mb = 0;     // 其中匿名内存（堆）
+    double file_mb = 0;     // 其中文件映射页（页缓存，可回收、可与其他进程共享）
+};
+
+// /proc/self/status 中的 RssAnon / RssFile（kB）
+void ReadRss(double& anon_kb, double& file_kb) {
+    std::ifstream in("/proc/self/status");
+    std::string line;
+    anon_kb = file_kb = 0;
+    while (std::getline(in, line)) {
+        std::sscanf(line.c_str(), "RssAnon: %lf", &anon_kb);
+        std::sscanf(line.c_str(), "RssFile: %lf", &file_kb);
+    }
+}
+
+/**
+ * 在子进程中加载一次目录（冷启动：全新的进程与单例），把耗时与内存增量写回管道
+ * 数据库方式以“从内存中的结果集复制出 Hospital”代替，不含网络往返与 JSON 解析，是数据库加载的下限
+ */
+LoadResult LoadInChild(bool from_file, const std::vector<Hospital>& source, const std::string& path) {
+    int fds[2];
+    if (::pipe(fds) != 0) throw std::runtime_error("pipe failed");
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        ::close(fds[0]);
+        double anon_before, file_before;
+        ReadRss(anon_before, file_before);
+        auto start = std::chrono::steady_clock::now();
+        HospitalCatalog& catalog = HospitalCatalog::GetInstance();
+        bool ok;
+        if (from_file) {
+            ok = catalog.LoadFromFile(path);
+        } else {
+            catalog.Configure([&source] { return source; });
+            ok = catalog.Refresh();
+        }
+        LoadResult result;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double anon_after, file_after;
+        ReadRss(anon_after, file_after);
+        result.anon_mb = (anon_after - anon_before) / 1024;
+        result.file_mb = (file_after - file_before) / 1024;
+        result.rss_mb = result.anon_mb + result.file_mb;
+        if (!ok) result.seconds = -1;
+        ssize_t written = ::write(fds[1], &result, sizeof(result));
+        ::_exit(written == sizeof(result) ? 0 : 1);
+    }
+    ::close(fds[1]);
+    LoadResult result;
+    ssize_t got = ::read(fds[0], &result, sizeof(result));
+    ::close(fds[0]);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    if (got != sizeof(result) || result.seconds < 0) throw std::runtime_error("child load failed");
+    return result;
+}
+
+/**
+ * 冷启动加载耗时与内存：数据库结果集构建快照 vs 映射目录文件
+ * 参数：医院数、方式（0=数据库，1=文件）；每次迭代在新的子进程中加载（文件已在页缓存中）
+ */
+void BM_CatalogColdStart(benchmark::State& state) {
+    const auto& hospitals = Hospitals(static_cast<size_t>(state.range(0)));
+    const bool from_file = state.range(1) != 0;
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("hospital_catalog_bench." + std::to_string(hospitals.size()) + ".bin")).string();
+    HospitalCatalogFileWriter::Write(path, hospitals, 1);
+    LoadResult total;
+    for (auto _ : state) {
+        LoadResult result = LoadInChild(from_file, hospitals, path);
+        state.SetIterationTime(result.seconds);
+        total.rss_mb += result.rss_mb;
+        total.anon_mb += result.anon_mb;
+        total.file_mb += result.file_mb;
+    }
+    double iterations = static_cast<double>(state.iterations());
+    state.counters["rss_mb"] = total.rss_mb / iterations;
+    state.counters["anon_mb"] = total.anon_mb / iterations;
+    state.counters["file_mb"] = total.file_mb / iterations;
+    state.counters["file_size_mb"] = static_cast<double>(std::filesystem::file_size(path)) / (1024 * 1024);
+    std::filesystem::remove(path);
+    state.SetLabel(from_file ? "file" : "db");
+}
+
+BENCHMARK(BM_CatalogColdStart)
+    ->ArgNames({"hospitals", "from_file"})
+    ->Args({50000, 0})
+    ->Args({50000, 1})
+    ->Args({200000, 0})
+    ->Args({200000, 1})
+    ->Iterations(5)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
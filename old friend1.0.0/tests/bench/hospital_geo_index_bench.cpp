@@ -0,0 +1,74 @@
+#include "service/hospital_geo_index.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace {
+
+// 一个科室 n 家医院，分布在上海周边 ±0.5 度（约 50km）范围内
+struct Department {
+    std::vector<uint32_t> rows;
+    GeoPointArray points;
+
+    explicit Department(size_t n) {
+        std::mt19937 rng(static_cast<uint32_t>(n));
+        std::uniform_real_distribution<double> offset(-0.5, 0.5);
+        points.Reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rows.push_back(static_cast<uint32_t>(i));
+            points.Add(31.2 + offset(rng), 121.4 + offset(rng));
+        }
+    }
+};
+
+// 查询点在医院分布范围内随机选取（每轮迭代换一个）
+std::vector<std::pair<double, double>> Origins() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> offset(-0.5, 0.5);
+    std::vector<std::pair<double, double>> origins(256);
+    for (auto& origin : origins) origin = {31.2 + offset(rng), 121.4 + offset(rng)};
+    return origins;
+}
+
+// 基准：全量计算距离后对前 k 个部分排序（无索引的写法）
+void BM_NearestScanAndSort(benchmark::State& state) {
+    Department dept(static_cast<size_t>(state.range(0)));
+    const size_t k = static_cast<size_t>(state.range(1));
+    auto origins = Origins();
+    std::vector<double> distances;
+    std::vector<std::pair<double, uint32_t>> order;
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& origin = origins[i++ % origins.size()];
+        GeoBatch::DistancesKm(origin.first, origin.second, dept.points, distances);
+        order.resize(distances.size());
+        for (uint32_t j = 0; j < distances.size(); ++j) order[j] = {distances[j], dept.rows[j]};
+        std::partial_sort(order.begin(), order.begin() + std::min(k, order.size()), order.end());
+        benchmark::DoNotOptimize(order.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 网格索引：从查询点所在格子按圈向外扩展，第 k 近的距离不超过下一圈下界时停止
+void BM_NearestGeoIndex(benchmark::State& state) {
+    Department dept(static_cast<size_t>(state.range(0)));
+    const size_t k = static_cast<size_t>(state.range(1));
+    HospitalGeoIndex index(0.02);
+    index.AddDepartment("内科", dept.rows, dept.points);
+    auto origins = Origins();
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& origin = origins[i++ % origins.size()];
+        auto hits = index.QueryNearest("内科", origin.first, origin.second, k);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_NearestScanAndSort)->ArgNames({"hospitals", "k"})
+    ->Args({1000, 10})->Args({10000, 10})->Args({100000, 10})->Args({100000, 100})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NearestGeoIndex)->ArgNames({"hospitals", "k"})
+    ->Args({1000, 10})->Args({10000, 10})->Args({100000, 10})->Args({100000, 100})->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
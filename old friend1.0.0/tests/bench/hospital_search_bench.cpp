@@ -0,0 +1,76 @@
+#include "service/hospital_search.h"
+#include "model/hospital.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+// 一个科室 n 家医院，分布在上海周边 ±0.5 度范围内，约一半在查询日期有号
+struct Department {
+    std::vector<Hospital> hospitals;
+    std::vector<uint32_t> rows;
+    GeoPointArray points;
+    std::unordered_map<std::string, int> remaining; // 模拟配额引擎：医院ID → 剩余号源
+
+    explicit Department(size_t n) : hospitals(n) {
+        std::mt19937 rng(static_cast<uint32_t>(n));
+        std::uniform_real_distribution<double> offset(-0.5, 0.5);
+        points.Reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            hospitals[i].id = "H" + std::to_string(i);
+            hospitals[i].latitude = 31.2 + offset(rng);
+            hospitals[i].longitude = 121.4 + offset(rng);
+            hospitals[i].available_quota = 10;
+            rows.push_back(static_cast<uint32_t>(i));
+            points.Add(hospitals[i].latitude, hospitals[i].longitude);
+            remaining[hospitals[i].id] = static_cast<int>(i % 2);
+        }
+    }
+};
+
+/**
+ * 分页查询：第一页与第 pages 页（沿游标连续翻页）的耗时
+ * 参数：科室医院数、是否按实时号源过滤（has_quota 查一次哈希表）、翻到第几页
+ */
+void BM_HospitalSearch(benchmark::State& state) {
+    Department dept(static_cast<size_t>(state.range(0)));
+    const bool available_only = state.range(1) != 0;
+    const int pages = static_cast<int>(state.range(2));
+    HospitalQuotaPredicate has_quota = [&dept](uint32_t row) { return dept.remaining[dept.hospitals[row].id] > 0; };
+    auto id_at = [&dept](uint32_t row) { return std::string_view(dept.hospitals[row].id); };
+
+    // 先翻到第 pages 页，计时只覆盖这一页的查询
+    HospitalSearchOptions options;
+    options.available_only = available_only;
+    std::vector<HospitalSearchHit> hits;
+    std::string next_cursor;
+    for (int page = 1; page < pages; ++page) {
+        HospitalSearcher::Search(dept.rows, dept.points, 31.2, 121.4, options, id_at, hits, next_cursor, has_quota);
+        options.cursor = next_cursor;
+    }
+    size_t total = 0;
+    for (auto _ : state) {
+        total = HospitalSearcher::Search(dept.rows, dept.points, 31.2, 121.4, options, id_at, hits, next_cursor,
+                                         has_quota);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["total"] = static_cast<double>(total);
+}
+
+BENCHMARK(BM_HospitalSearch)
+    ->ArgNames({"hospitals", "available_only", "page"})
+    ->Args({10, 0, 1})
+    ->Args({10, 1, 1})
+    ->Args({1000, 0, 1})
+    ->Args({1000, 1, 1})
+    ->Args({1000, 1, 20})
+    ->Args({50000, 0, 1})
+    ->Args({50000, 1, 1})
+    ->Args({50000, 1, 20})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
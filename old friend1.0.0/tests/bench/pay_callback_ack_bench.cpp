@@ -0,0 +1,198 @@
+#include "util/durable_queue.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <filesystem>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+namespace {
+
+/**
+ * 本地 HTTP 替身：模拟微信支付回调入口（keep-alive，一个连接一个线程）
+ * - QUEUE：回调写入持久化队列（落盘）后立即返回 200，后台按批落库
+ * - SYNC：每个回调在返回 200 之前执行一次落库事务（耗时 commit_us）
+ */
+class CallbackServer {
+public:
+    enum class Mode { QUEUE = 0, SYNC = 1 };
+
+    CallbackServer(Mode mode, int commit_us, const std::string& queue_dir) : mode_(mode), commit_us_(commit_us) {
+        if (mode_ == Mode::QUEUE) {
+            DurableQueueOptions options;
+            options.sync_before_ack = true;
+            queue_.reset(new DurableQueue(queue_dir, options));
+            queue_->Start([this](const std::vector<std::string>&) {
+                std::this_thread::sleep_for(std::chrono::microseconds(commit_us_));  // 一批一个事务
+                return true;
+            });
+        }
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd_, 1024) != 0) {
+            throw std::runtime_error("callback server listen failed");
+        }
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        acceptor_ = std::thread([this] { AcceptLoop(); });
+    }
+
+    ~CallbackServer() {
+        running_ = false;
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        ::close(listen_fd_);
+        acceptor_.join();
+        for (auto& handler : handlers_) handler.join();
+        if (queue_) queue_->Stop();
+    }
+
+    uint16_t Port() const { return port_; }
+
+private:
+    void AcceptLoop() {
+        while (running_) {
+            int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) break;
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            handlers_.emplace_back([this, fd] { Serve(fd); });
+        }
+    }
+
+    void Serve(int fd) {
+        static const std::string kOk = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+        static const std::string kFail = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n\r\n";
+        std::string buf;
+        char chunk[4096];
+        while (true) {
+            size_t header_end;
+            while ((header_end = buf.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = ::read(fd, chunk, sizeof(chunk));
+                if (n <= 0) { ::close(fd); return; }
+                buf.append(chunk, static_cast<size_t>(n));
+            }
+            size_t length_pos = buf.find("Content-Length: ");
+            size_t body_len = length_pos < header_end ? std::stoul(buf.substr(length_pos + 16)) : 0;
+            while (buf.size() < header_end + 4 + body_len) {
+                ssize_t n = ::read(fd, chunk, sizeof(chunk));
+                if (n <= 0) { ::close(fd); return; }
+                buf.append(chunk, static_cast<size_t>(n));
+            }
+            std::string body = buf.substr(header_end + 4, body_len);
+            buf.erase(0, header_end + 4 + body_len);
+
+            bool ok = true;
+            if (mode_ == Mode::QUEUE) {
+                ok = queue_->Append(body);
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(commit_us_));
+            }
+            const std::string& response = ok ? kOk : kFail;
+            if (::write(fd, response.data(), response.size()) < 0) { ::close(fd); return; }
+        }
+    }
+
+    Mode mode_;
+    int commit_us_;
+    std::unique_ptr<DurableQueue> queue_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_{true};
+    std::thread acceptor_;
+    std::vector<std::thread> handlers_;
+};
+
+// 一个 keep-alive 连接上发送 count 个回调，记录每个请求从发出到收到 200 的耗时（ms）
+void SendCallbacks(uint16_t port, int count, int client, std::vector<double>& latencies) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    char response[256];
+    for (int i = 0; i < count; ++i) {
+        std::string body = "{\"out_trade_no\":\"20261016" + std::to_string(client * 1000000 + i) +
+                           "\",\"trade_state\":\"SUCCESS\",\"transaction_id\":\"4200001234\","
+                           "\"success_time\":\"2026-10-16T10:00:00+08:00\"}";
+        std::string request = "POST /api/payment/callback HTTP/1.1\r\nHost: localhost\r\n"
+                              "Content-Type: application/json\r\nContent-Length: " +
+                              std::to_string(body.size()) + "\r\n\r\n" + body;
+        auto start = std::chrono::steady_clock::now();
+        if (::write(fd, request.data(), request.size()) < 0) break;
+        std::string header;
+        while (header.find("\r\n\r\n") == std::string::npos) {
+            ssize_t n = ::read(fd, response, sizeof(response));
+            if (n <= 0) { ::close(fd); return; }
+            header.append(response, static_cast<size_t>(n));
+        }
+        latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    ::close(fd);
+}
+
+double Percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+/**
+ * 回调吞吐与确认延迟：connections 个并发连接各发送 per_connection 个回调
+ * 参数：模式（0=持久化队列，1=同步落库）、连接数；落库事务耗时固定 2ms
+ */
+void BM_PayCallbackAck(benchmark::State& state) {
+    const CallbackServer::Mode mode = static_cast<CallbackServer::Mode>(state.range(0));
+    const int connections = static_cast<int>(state.range(1));
+    const int per_connection = 200;
+    char tmpl[] = "/tmp/pay_callback_bench.XXXXXX";
+    if (::mkdtemp(tmpl) == nullptr) {
+        state.SkipWithError("mkdtemp failed");
+        return;
+    }
+    std::vector<double> latencies;
+    {
+        CallbackServer server(mode, 2000, std::string(tmpl) + "/queue");
+        for (auto _ : state) {
+            std::vector<std::vector<double>> per_client(connections);
+            std::vector<std::thread> clients;
+            for (int c = 0; c < connections; ++c) {
+                clients.emplace_back([&, c] { SendCallbacks(server.Port(), per_connection, c, per_client[c]); });
+            }
+            for (auto& client : clients) client.join();
+            for (auto& values : per_client) latencies.insert(latencies.end(), values.begin(), values.end());
+        }
+    }
+    std::filesystem::remove_all(tmpl);
+    state.SetItemsProcessed(static_cast<int64_t>(latencies.size()));
+    state.counters["p50_ms"] = Percentile(latencies, 0.50);
+    state.counters["p99_ms"] = Percentile(latencies, 0.99);
+    state.SetLabel(mode == CallbackServer::Mode::QUEUE ? "queue" : "sync");
+}
+
+BENCHMARK(BM_PayCallbackAck)
+    ->ArgNames({"mode", "connections"})
+    ->Args({0, 8})
+    ->Args({0, 64})
+    ->Args({1, 8})
+    ->Args({1, 64})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+#include "service/reserve_admission_gate.h"
+#include "service/reserve_quota_engine.h"
+#include "service/reserve_order_committer.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+
+namespace {
+
+// 模拟 HOSPITAL_QUOTA 表：条件更新 used_quota + delta <= total_quota，每个事务耗时 commit_us
+struct FakeQuotaTable {
+    std::mutex mutex;
+    ReserveQuota quota;
+    int commit_us = 500;
+
+    ReserveCommitResult Commit(const std::vector<ReserveQuotaDelta>& deltas) {
+        std::this_thread::sleep_for(std::chrono::microseconds(commit_us));
+        std::lock_guard<std::mutex> lock(mutex);
+        int delta = 0;
+        for (const auto& item : deltas) delta += item.used_delta;
+        if (quota.used_quota + delta > quota.total_quota) {
+            return ReserveCommitResult::QUOTA_EXCEEDED;
+        }
+        quota.used_quota += delta;
+        return ReserveCommitResult::COMMITTED;
+    }
+};
+
+double Percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+/**
+ * 放号瞬间的抢号压测：threads 个线程共发起 requests 次预约，号源 quota 个
+ * 流程与 CreateReserveOrder 一致：准入 → 内存占号 → 组提交（数据库条件更新）→ 失败归还
+ * 另有 other_used 个号源在本实例加载计数器后被其他实例约走，验证数据库侧兜底
+ * 输出：p50/p99 延迟（ms）、成功单数、被准入层直接拒绝的请求数、超卖数（应为 0）
+ */
+void BM_ReserveStorm(benchmark::State& state) {
+    const int threads = static_cast<int>(state.range(0));
+    const int requests = static_cast<int>(state.range(1));
+    const int quota = 100;
+    const int other_used = static_cast<int>(state.range(2));
+
+    FakeQuotaTable table;
+    ReserveQuotaEngine& engine = ReserveQuotaEngine::GetInstance();
+    engine.Configure(
+        [&](const std::string& h, const std::string& d, const std::string& date, ReserveQuota& out) {
+            std::lock_guard<std::mutex> lock(table.mutex);
+            out = table.quota;
+            out.hospital_id = h;
+            out.department = d;
+            out.reserve_date = date;
+            return true;
+        },
+        [](const std::vector<ReserveQuotaDelta>&) { return true; });
+    ReserveOrderCommitter& committer = ReserveOrderCommitter::GetInstance();
+    committer.Start([&](const std::vector<ReserveOrder>&, const std::vector<ReserveQuotaDelta>& deltas,
+                        const std::vector<ReserveSlotDelta>&, ReserveCommitOverflow&) {
+        return table.Commit(deltas);
+    });
+    ReserveAdmissionGate& gate = ReserveAdmissionGate::GetInstance();
+    ReserveAdmissionOptions options;
+    options.wait_timeout_ms = 10000;
+    gate.SetOptions(options);
+
+    std::vector<double> latencies;
+    int64_t committed_total = 0;
+    int64_t rejected_total = 0;
+    int64_t oversell_total = 0;
+    int round = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        // 每轮用新的日期，计数器与准入队列互不影响
+        std::string date = "2026-10-" + std::to_string(round++);
+        {
+            std::lock_guard<std::mutex> lock(table.mutex);
+            table.quota = ReserveQuota{"H1", "内科", date, quota, 0};
+        }
+        engine.Reconcile({table.quota});
+        {
+            std::lock_guard<std::mutex> lock(table.mutex);
+            table.quota.used_quota = other_used;
+        }
+        std::vector<std::vector<double>> per_thread(threads);
+        std::atomic<int> committed{0};
+        std::atomic<int> rejected{0};
+        std::atomic<int> next{0};
+        state.ResumeTiming();
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                while (next.fetch_add(1) < requests) {
+                    auto start = std::chrono::steady_clock::now();
+                    ReserveAdmissionGate::Ticket ticket;
+                    if (gate.Enter("H1", "内科", date, ticket) != AdmissionResult::ADMITTED) {
+                        ++rejected;
+                    } else if (engine.TryAcquire("H1", "内科", date, false) == QuotaAcquireResult::OK) {
+                        ticket.MarkQuotaAcquired();
+                        ReserveOrder order;
+                        order.hospital_id = "H1";
+                        order.department = "内科";
+                        order.reserve_date = date;
+                        ReserveCommitResult result = committer.Submit(order).get();
+                        if (result == ReserveCommitResult::COMMITTED) {
+                            ++committed;
+                        } else {
+                            engine.Release("H1", "内科", date, false);
+                            if (result == ReserveCommitResult::QUOTA_EXCEEDED) engine.Refresh("H1", "内科", date);
+                        }
+                    }
+                    ticket.Reset();
+                    per_thread[t].push_back(std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count());
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        state.PauseTiming();
+        for (auto& values : per_thread) latencies.insert(latencies.end(), values.begin(), values.end());
+        committed_total += committed;
+        rejected_total += rejected;
+        oversell_total += std::max(0, table.quota.used_quota - table.quota.total_quota) +
+                          std::max(0, committed.load() - (quota - other_used));
+        state.ResumeTiming();
+    }
+    committer.Stop();
+
+    double iterations = static_cast<double>(state.iterations());
+    state.counters["p50_ms"] = Percentile(latencies, 0.50);
+    state.counters["p99_ms"] = Percentile(latencies, 0.99);
+    state.counters["committed"] = static_cast<double>(committed_total) / iterations;
+    state.counters["rejected"] = static_cast<double>(rejected_total) / iterations;
+    state.counters["oversell"] = static_cast<double>(oversell_total);
+    state.SetItemsProcessed(state.iterations() * requests);
+}
+
+BENCHMARK(BM_ReserveStorm)
+    ->ArgNames({"threads", "requests", "other_used"})
+    ->Args({64, 10000, 0})
+    ->Args({256, 10000, 0})
+    ->Args({256, 10000, 30})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,94 @@
+#include "service/reserve_expiry_sweeper.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <tuple>
+
+namespace {
+
+/**
+ * 模拟 idx_status_date 索引：待就诊订单按 (reserve_date, order_id) 有序，
+ * 每个事务耗时 commit_us
+ */
+struct FakeOrderIndex {
+    std::vector<ReserveOrderKey> orders;
+    int commit_us = 0;
+
+    explicit FakeOrderIndex(size_t n) {
+        orders.reserve(n);
+        char date[16];
+        char order_id[24];
+        for (size_t i = 0; i < n; ++i) {
+            // 约 90 天的积压，一半就诊日已过
+            std::snprintf(date, sizeof(date), "2026-%02zu-%02zu", 8 + (i % 90) / 30, 1 + (i % 90) % 30);
+            std::snprintf(order_id, sizeof(order_id), "RES%012zu", i);
+            orders.push_back(ReserveOrderKey{date, order_id});
+        }
+        std::sort(orders.begin(), orders.end(), [](const ReserveOrderKey& a, const ReserveOrderKey& b) {
+            return std::tie(a.reserve_date, a.order_id) < std::tie(b.reserve_date, b.order_id);
+        });
+    }
+
+    bool Scan(const std::string& before_date, const std::string& after_date, const std::string& after_order_id,
+              size_t limit, std::vector<ReserveOrderKey>& out) {
+        auto it = std::upper_bound(orders.begin(), orders.end(), std::tie(after_date, after_order_id),
+                                   [](const std::tuple<const std::string&, const std::string&>& cursor,
+                                      const ReserveOrderKey& order) {
+                                       return cursor < std::tie(order.reserve_date, order.order_id);
+                                   });
+        for (; it != orders.end() && out.size() < limit && it->reserve_date < before_date; ++it) {
+            out.push_back(*it);
+        }
+        return true;
+    }
+
+    int64_t Expire(const std::vector<std::string>& order_ids) {
+        if (commit_us > 0) std::this_thread::sleep_for(std::chrono::microseconds(commit_us));
+        // 不真正改状态：每轮迭代面对同样的积压
+        return static_cast<int64_t>(order_ids.size());
+    }
+};
+
+/**
+ * 一轮扫描的吞吐：orders 个待就诊订单中约一半就诊日已过
+ * 参数：订单数、每批条数、每个事务的固定耗时（us）
+ */
+void BM_ExpirySweep(benchmark::State& state) {
+    FakeOrderIndex index(static_cast<size_t>(state.range(0)));
+    index.commit_us = static_cast<int>(state.range(2));
+    ReserveSweepOptions options;
+    options.batch_size = static_cast<size_t>(state.range(1));
+    ReserveExpirySweeper& sweeper = ReserveExpirySweeper::GetInstance();
+    sweeper.Configure(
+        [&](const std::string& before_date, const std::string& after_date, const std::string& after_order_id,
+            size_t limit, std::vector<ReserveOrderKey>& out) {
+            return index.Scan(before_date, after_date, after_order_id, limit, out);
+        },
+        [&](const std::vector<std::string>& order_ids, int64_t) { return index.Expire(order_ids); },
+        [] { return std::string("2026-09-16"); },
+        options);
+
+    uint64_t expired = 0;
+    ReserveSweepStats before = sweeper.GetStats();
+    for (auto _ : state) {
+        expired = sweeper.RunOnce(0);
+    }
+    ReserveSweepStats after = sweeper.GetStats();
+    state.SetItemsProcessed(static_cast<int64_t>(after.expired - before.expired));
+    state.counters["expired_per_run"] = static_cast<double>(expired);
+    state.counters["txn_per_run"] = static_cast<double>(after.batches - before.batches) /
+                                    static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_ExpirySweep)
+    ->ArgNames({"orders", "batch", "commit_us"})
+    ->Args({1000000, 1000, 0})
+    ->Args({1000000, 1000, 2000})
+    ->Args({1000000, 5000, 2000})
+    ->Args({4000000, 5000, 2000})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
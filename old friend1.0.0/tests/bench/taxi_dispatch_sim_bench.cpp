@@ -0,0 +1,288 @@
+#include "service/taxi_dispatcher.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <random>
+
+namespace {
+
+/**
+ * 内存 DAO：订单条件更新成功时把 (订单, 司机) 交给模拟器，用于安排行程结束事件
+ */
+struct FakeTaxiDao : public ITaxiDao {
+    std::unordered_map<std::string, TaxiDriver> drivers;
+    std::unordered_map<std::string, TaxiOrder> orders;
+    std::function<void(const std::string&, const std::string&)> on_dispatched;
+
+    TaxiDriver QueryDriverById(const std::string& driver_id) override {
+        auto it = drivers.find(driver_id);
+        return it == drivers.end() ? TaxiDriver() : it->second;
+    }
+    bool UpdateDriver(const TaxiDriver& driver) override {
+        drivers[driver.driver_id] = driver;
+        return true;
+    }
+    TaxiOrder QueryTaxiOrderById(const std::string& order_id) override { return orders[order_id]; }
+    bool CompareAndSetTaxiOrderStatus(const std::string& order_id, TaxiOrder::OrderStatus from,
+                                      TaxiOrder::OrderStatus to, const TaxiOrderPatch& patch) override {
+        TaxiOrder& order = orders[order_id];
+        if (order.status != from) return false;
+        order.status = to;
+        if (to == TaxiOrder::OrderStatus::DISPATCHED) {
+            for (const auto& column : patch.columns) {
+                if (column.first == "driver_id") on_dispatched(order_id, column.second);
+            }
+        }
+        return true;
+    }
+    size_t BatchCompareAndSetTaxiOrderStatus(const std::vector<std::string>& order_ids, TaxiOrder::OrderStatus from,
+                                             TaxiOrder::OrderStatus to, const TaxiOrderPatch& patch) override {
+        size_t updated = 0;
+        for (const auto& order_id : order_ids) updated += CompareAndSetTaxiOrderStatus(order_id, from, to, patch);
+        return updated;
+    }
+};
+
+// 城区范围（约 22km × 24km）与车速
+constexpr double kLatBegin = 31.10, kLatEnd = 31.30;
+constexpr double kLonBegin = 121.35, kLonEnd = 121.60;
+constexpr double kSpeedKmPerMs = 30.0 / 3600000.0;   // 30km/h
+constexpr int64_t kSimulatedMs = 30 * 60 * 1000;     // 模拟 30 分钟
+constexpr int64_t kOrderTimeoutMs = 5 * 60 * 1000;   // 等待 5 分钟未派出视为流失
+
+double Percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+/**
+ * 派单模拟：drivers 个司机均匀分布在城区，订单按泊松过程到达，派单后司机接驾 + 送客，
+ * 到达终点后重新空闲；模拟时钟推进，派单逻辑走真实的 TaxiDispatcher
+ * - 逐单模式：订单到达即派单，失败的订单每个窗口按先后重试
+ * - 批量模式：订单入队，每 batch_window_ms 调用一次 RunBatchTick
+ * 参数：模式（0=逐单，1=批量）、司机数、每分钟订单数
+ *       （平均行程约 10 分钟，每个司机每分钟约可接 0.1 单：2000 司机 100 单/分钟为平峰，180 单/分钟接近满载，300 单/分钟超载）
+ * 输出：平均/p99 接驾距离（km）、平均/p99 等待时间（模拟秒，批量模式含窗口等待）、
+ *       流失率、每次派单调用（逐单为单笔 Dispatch，批量为一次 RunBatchTick）的平均/最大 CPU 耗时（ms）
+ */
+void BM_DispatchSim(benchmark::State& state) {
+    const bool batch_mode = state.range(0) == 1;
+    const size_t driver_count = static_cast<size_t>(state.range(1));
+    const double orders_per_ms = static_cast<double>(state.range(2)) / 60000.0;
+
+    double pickup_total = 0.0, wait_total = 0.0, call_ms_total = 0.0, call_ms_max = 0.0;
+    size_t matched_total = 0, lost_total = 0, calls_total = 0;
+    std::vector<double> pickups, waits;
+    for (auto _ : state) {
+        std::mt19937 rng(2026);
+        std::uniform_real_distribution<double> lat(kLatBegin, kLatEnd), lon(kLonBegin, kLonEnd);
+        std::uniform_real_distribution<double> trip_offset(-0.04, 0.04);
+        std::exponential_distribution<double> gap(orders_per_ms);
+
+        FakeTaxiDao dao;
+        ITimeUtil time_util;
+        TaxiDispatchOptions options;
+        options.mode = batch_mode ? TaxiDispatchOptions::Mode::BATCH : TaxiDispatchOptions::Mode::GREEDY;
+        TaxiDispatcher dispatcher(&dao, &time_util, options);
+
+        std::unordered_map<std::string, TaxiLocation> driver_position;
+        for (size_t i = 0; i < driver_count; ++i) {
+            TaxiDriver driver;
+            driver.driver_id = "D" + std::to_string(i);
+            driver.status = TaxiDriver::DriverStatus::AVAILABLE;
+            dao.drivers[driver.driver_id] = driver;
+            TaxiLocation location;
+            location.latitude = lat(rng);
+            location.longitude = lon(rng);
+            driver_position[driver.driver_id] = location;
+            dispatcher.UpdateDriverLocation(driver.driver_id, location);
+        }
+
+        // 行程结束事件：(结束时刻, 司机, 终点)
+        using TripEnd = std::tuple<int64_t, std::string, TaxiLocation>;
+        auto later = [](const TripEnd& a, const TripEnd& b) { return std::get<0>(a) > std::get<0>(b); };
+        std::priority_queue<TripEnd, std::vector<TripEnd>, decltype(later)> trips(later);
+        std::unordered_map<std::string, int64_t> arrival;  // 等待中的订单 → 到达时刻
+        std::deque<TaxiOrder> waiting;                      // 逐单模式的重试队列
+        int64_t now = 0;
+        dao.on_dispatched = [&](const std::string& order_id, const std::string& driver_id) {
+            const TaxiOrder& order = dao.orders[order_id];
+            double pickup = GeoUtil::HaversineKm(driver_position[driver_id].latitude, driver_position[driver_id].longitude,
+                                              order.start_location.latitude, order.start_location.longitude);
+            double trip = GeoUtil::HaversineKm(order.start_location.latitude, order.start_location.longitude,
+                                            order.end_location.latitude, order.end_location.longitude);
+            trips.emplace(now + static_cast<int64_t>((pickup + trip) / kSpeedKmPerMs), driver_id, order.end_location);
+            pickup_total += pickup;
+            pickups.push_back(pickup);
+            double wait_s = static_cast<double>(now - arrival[order_id]) / 1000.0;
+            wait_total += wait_s;
+            waits.push_back(wait_s);
+            arrival.erase(order_id);
+            ++matched_total;
+        };
+        auto timed = [&](const std::function<void()>& call) {
+            auto begin = std::chrono::steady_clock::now();
+            call();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            call_ms_total += ms;
+            call_ms_max = std::max(call_ms_max, ms);
+            ++calls_total;
+        };
+
+        double next_order = gap(rng);
+        int64_t next_tick = options.batch_window_ms;
+        size_t order_seq = 0;
+        while (now < kSimulatedMs) {
+            // 推进到下一个事件：订单到达 / 行程结束 / 窗口
+            int64_t next = std::min<int64_t>(static_cast<int64_t>(next_order), next_tick);
+            if (!trips.empty()) next = std::min(next, std::get<0>(trips.top()));
+            now = next;
+
+            while (!trips.empty() && std::get<0>(trips.top()) <= now) {
+                const TripEnd& end = trips.top();
+                dao.drivers[std::get<1>(end)].status = TaxiDriver::DriverStatus::AVAILABLE;
+                driver_position[std::get<1>(end)] = std::get<2>(end);
+                dispatcher.SetDriverAvailable(std::get<1>(end), std::get<2>(end));
+                trips.pop();
+            }
+            while (static_cast<int64_t>(next_order) <= now) {
+                TaxiOrder order;
+                order.order_id = "O" + std::to_string(order_seq++);
+                order.start_location.latitude = lat(rng);
+                order.start_location.longitude = lon(rng);
+                order.end_location.latitude = std::clamp(order.start_location.latitude + trip_offset(rng), kLatBegin, kLatEnd);
+                order.end_location.longitude = std::clamp(order.start_location.longitude + trip_offset(rng), kLonBegin, kLonEnd);
+                dao.orders[order.order_id] = order;
+                arrival[order.order_id] = now;
+                timed([&] {
+                    if (!dispatcher.Dispatch(order) && !batch_mode) waiting.push_back(order);
+                });
+                next_order += gap(rng);
+            }
+            if (now >= next_tick) {
+                next_tick += options.batch_window_ms;
+                if (batch_mode) {
+                    timed([&] { dispatcher.RunBatchTick(); });
+                } else {
+                    size_t retries = waiting.size();
+                    for (size_t i = 0; i < retries; ++i) {
+                        TaxiOrder order = waiting.front();
+                        waiting.pop_front();
+                        if (dao.orders[order.order_id].status != TaxiOrder::OrderStatus::PENDING_DISPATCH) continue;
+                        timed([&] {
+                            if (!dispatcher.Dispatch(order)) waiting.push_back(order);
+                        });
+                    }
+                }
+                // 超时未派出的订单取消（流失）
+                for (auto it = arrival.begin(); it != arrival.end();) {
+                    if (now - it->second < kOrderTimeoutMs) {
+                        ++it;
+                        continue;
+                    }
+                    dao.orders[it->first].status = TaxiOrder::OrderStatus::CANCELED;
+                    dispatcher.CancelPending(it->first);
+                    ++lost_total;
+                    it = arrival.erase(it);
+                }
+            }
+        }
+    }
+
+    double matched = static_cast<double>(std::max<size_t>(matched_total, 1));
+    state.counters["avg_pickup_km"] = pickup_total / matched;
+    state.counters["p99_pickup_km"] = Percentile(pickups, 0.99);
+    state.counters["avg_wait_s"] = wait_total / matched;
+    state.counters["p99_wait_s"] = Percentile(waits, 0.99);
+    state.counters["lost_ratio"] = static_cast<double>(lost_total) / static_cast<double>(matched_total + lost_total);
+    state.counters["call_avg_ms"] = call_ms_total / static_cast<double>(std::max<size_t>(calls_total, 1));
+    state.counters["call_max_ms"] = call_ms_max;
+    state.SetLabel(batch_mode ? "batch" : "greedy");
+}
+
+/**
+ * 单个批量窗口的求解耗时：orders 个订单，drivers 个空闲司机，每单最多 10 个 5km 内候选
+ * 参数：订单数、司机数、求解方式（0=整体稠密矩阵（改造前），1=按连通分量拆分）
+ * 输出：分量数、最大分量的订单数、整体稠密矩阵的格数
+ */
+void BM_BatchSolve(benchmark::State& state) {
+    const size_t orders = static_cast<size_t>(state.range(0));
+    const size_t drivers = static_cast<size_t>(state.range(1));
+    const bool sparse = state.range(2) == 1;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lat(kLatBegin, kLatEnd), lon(kLonBegin, kLonEnd);
+    DriverLocationIndex index;
+    for (size_t i = 0; i < drivers; ++i) index.UpdatePosition("D" + std::to_string(i), lat(rng), lon(rng));
+    std::unordered_map<std::string, size_t> column;
+    BatchMatcher::Edges edges(orders);
+    for (size_t i = 0; i < orders; ++i) {
+        for (const auto& candidate : index.QueryWithinRadius(lat(rng), lon(rng), MAX_DISPATCH_DISTANCE, 10)) {
+            auto it = column.emplace(candidate.driver_id, column.size()).first;
+            edges[i].emplace_back(it->second, candidate.distance);
+        }
+    }
+    const size_t cols = column.size();
+
+    for (auto _ : state) {
+        std::vector<int> assignment;
+        if (sparse) {
+            assignment = BatchMatcher::SolveSparse(cols, edges, BatchMatcher::Algorithm::HUNGARIAN);
+        } else {
+            std::vector<std::vector<double>> cost(orders, std::vector<double>(cols, BatchMatcher::kInfeasible));
+            for (size_t i = 0; i < orders; ++i) {
+                for (const auto& edge : edges[i]) cost[i][edge.first] = edge.second;
+            }
+            assignment = BatchMatcher::Solve(cost, BatchMatcher::Algorithm::HUNGARIAN);
+        }
+        benchmark::DoNotOptimize(assignment.data());
+    }
+
+    // 分量统计（并查集）
+    std::vector<size_t> parent(orders + cols);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::function<size_t(size_t)> find = [&](size_t x) { return parent[x] == x ? x : parent[x] = find(parent[x]); };
+    for (size_t i = 0; i < orders; ++i) {
+        for (const auto& edge : edges[i]) parent[find(i)] = find(orders + edge.first);
+    }
+    std::unordered_map<size_t, size_t> component_rows;
+    size_t largest = 0;
+    for (size_t i = 0; i < orders; ++i) {
+        if (!edges[i].empty()) largest = std::max(largest, ++component_rows[find(i)]);
+    }
+    state.counters["components"] = static_cast<double>(component_rows.size());
+    state.counters["largest_rows"] = static_cast<double>(largest);
+    state.counters["dense_cells"] = static_cast<double>(orders * cols);
+    state.SetLabel(sparse ? "components" : "dense");
+}
+
+BENCHMARK(BM_DispatchSim)
+    ->ArgNames({"mode", "drivers", "orders_per_min"})
+    ->Args({0, 2000, 100})
+    ->Args({1, 2000, 100})
+    ->Args({0, 2000, 180})
+    ->Args({1, 2000, 180})
+    ->Args({0, 2000, 300})
+    ->Args({1, 2000, 300})
+    ->Args({0, 10000, 900})
+    ->Args({1, 10000, 900})
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_BatchSolve)
+    ->ArgNames({"orders", "drivers", "sparse"})
+    ->Args({300, 3000, 0})
+    ->Args({300, 3000, 1})
+    ->Args({1000, 10000, 0})
+    ->Args({1000, 10000, 1})
+    ->Args({1000, 3000, 1})
+    ->Args({2000, 10000, 1})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
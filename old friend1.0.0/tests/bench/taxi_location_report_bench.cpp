@@ -0,0 +1,91 @@
+#include "service/taxi_dispatcher.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/**
+ * 模拟司机表：每次 QueryDriverById 耗时 query_us（一次数据库往返）
+ * 司机状态按编号分布：60% 空闲、30% 服务中、10% 离线
+ */
+struct FakeTaxiDao : public ITaxiDao {
+    int query_us = 200;
+    std::atomic<int64_t> driver_queries{0};
+
+    static TaxiDriver::DriverStatus StatusOf(size_t i) {
+        size_t bucket = i % 10;
+        if (bucket < 6) return TaxiDriver::DriverStatus::AVAILABLE;
+        if (bucket < 9) return TaxiDriver::DriverStatus::BUSY;
+        return TaxiDriver::DriverStatus::OFFLINE;
+    }
+
+    TaxiDriver QueryDriverById(const std::string& driver_id) override {
+        ++driver_queries;
+        std::this_thread::sleep_for(std::chrono::microseconds(query_us));
+        TaxiDriver driver;
+        driver.driver_id = driver_id;
+        driver.status = StatusOf(std::stoul(driver_id.substr(1)));
+        return driver;
+    }
+    bool UpdateDriver(const TaxiDriver&) override { return true; }
+    TaxiOrder QueryTaxiOrderById(const std::string&) override { return TaxiOrder(); }
+    bool CompareAndSetTaxiOrderStatus(const std::string&, TaxiOrder::OrderStatus, TaxiOrder::OrderStatus,
+                                      const TaxiOrderPatch&) override { return true; }
+    size_t BatchCompareAndSetTaxiOrderStatus(const std::vector<std::string>& order_ids, TaxiOrder::OrderStatus,
+                                             TaxiOrder::OrderStatus, const TaxiOrderPatch&) override {
+        return order_ids.size();
+    }
+};
+
+TaxiLocation LocationOf(size_t driver, int round) {
+    TaxiLocation location;
+    location.latitude = 31.0 + static_cast<double>(driver % 500) * 0.001 + round * 0.00001;
+    location.longitude = 121.0 + static_cast<double>(driver / 500) * 0.001;
+    return location;
+}
+
+/**
+ * 位置上报吞吐：drivers 个司机每轮各上报一次
+ * 参数：司机数、模式（0=内存状态（预热后）、1=不在索引中的司机每次上报前丢弃内存状态，
+ *       等价于改造前服务中/离线司机逐次查库）
+ * 输出：每次上报的平均查库次数
+ */
+void BM_LocationReport(benchmark::State& state) {
+    const size_t drivers = static_cast<size_t>(state.range(0));
+    const bool forget = state.range(1) == 1;
+    FakeTaxiDao dao;
+    ITimeUtil time_util;
+    TaxiDispatcher dispatcher(&dao, &time_util);
+    std::vector<std::string> ids;
+    ids.reserve(drivers);
+    for (size_t i = 0; i < drivers; ++i) ids.push_back("D" + std::to_string(i));
+    // 预热：每个司机首次出现各查库一次
+    for (size_t i = 0; i < drivers; ++i) dispatcher.UpdateDriverLocation(ids[i], LocationOf(i, 0));
+
+    int round = 1;
+    int64_t queries_before = dao.driver_queries;
+    for (auto _ : state) {
+        for (size_t i = 0; i < drivers; ++i) {
+            if (forget && FakeTaxiDao::StatusOf(i) != TaxiDriver::DriverStatus::AVAILABLE) {
+                dispatcher.ForgetDriver(ids[i]);
+            }
+            dispatcher.UpdateDriverLocation(ids[i], LocationOf(i, round));
+        }
+        ++round;
+    }
+    int64_t reports = state.iterations() * static_cast<int64_t>(drivers);
+    state.SetItemsProcessed(reports);
+    state.counters["dao_queries_per_report"] =
+        static_cast<double>(dao.driver_queries - queries_before) / static_cast<double>(reports);
+    state.SetLabel(forget ? "query_per_report" : "in_memory");
+}
+
+BENCHMARK(BM_LocationReport)
+    ->ArgNames({"drivers", "mode"})
+    ->Args({10000, 0})
+    ->Args({10000, 1})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
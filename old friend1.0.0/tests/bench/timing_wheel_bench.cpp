@@ -0,0 +1,208 @@
+#include "util/timing_wheel.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+
+namespace {
+
+/**
+ * 对照组：按 (到期时间, key) 排序的有序集合 + key 索引，Schedule/Cancel 为 O(log n)
+ */
+class OrderedTimers {
+public:
+    explicit OrderedTimers(int64_t) {}
+
+    void Schedule(const std::string& key, int64_t expire_at, int = 0) {
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            queue_.erase({it->second, key});
+            it->second = expire_at;
+        } else {
+            index_.emplace(key, expire_at);
+        }
+        queue_.emplace(expire_at, key);
+    }
+
+    bool Cancel(const std::string& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) return false;
+        queue_.erase({it->second, key});
+        index_.erase(it);
+        return true;
+    }
+
+    std::vector<TimingWheel::Expired> Advance(int64_t now) {
+        std::vector<TimingWheel::Expired> expired;
+        while (!queue_.empty() && queue_.begin()->first <= now) {
+            expired.push_back(TimingWheel::Expired{queue_.begin()->second, 0, queue_.begin()->first});
+            index_.erase(queue_.begin()->second);
+            queue_.erase(queue_.begin());
+        }
+        return expired;
+    }
+
+private:
+    std::set<std::pair<int64_t, std::string>> queue_;
+    std::unordered_map<std::string, int64_t> index_;
+};
+
+constexpr int64_t kNow = 1760000000;
+
+// 与 OrderExpiryScheduler 相同格式的 key，到期时间在 30 分钟（待派单/待支付）到 7 天（预约）之间
+struct TimerSet {
+    std::vector<std::string> keys;
+    std::vector<int64_t> expire_at;
+
+    explicit TimerSet(size_t n) {
+        std::mt19937_64 rng(2026);
+        keys.reserve(n);
+        expire_at.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys.push_back(std::to_string(i % 3) + ":TAXI_ORDER" + std::to_string(1760000000000000 + i));
+            expire_at.push_back(kNow + (i % 3 == 2 ? 1800 + static_cast<int64_t>(rng() % (7 * 86400))
+                                                   : 60 + static_cast<int64_t>(rng() % 1800)));
+        }
+    }
+};
+
+const TimerSet& Timers(size_t n) {
+    static std::map<size_t, std::unique_ptr<TimerSet>> cache;
+    auto& entry = cache[n];
+    if (!entry) entry.reset(new TimerSet(n));
+    return *entry;
+}
+
+double Percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+template <typename Scheduler>
+void ScheduleAll(Scheduler& timers, const TimerSet& set) {
+    for (size_t i = 0; i < set.keys.size(); ++i) timers.Schedule(set.keys[i], set.expire_at[i]);
+}
+
+/**
+ * 注册 timers 个定时器（服务重启恢复 / 下单高峰）
+ * 参数：实现（0=时间轮，1=有序集合）、定时器数
+ */
+template <typename Scheduler>
+void RunSchedule(benchmark::State& state, const TimerSet& set) {
+    for (auto _ : state) {
+        std::unique_ptr<Scheduler> timers(new Scheduler(kNow));
+        ScheduleAll(*timers, set);
+        state.PauseTiming();
+        timers.reset();
+        state.ResumeTiming();
+    }
+}
+
+void BM_TimerSchedule(benchmark::State& state) {
+    const TimerSet& set = Timers(static_cast<size_t>(state.range(1)));
+    if (state.range(0) == 0) {
+        RunSchedule<TimingWheel>(state, set);
+    } else {
+        RunSchedule<OrderedTimers>(state, set);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.SetLabel(state.range(0) == 0 ? "timing_wheel" : "ordered_set");
+}
+
+/**
+ * 已有 timers 个定时器时，取消其中一半（派单成功/支付成功），再按新的到期时间重新注册（刷新支付单）
+ * 参数：实现（0=时间轮，1=有序集合）、定时器数
+ */
+template <typename Scheduler>
+void RunCancel(benchmark::State& state, const TimerSet& set) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<Scheduler> timers(new Scheduler(kNow));
+        ScheduleAll(*timers, set);
+        state.ResumeTiming();
+        for (size_t i = 0; i < set.keys.size(); i += 2) benchmark::DoNotOptimize(timers->Cancel(set.keys[i]));
+        for (size_t i = 1; i < set.keys.size(); i += 2) timers->Schedule(set.keys[i], set.expire_at[i] + 900);
+        state.PauseTiming();
+        timers.reset();
+        state.ResumeTiming();
+    }
+}
+
+void BM_TimerCancelReschedule(benchmark::State& state) {
+    const TimerSet& set = Timers(static_cast<size_t>(state.range(1)));
+    if (state.range(0) == 0) {
+        RunCancel<TimingWheel>(state, set);
+    } else {
+        RunCancel<OrderedTimers>(state, set);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.SetLabel(state.range(0) == 0 ? "timing_wheel" : "ordered_set");
+}
+
+/**
+ * 逐秒推进到全部定时器到期（7 天 + 30 分钟），与 OrderExpiryScheduler 的后台线程一致
+ * 输出：每次推进（1 秒）的 p99 / 最大耗时（us）
+ */
+template <typename Scheduler>
+void RunAdvance(benchmark::State& state, const TimerSet& set, std::vector<double>& tick_us) {
+    const int64_t end = *std::max_element(set.expire_at.begin(), set.expire_at.end());
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<Scheduler> timers(new Scheduler(kNow));
+        ScheduleAll(*timers, set);
+        tick_us.clear();
+        state.ResumeTiming();
+        size_t fired = 0;
+        for (int64_t now = kNow; now <= end; ++now) {
+            auto begin = std::chrono::steady_clock::now();
+            fired += timers->Advance(now).size();
+            tick_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+        }
+        if (fired != set.keys.size()) state.SkipWithError("timers lost");
+        state.PauseTiming();
+        timers.reset();
+        state.ResumeTiming();
+    }
+}
+
+void BM_TimerAdvance(benchmark::State& state) {
+    const TimerSet& set = Timers(static_cast<size_t>(state.range(1)));
+    std::vector<double> tick_us;
+    if (state.range(0) == 0) {
+        RunAdvance<TimingWheel>(state, set, tick_us);
+    } else {
+        RunAdvance<OrderedTimers>(state, set, tick_us);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.counters["tick_p99_us"] = Percentile(tick_us, 0.99);
+    state.counters["tick_max_us"] = *std::max_element(tick_us.begin(), tick_us.end());
+    state.SetLabel(state.range(0) == 0 ? "timing_wheel" : "ordered_set");
+}
+
+BENCHMARK(BM_TimerSchedule)
+    ->ArgNames({"impl", "timers"})
+    ->ArgsProduct({{0, 1}, {1000000, 4000000}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_TimerCancelReschedule)
+    ->ArgNames({"impl", "timers"})
+    ->ArgsProduct({{0, 1}, {1000000, 4000000}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_TimerAdvance)
+    ->ArgNames({"impl", "timers"})
+    ->ArgsProduct({{0, 1}, {1000000, 4000000}})
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
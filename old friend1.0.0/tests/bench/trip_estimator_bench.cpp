@@ -0,0 +1,94 @@
+#include "service/trip_estimator.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+
+namespace {
+
+struct Trip {
+    double start_lat, start_lon, end_lat, end_lon;
+    double distance_km, duration_min;
+};
+
+// 城区（约 44km × 48km）内的随机行程，绕行系数 1.2~1.6，每公里 2~4 分钟
+std::vector<Trip> RandomTrips(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> lat(31.0, 31.4), lon(121.2, 121.7);
+    std::uniform_real_distribution<double> ratio(1.2, 1.6), min_per_km(2.0, 4.0);
+    std::vector<Trip> trips(n);
+    for (auto& trip : trips) {
+        trip.start_lat = lat(rng);
+        trip.start_lon = lon(rng);
+        trip.end_lat = lat(rng);
+        trip.end_lon = lon(rng);
+        double straight = GeoUtil::HaversineKm(trip.start_lat, trip.start_lon, trip.end_lat, trip.end_lon);
+        trip.distance_km = straight * ratio(rng);
+        trip.duration_min = trip.distance_km * min_per_km(rng);
+    }
+    return trips;
+}
+
+/**
+ * 报价查询：预估器先学习 history 笔历史订单，再对随机起终点做 Estimate
+ * 参数：历史订单数；多线程版本模拟并发报价
+ * 输出：命中已学习网格对的比例
+ */
+class TripEstimateFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+        estimator_.reset(new TripEstimator());
+        for (const Trip& trip : RandomTrips(static_cast<size_t>(state.range(0)), 1)) {
+            estimator_->Learn(trip.start_lat, trip.start_lon, trip.end_lat, trip.end_lon,
+                              trip.distance_km, trip.duration_min);
+        }
+        queries_ = RandomTrips(1 << 16, 2);
+    }
+
+protected:
+    std::unique_ptr<TripEstimator> estimator_;
+    std::vector<Trip> queries_;
+};
+
+BENCHMARK_DEFINE_F(TripEstimateFixture, Estimate)(benchmark::State& state) {
+    size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+    int64_t hits = 0;
+    for (auto _ : state) {
+        const Trip& trip = queries_[i++ & (queries_.size() - 1)];
+        TripEstimate estimate = estimator_->Estimate(trip.start_lat, trip.start_lon, trip.end_lat, trip.end_lon);
+        hits += estimate.samples > 0;
+        benchmark::DoNotOptimize(estimate);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_ratio"] = benchmark::Counter(static_cast<double>(hits) / static_cast<double>(state.iterations()),
+                                                     benchmark::Counter::kAvgThreads);
+}
+
+BENCHMARK_REGISTER_F(TripEstimateFixture, Estimate)
+    ->ArgNames({"history"})
+    ->Arg(100000)
+    ->Arg(2000000)
+    ->Threads(1)
+    ->Threads(4)
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+
+/**
+ * 学习吞吐：送达后每笔订单更新一次网格对与全局系数
+ */
+void BM_TripLearn(benchmark::State& state) {
+    TripEstimator estimator;
+    std::vector<Trip> trips = RandomTrips(1 << 16, 3);
+    size_t i = 0;
+    for (auto _ : state) {
+        const Trip& trip = trips[i++ & (trips.size() - 1)];
+        estimator.Learn(trip.start_lat, trip.start_lon, trip.end_lat, trip.end_lon, trip.distance_km, trip.duration_min);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_TripLearn)->Unit(benchmark::kNanosecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
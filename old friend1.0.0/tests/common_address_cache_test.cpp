@@ -0,0 +1,49 @@
+#include "service/common_address_cache.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+TaxiCommonAddress Address(const std::string& id, bool is_default, int64_t last_use_time) {
+    TaxiCommonAddress addr;
+    addr.addr_id = id;
+    addr.user_id = "u1";
+    addr.is_default = is_default;
+    addr.priority = 1;
+    addr.last_use_time = last_use_time;
+    return addr;
+}
+
+// 加载期间新增地址：加载结果（不含新地址）不写入缓存，下次读取重新查库
+TEST(CommonAddressCacheTest, LoadRacingWithAddIsDiscarded) {
+    CommonAddressCache cache;
+    uint64_t ticket = 0;
+    ASSERT_EQ(cache.Get("u1", ticket), nullptr);
+    CommonAddressCache::AddressList loaded = {Address("a1", false, 1)}; // 读库时新地址尚未提交
+
+    cache.OnAdded("u1", Address("a2", true, 2));                        // 新地址提交
+    CommonAddressCache::AddressListPtr list = cache.Put("u1", loaded, ticket);
+    ASSERT_EQ(list->size(), 1u);                                         // 本次调用仍拿到读到的结果
+
+    uint64_t next_ticket = 0;
+    EXPECT_EQ(cache.Get("u1", next_ticket), nullptr);
+    EXPECT_EQ(cache.GetStats().discarded_loads, 1u);
+}
+
+// 无并发写入时正常缓存，使用时间增量维护
+TEST(CommonAddressCacheTest, CachesLoadAndAppliesUse) {
+    CommonAddressCache cache;
+    uint64_t ticket = 0;
+    ASSERT_EQ(cache.Get("u1", ticket), nullptr);
+    cache.Put("u1", {Address("a1", false, 1), Address("a2", false, 2)}, ticket);
+
+    cache.OnUsed("u1", "a1", 10);
+    CommonAddressCache::AddressListPtr list = cache.Get("u1", ticket);
+    ASSERT_NE(list, nullptr);
+    ASSERT_EQ(list->size(), 2u);
+    EXPECT_EQ((*list)[0].addr_id, "a1");
+
+    cache.OnDefaultCleared("u1");
+    EXPECT_EQ(cache.Get("u1", ticket), nullptr);
+}
+
+} // namespace
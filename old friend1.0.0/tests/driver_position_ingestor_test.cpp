@@ -0,0 +1,120 @@
+#include "service/driver_position_ingestor.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+DriverPositionUpdate Update(const std::string& driver_id, double latitude, double longitude, int64_t timestamp) {
+    return DriverPositionUpdate{driver_id, latitude, longitude, timestamp};
+}
+
+bool NearBy(const DriverLocationIndex& index, const std::string& driver_id, double latitude, double longitude) {
+    for (const auto& candidate : index.QueryWithinRadius(latitude, longitude, 0.05)) {
+        if (candidate.driver_id == driver_id) return true;
+    }
+    return false;
+}
+
+// 只移动索引中的空闲司机；同一司机按时间戳取最新，旧位置被忽略
+TEST(DriverPositionIngestorTest, MovesOnlyIndexedDriversToLatestPosition) {
+    DriverLocationIndex index;
+    index.UpdatePosition("D1", 31.20, 121.40);
+    DriverPositionIngestor ingestor(&index);
+    ingestor.Start();
+    ingestor.Ingest({Update("D1", 31.21, 121.41, 2), Update("D1", 31.25, 121.45, 1), Update("BUSY", 31.21, 121.41, 2)});
+    ingestor.Stop();
+
+    EXPECT_TRUE(NearBy(index, "D1", 31.21, 121.41));
+    EXPECT_FALSE(NearBy(index, "BUSY", 31.21, 121.41));
+    EXPECT_EQ(index.Size(), 1u);
+    EXPECT_EQ(ingestor.GetStats().stale, 1u);
+
+    // 已应用过更新时间戳的位置后，迟到的旧上报不再生效
+    ingestor.Start();
+    ingestor.Ingest({Update("D1", 31.30, 121.50, 1)});
+    ingestor.Stop();
+    EXPECT_TRUE(NearBy(index, "D1", 31.21, 121.41));
+}
+
+// Stop 会把队列中超过单轮批量的剩余上报全部处理完
+TEST(DriverPositionIngestorTest, StopDrainsAllQueuedUpdates) {
+    DriverLocationIndex index;
+    const size_t drivers = 1000;
+    for (size_t i = 0; i < drivers; ++i) {
+        index.UpdatePosition("D" + std::to_string(i), 31.0, 121.0);
+    }
+    DriverIngestOptions options;
+    options.shard_count = 2;
+    options.max_batch = 16;
+    options.idle_sleep_ms = 1000;  // 消费线程处理一轮后长时间休眠，剩余上报只能由 Stop 处理
+    DriverPositionIngestor ingestor(&index, options);
+    ingestor.Start();
+    std::vector<DriverPositionUpdate> batch;
+    for (size_t i = 0; i < drivers; ++i) {
+        batch.push_back(Update("D" + std::to_string(i), 32.0, 122.0, 1));
+    }
+    ASSERT_EQ(ingestor.Ingest(batch), drivers);
+    ingestor.Stop();
+
+    EXPECT_EQ(ingestor.GetStats().applied, drivers);
+    EXPECT_EQ(index.QueryWithinRadius(32.0, 122.0, 0.05).size(), drivers);
+}
+
+// 司机离开索引后时间戳记录被删除：继续上报的在下一次上报时删除，不再上报的由定期清理删除；
+// 重新进入索引后，即使时间戳早于离开前的记录也照常应用
+TEST(DriverPositionIngestorTest, PrunesDriversThatLeftTheIndex) {
+    DriverLocationIndex index;
+    index.UpdatePosition("D1", 31.20, 121.40);
+    index.UpdatePosition("D2", 31.20, 121.40);
+    DriverIngestOptions options;
+    options.prune_interval_ms = 20;
+    DriverPositionIngestor ingestor(&index, options);
+    ingestor.Start();
+    ingestor.Ingest({Update("D1", 31.21, 121.41, 10), Update("D2", 31.21, 121.41, 10)});
+    ingestor.Stop();
+    EXPECT_EQ(ingestor.GetStats().tracked, 2u);
+
+    // D1 被派单后继续上报，D2 下线后不再上报
+    index.Remove("D1");
+    index.Remove("D2");
+    ingestor.Start();
+    ingestor.Ingest({Update("D1", 31.22, 121.42, 11)});
+    for (int i = 0; i < 200 && ingestor.GetStats().tracked > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ingestor.Stop();
+    EXPECT_EQ(ingestor.GetStats().tracked, 0u);
+    EXPECT_EQ(index.Size(), 0u);
+
+    // 重新上线：以较早的时间戳上报（司机端时钟回拨）也能应用
+    index.UpdatePosition("D1", 31.20, 121.40);
+    ingestor.Start();
+    ingestor.Ingest({Update("D1", 31.23, 121.43, 5)});
+    ingestor.Stop();
+    EXPECT_TRUE(NearBy(index, "D1", 31.23, 121.43));
+    EXPECT_EQ(ingestor.GetStats().tracked, 1u);
+}
+
+// 查询方持有的格子快照不受并发写入影响，写入期间查询结果始终完整
+TEST(DriverPositionIngestorTest, QueriesSeeConsistentCellsDuringWrites) {
+    DriverLocationIndex index;
+    const size_t drivers = 200;
+    for (size_t i = 0; i < drivers; ++i) {
+        index.UpdatePosition("D" + std::to_string(i), 31.2000, 121.4000);
+    }
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int round = 0; round < 200; ++round) {
+            for (size_t i = 0; i < drivers; ++i) {
+                double offset = (round % 2) * 0.0001;  // 同一格子内来回移动
+                index.MoveIfPresent("D" + std::to_string(i), 31.2000 + offset, 121.4000 + offset);
+            }
+        }
+        done = true;
+    });
+    while (!done) {
+        ASSERT_EQ(index.QueryWithinRadius(31.2000, 121.4000, 0.5).size(), drivers);
+    }
+    writer.join();
+}
+
+} // namespace
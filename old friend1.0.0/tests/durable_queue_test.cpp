@@ -0,0 +1,250 @@
+#include "util/durable_queue.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <filesystem>
+#include <signal.h>
+#include <sys/wait.h>
+
+namespace {
+
+class DurableQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char tmpl[] = "/tmp/durable_queue_test.XXXXXX";
+        ASSERT_NE(::mkdtemp(tmpl), nullptr);
+        dir_ = tmpl;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    static DurableQueueOptions SyncOptions() {
+        DurableQueueOptions options;
+        options.sync_before_ack = true;
+        options.retry_initial_ms = 5;
+        options.retry_max_ms = 20;
+        return options;
+    }
+
+    // 启动消费并等待收到 count 条记录（超时返回已收到的部分）
+    static std::vector<std::string> DrainAll(DurableQueue& queue, size_t count) {
+        std::mutex mutex;
+        std::vector<std::string> received;
+        queue.Start([&](const std::vector<std::string>& records) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.insert(received.end(), records.begin(), records.end());
+            return true;
+        });
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (queue.GetStats().delivered < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        queue.Stop();
+        std::lock_guard<std::mutex> lock(mutex);
+        return received;
+    }
+
+    static std::string Record(size_t i) {
+        return "callback-" + std::to_string(i);
+    }
+
+    // 未设置分区键时整批由一个线程处理；排序只是让比较不依赖这一点
+    static std::vector<std::string> SortByIndex(std::vector<std::string> records) {
+        std::sort(records.begin(), records.end(), [](const std::string& a, const std::string& b) {
+            return std::stoul(a.substr(a.find('-') + 1)) < std::stoul(b.substr(b.find('-') + 1));
+        });
+        return records;
+    }
+
+    std::string dir_;
+};
+
+// 进程在追加过程中被 SIGKILL：已确认的记录重启后全部按顺序重放，残缺尾部被截掉
+TEST_F(DurableQueueTest, AcknowledgedRecordsReplayAfterKill) {
+    int pipe_fds[2];
+    ASSERT_EQ(::pipe(pipe_fds), 0);
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ::close(pipe_fds[0]);
+        DurableQueue queue(dir_, SyncOptions());
+        for (uint32_t i = 0;; ++i) {
+            if (!queue.Append(Record(i))) ::_exit(1);
+            // 确认之后才把序号告诉父进程，模拟向微信返回成功
+            if (::write(pipe_fds[1], &i, sizeof(i)) != sizeof(i)) ::_exit(1);
+        }
+    }
+    ::close(pipe_fds[1]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ::kill(child, SIGKILL);
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFSIGNALED(status));
+
+    uint32_t value = 0;
+    int64_t last_acked = -1;
+    while (::read(pipe_fds[0], &value, sizeof(value)) == sizeof(value)) {
+        last_acked = value;
+    }
+    ::close(pipe_fds[0]);
+    ASSERT_GE(last_acked, 0);
+
+    DurableQueue queue(dir_, SyncOptions());
+    DurableQueueStats stats = queue.GetStats();
+    ASSERT_GE(stats.recovered, static_cast<uint64_t>(last_acked + 1));
+    std::vector<std::string> received = SortByIndex(DrainAll(queue, stats.recovered));
+    ASSERT_EQ(received.size(), stats.recovered);
+    for (size_t i = 0; i < received.size(); ++i) {
+        ASSERT_EQ(received[i], Record(i));
+    }
+}
+
+// 写到一半的尾部记录在启动时被截掉，之后的追加从截断处继续
+TEST_F(DurableQueueTest, TornTailIsTruncated) {
+    {
+        DurableQueue queue(dir_, SyncOptions());
+        for (size_t i = 0; i < 3; ++i) {
+            ASSERT_TRUE(queue.Append(Record(i)));
+        }
+    }
+    std::string segment = dir_ + "/0000000000000000.seg";
+    uintmax_t intact_size = std::filesystem::file_size(segment);
+    {
+        // 头部声明 100 字节，实际只写了 10 字节
+        FILE* file = std::fopen(segment.c_str(), "ab");
+        ASSERT_NE(file, nullptr);
+        uint32_t header[2] = {100, 0};
+        std::fwrite(header, sizeof(header), 1, file);
+        std::fwrite("0123456789", 10, 1, file);
+        std::fclose(file);
+    }
+
+    DurableQueue queue(dir_, SyncOptions());
+    DurableQueueStats stats = queue.GetStats();
+    EXPECT_EQ(stats.truncated, 1u);
+    EXPECT_EQ(stats.recovered, 3u);
+    EXPECT_EQ(std::filesystem::file_size(segment), intact_size);
+
+    ASSERT_TRUE(queue.Append(Record(3)));
+    std::vector<std::string> received = DrainAll(queue, 4);
+    ASSERT_EQ(received.size(), 4u);
+    for (size_t i = 0; i < received.size(); ++i) {
+        EXPECT_EQ(received[i], Record(i));
+    }
+}
+
+// 已提交消费位置的记录重启后不再重放；未提交的（处理失败）全部重放
+TEST_F(DurableQueueTest, CursorSurvivesRestart) {
+    {
+        DurableQueue queue(dir_, SyncOptions());
+        for (size_t i = 0; i < 10; ++i) {
+            ASSERT_TRUE(queue.Append(Record(i)));
+        }
+        ASSERT_EQ(DrainAll(queue, 10).size(), 10u);
+    }
+    {
+        DurableQueue queue(dir_, SyncOptions());
+        EXPECT_EQ(queue.GetStats().recovered, 0u);
+        for (size_t i = 10; i < 15; ++i) {
+            ASSERT_TRUE(queue.Append(Record(i)));
+        }
+        // 消费方一直失败：消费位置不前进
+        std::atomic<int> attempts{0};
+        queue.Start([&](const std::vector<std::string>&) {
+            ++attempts;
+            return false;
+        });
+        while (attempts < 3) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        queue.Stop();
+        EXPECT_EQ(queue.GetStats().delivered, 0u);
+        EXPECT_GE(queue.GetStats().retries, 3u);
+    }
+
+    DurableQueue queue(dir_, SyncOptions());
+    EXPECT_EQ(queue.GetStats().recovered, 5u);
+    std::vector<std::string> received = DrainAll(queue, 5);
+    ASSERT_EQ(received.size(), 5u);
+    for (size_t i = 0; i < received.size(); ++i) {
+        EXPECT_EQ(received[i], Record(10 + i));
+    }
+}
+
+// 跨段写入与消费：已消费完的段被删除，消费位置跨段恢复
+TEST_F(DurableQueueTest, RollsAndRemovesConsumedSegments) {
+    DurableQueueOptions options = SyncOptions();
+    options.segment_bytes = 256;
+    {
+        DurableQueue queue(dir_, options);
+        for (size_t i = 0; i < 100; ++i) {
+            ASSERT_TRUE(queue.Append(Record(i)));
+        }
+        std::vector<std::string> received = DrainAll(queue, 100);
+        ASSERT_EQ(received.size(), 100u);
+        EXPECT_EQ(received.back(), Record(99));
+    }
+    DurableQueue queue(dir_, options);
+    EXPECT_EQ(queue.GetStats().recovered, 0u);
+    size_t segments = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+        segments += entry.path().extension() == ".seg";
+    }
+    EXPECT_EQ(segments, 1u);
+}
+
+// 队列目录的上级目录不存在时逐级创建
+TEST_F(DurableQueueTest, CreatesNestedDirectory) {
+    std::string nested = dir_ + "/a/b/queue";
+    {
+        DurableQueue queue(nested, SyncOptions());
+        ASSERT_TRUE(queue.Append(Record(0)));
+    }
+    DurableQueue queue(nested, SyncOptions());
+    EXPECT_EQ(queue.GetStats().recovered, 1u);
+}
+
+// 按分区键并行消费：同一分区键的记录由同一线程按追加顺序处理
+TEST_F(DurableQueueTest, PartitionKeepsPerKeyOrder) {
+    DurableQueueOptions options = SyncOptions();
+    options.max_batch = 8;
+    options.workers = 4;
+    DurableQueue queue(dir_, options);
+    const size_t keys = 7;
+    const size_t per_key = 50;
+    for (size_t i = 0; i < keys * per_key; ++i) {
+        ASSERT_TRUE(queue.Append("k" + std::to_string(i % keys) + "-" + std::to_string(i / keys)));
+    }
+
+    std::mutex mutex;
+    std::map<std::string, std::vector<size_t>> seen;
+    std::atomic<size_t> total{0};
+    queue.Start(
+        [&](const std::vector<std::string>& records) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& record : records) {
+                size_t dash = record.find('-');
+                seen[record.substr(0, dash)].push_back(std::stoul(record.substr(dash + 1)));
+            }
+            total += records.size();
+            return true;
+        },
+        [](const std::string& record) { return std::hash<std::string>()(record.substr(0, record.find('-'))); });
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (total < keys * per_key && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue.Stop();
+
+    ASSERT_EQ(seen.size(), keys);
+    for (const auto& item : seen) {
+        ASSERT_EQ(item.second.size(), per_key);
+        for (size_t i = 0; i < per_key; ++i) {
+            EXPECT_EQ(item.second[i], i) << item.first;
+        }
+    }
+}
+
+} // namespace
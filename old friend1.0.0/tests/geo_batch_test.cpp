@@ -0,0 +1,92 @@
+#include "util/geo_batch.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+namespace {
+
+// 参考实现：Haversine 公式（long double 计算，作为各实现的比对基准）
+double ReferenceKm(double lat1, double lon1, double lat2, double lon2) {
+    const long double deg_to_rad = 3.141592653589793238462643383279502884L / 180.0L;
+    long double sin_lat = std::sin((static_cast<long double>(lat2) - lat1) * deg_to_rad / 2);
+    long double sin_lon = std::sin((static_cast<long double>(lon2) - lon1) * deg_to_rad / 2);
+    long double a = sin_lat * sin_lat +
+                    std::cos(lat1 * deg_to_rad) * std::cos(lat2 * deg_to_rad) * sin_lon * sin_lon;
+    long double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+    return static_cast<double>(GeoUtil::kEarthRadiusKm * c);
+}
+
+class GeoBatchTest : public ::testing::TestWithParam<GeoBatch::Kernel> {
+protected:
+    // 在原点附近 span 度范围内随机撒点（覆盖级数分支与 std::asin 回退分支）
+    static GeoPointArray RandomPoints(double lat, double lon, double span, size_t n, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> offset(-span, span);
+        GeoPointArray points;
+        points.Reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            points.Add(std::max(-90.0, std::min(90.0, lat + offset(rng))), lon + offset(rng));
+        }
+        return points;
+    }
+
+    // 对比每个候选点的距离：绝对误差不超过 1mm，远距离时相对误差不超过 1e-12
+    static void ExpectMatchesReference(GeoBatch::Kernel kernel, double lat, double lon, const GeoPointArray& points) {
+        std::vector<double> out;
+        GeoBatch::DistancesKmWith(kernel, lat, lon, points, out);
+        ASSERT_EQ(out.size(), points.Size());
+        for (size_t i = 0; i < points.Size(); ++i) {
+            double expected = ReferenceKm(lat, lon, points.latitude[i], points.longitude[i]);
+            EXPECT_NEAR(out[i], expected, std::max(1e-6, expected * 1e-12))
+                << "i=" << i << " lat=" << points.latitude[i] << " lon=" << points.longitude[i];
+        }
+    }
+};
+
+// 同城范围（几十公里内，走级数分支）
+TEST_P(GeoBatchTest, MatchesReferenceWithinCity) {
+    ExpectMatchesReference(GetParam(), 39.9042, 116.4074, RandomPoints(39.9042, 116.4074, 0.5, 10007, 1));
+}
+
+// 跨省与跨半球（走 std::asin 回退分支），条数不是向量宽度的整数倍以覆盖尾部
+TEST_P(GeoBatchTest, MatchesReferenceFarAway) {
+    ExpectMatchesReference(GetParam(), 31.2304, 121.4737, RandomPoints(31.2304, 121.4737, 60.0, 10007, 2));
+}
+
+// 边界：同一点、级数上限附近、对跖点、极点
+TEST_P(GeoBatchTest, EdgeCases) {
+    GeoPointArray points;
+    points.Add(22.5431, 114.0579);
+    points.Add(22.5431 + 5.73, 114.0579);
+    points.Add(22.5431 + 5.74, 114.0579);
+    points.Add(-22.5431, 114.0579 - 180.0);
+    points.Add(90.0, 0.0);
+    points.Add(-90.0, 0.0);
+    ExpectMatchesReference(GetParam(), 22.5431, 114.0579, points);
+
+    std::vector<double> out;
+    GeoBatch::DistancesKmWith(GetParam(), 22.5431, 114.0579, points, out);
+    EXPECT_EQ(out[0], 0.0);
+}
+
+// 与 GeoUtil::HaversineKm 一致（业务代码中两者混用，排序结果不能因实现不同而变化）
+TEST_P(GeoBatchTest, MatchesGeoUtil) {
+    GeoPointArray points = RandomPoints(30.5728, 104.0668, 2.0, 1001, 3);
+    std::vector<double> out;
+    GeoBatch::DistancesKmWith(GetParam(), 30.5728, 104.0668, points, out);
+    for (size_t i = 0; i < points.Size(); ++i) {
+        EXPECT_NEAR(out[i], GeoUtil::HaversineKm(30.5728, 104.0668, points.latitude[i], points.longitude[i]), 1e-6);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, GeoBatchTest,
+                         ::testing::Values(GeoBatch::Kernel::SCALAR, GeoBatch::Kernel::SSE2, GeoBatch::Kernel::AVX2),
+                         [](const ::testing::TestParamInfo<GeoBatch::Kernel>& info) {
+                             switch (info.param) {
+                                 case GeoBatch::Kernel::SCALAR: return std::string("Scalar");
+                                 case GeoBatch::Kernel::SSE2: return std::string("Sse2");
+                                 default: return std::string("Avx2");
+                             }
+                         });
+
+} // namespace
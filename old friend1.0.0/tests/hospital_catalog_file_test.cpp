@@ -0,0 +1,79 @@
+#include "service/hospital_catalog_file.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+class HospitalCatalogFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (std::filesystem::temp_directory_path() /
+                 ("hospital_catalog_test." + std::to_string(::getpid()) + ".bin")).string();
+        std::vector<Hospital> hospitals(3);
+        for (size_t i = 0; i < hospitals.size(); ++i) {
+            hospitals[i].id = "H" + std::to_string(i);
+            hospitals[i].name = "医院" + std::to_string(i);
+            hospitals[i].latitude = 31.0 + i;
+            hospitals[i].longitude = 121.0 + i;
+            hospitals[i].reserve_days = {"2026-10-20", "2026-10-21"};
+            hospitals[i].departments = {"内科"};
+        }
+        hospitals[2].departments.push_back("外科");
+        HospitalCatalogFileWriter::Write(path_, hospitals, 7);
+    }
+
+    void TearDown() override { std::filesystem::remove(path_); }
+
+    hospital_catalog_file::Header ReadHeader() const {
+        hospital_catalog_file::Header header;
+        std::ifstream in(path_, std::ios::binary);
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        return header;
+    }
+
+    // 在文件 offset 处覆盖写入（模拟损坏）
+    template <typename T>
+    void Overwrite(uint64_t offset, const T& value) const {
+        std::fstream io(path_, std::ios::binary | std::ios::in | std::ios::out);
+        io.seekp(static_cast<std::streamoff>(offset));
+        io.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    std::string path_;
+};
+
+TEST_F(HospitalCatalogFileTest, ReadsFieldsAndPostings) {
+    MappedHospitalCatalog catalog(path_, true);
+    EXPECT_EQ(catalog.CatalogVersion(), 7u);
+    ASSERT_EQ(catalog.HospitalCount(), 3u);
+    EXPECT_EQ(catalog.Field(1, hospital_catalog_file::NAME), "医院1");
+    uint32_t count = 0;
+    const uint32_t* postings = catalog.Postings("外科", count);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(postings[0], 2u);
+    catalog.Postings("眼科", count);
+    EXPECT_EQ(count, 0u);
+}
+
+TEST_F(HospitalCatalogFileTest, RejectsStringRefOutOfTable) {
+    hospital_catalog_file::Header header = ReadHeader();
+    hospital_catalog_file::StrRef bad{static_cast<uint32_t>(header.string_table_size), 16};
+    Overwrite(header.strings_off, bad);
+    EXPECT_THROW(MappedHospitalCatalog catalog(path_), std::runtime_error);
+}
+
+TEST_F(HospitalCatalogFileTest, RejectsPostingOutOfRange) {
+    hospital_catalog_file::Header header = ReadHeader();
+    Overwrite(header.postings_off, static_cast<uint32_t>(header.hospital_count));
+    EXPECT_THROW(MappedHospitalCatalog catalog(path_), std::runtime_error);
+}
+
+TEST_F(HospitalCatalogFileTest, RejectsDayListOutOfRange) {
+    hospital_catalog_file::Header header = ReadHeader();
+    hospital_catalog_file::ListRef bad{header.day_ref_count, 1};
+    Overwrite(header.day_lists_off, bad);
+    EXPECT_THROW(MappedHospitalCatalog catalog(path_), std::runtime_error);
+}
+
+} // namespace
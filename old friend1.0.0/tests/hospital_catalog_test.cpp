@@ -0,0 +1,107 @@
+#include "service/hospital_catalog.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+
+namespace {
+
+// 数据库加载与文件加载得到的快照应当对外一致；文件快照直接引用映射，医院对象按需还原
+class HospitalCatalogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (std::filesystem::temp_directory_path() /
+                 ("hospital_catalog_snapshot_test." + std::to_string(::getpid()) + ".bin")).string();
+        hospitals_.resize(40);
+        for (size_t i = 0; i < hospitals_.size(); ++i) {
+            Hospital& hosp = hospitals_[i];
+            hosp.id = "H" + std::to_string(i);
+            hosp.name = "医院" + std::to_string(i);
+            hosp.level = i % 3 == 0 ? "三级甲等" : "二级甲等";
+            hosp.opening_hours = "周一至周五 08:00-17:00";
+            hosp.latitude = 31.2 + 0.003 * static_cast<double>(i);
+            hosp.longitude = 121.4 - 0.002 * static_cast<double>(i);
+            hosp.available_quota = static_cast<int>(i % 4);
+            hosp.reserve_days = {"2026-10-20"};
+            hosp.departments = {"内科"};
+            if (i % 2 == 0) hosp.departments.push_back("儿科");
+            if (i % 5 == 0) hosp.departments.push_back("内科"); // 重复填写只计一次
+        }
+        HospitalCatalog& catalog = HospitalCatalog::GetInstance();
+        catalog.Configure([this] { return hospitals_; });
+        ASSERT_TRUE(catalog.Refresh());
+        db_ = catalog.Snapshot();
+        catalog.ExportToFile(path_);
+        ASSERT_TRUE(catalog.LoadFromFile(path_));
+        file_ = catalog.Snapshot();
+    }
+
+    void TearDown() override { std::filesystem::remove(path_); }
+
+    std::string path_;
+    std::vector<Hospital> hospitals_;
+    std::shared_ptr<const HospitalCatalogSnapshot> db_;
+    std::shared_ptr<const HospitalCatalogSnapshot> file_;
+};
+
+TEST_F(HospitalCatalogTest, FileSnapshotServesFromMapping) {
+    ASSERT_TRUE(file_->file != nullptr);
+    EXPECT_TRUE(file_->hospitals.empty());
+    EXPECT_GT(file_->version, db_->version);
+    ASSERT_EQ(file_->Size(), db_->Size());
+    EXPECT_EQ(file_->departments, db_->departments);
+
+    for (const auto& department : {"内科", "儿科", "眼科"}) {
+        HospitalRows file_rows = file_->RowsOf(department);
+        HospitalRows db_rows = db_->RowsOf(department);
+        EXPECT_EQ(std::vector<uint32_t>(file_rows.begin(), file_rows.end()),
+                  std::vector<uint32_t>(db_rows.begin(), db_rows.end()));
+    }
+    uint32_t row = 0;
+    ASSERT_TRUE(file_->FindRow("H7", row));
+    EXPECT_EQ(row, 7u);
+    EXPECT_EQ(file_->IdOf(row), "H7");
+    EXPECT_EQ(file_->AvailableQuotaOf(row), 3);
+    EXPECT_FALSE(file_->FindRow("H404", row));
+    // 按 ID、倒排与筛选查询都不需要还原医院对象
+    for (uint32_t r = 0; r < file_->Size(); ++r) {
+        EXPECT_EQ(file_->materialized[r].load(), nullptr);
+    }
+}
+
+TEST_F(HospitalCatalogTest, MaterializesRowsOnFirstAccess) {
+    const Hospital& hosp = file_->At(10);
+    EXPECT_EQ(&file_->At(10), &hosp); // 只还原一次
+    EXPECT_EQ(hosp.id, "H10");
+    EXPECT_EQ(hosp.name, "医院10");
+    EXPECT_EQ(hosp.level, db_->At(10).level);
+    EXPECT_DOUBLE_EQ(hosp.latitude, db_->At(10).latitude);
+    EXPECT_EQ(hosp.reserve_days, db_->At(10).reserve_days);
+    EXPECT_EQ(hosp.departments, (std::vector<std::string>{"儿科", "内科"}));
+    EXPECT_EQ(file_->FindHospital("H10"), &hosp);
+    EXPECT_EQ(file_->materialized[11].load(), nullptr);
+}
+
+TEST_F(HospitalCatalogTest, IndexesMatchDatabaseSnapshot) {
+    auto file_hits = file_->geo_index->QueryNearest("儿科", 31.25, 121.37, 5);
+    auto db_hits = db_->geo_index->QueryNearest("儿科", 31.25, 121.37, 5);
+    ASSERT_EQ(file_hits.size(), db_hits.size());
+    for (size_t i = 0; i < file_hits.size(); ++i) {
+        EXPECT_EQ(file_hits[i].row, db_hits[i].row);
+    }
+
+    HospitalFilter filter;
+    filter.department = "内科";
+    filter.levels = {"三级甲等"};
+    filter.available_only = true;
+    std::vector<uint64_t> file_bits, db_bits;
+    EXPECT_EQ(file_->filter_table.Match(filter, file_bits), db_->filter_table.Match(filter, db_bits));
+    EXPECT_EQ(file_bits, db_bits);
+}
+
+// 快照持有映射：文件被替换或删除后，已发布的快照仍可读取
+TEST_F(HospitalCatalogTest, SnapshotOutlivesFile) {
+    std::filesystem::remove(path_);
+    EXPECT_EQ(file_->At(3).name, "医院3");
+    EXPECT_EQ(file_->IdOf(39), "H39");
+}
+
+} // namespace
@@ -0,0 +1,158 @@
+#include "service/hospital_filter_table.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+
+namespace {
+
+/**
+ * 随机医院表：行数不是 64 的倍数（最后一个位图字带补齐行）；
+ * 等级列有 300 个不同取值，超出 254 个的行编码为溢出码 255
+ */
+struct RandomTable {
+    std::vector<std::string> levels;
+    std::vector<std::string> types;
+    std::vector<std::string> statuses;
+    std::vector<std::string> opening_hours;
+    std::vector<uint8_t> elderly;
+    std::vector<int> quota;
+    std::set<std::string> encoded_levels;   // 字典中的前 254 个等级（可作为筛选条件）
+
+    explicit RandomTable(size_t rows, uint32_t seed) {
+        std::mt19937 rng(seed);
+        static const char* const kTypes[] = {"综合医院", "专科医院", "中医医院", "社区卫生服务中心", "妇幼保健院"};
+        static const char* const kStatuses[] = {"enabled", "disabled", "maintenance"};
+        static const char* const kHours[] = {"周一至周五 8:00-17:00", "24小时", "每天 8:00-12:00，14:00-17:30", ""};
+        for (size_t i = 0; i < rows; ++i) {
+            // 前 300 行依次出现 300 个不同等级，之后在其中随机取
+            size_t level = i < 300 ? i : rng() % 300;
+            levels.push_back("L" + std::to_string(level));
+            types.push_back(kTypes[rng() % 5]);
+            statuses.push_back(kStatuses[rng() % 3]);
+            opening_hours.push_back(kHours[rng() % 4]);
+            elderly.push_back(static_cast<uint8_t>(rng() % 2));
+            quota.push_back(static_cast<int>(rng() % 3));
+        }
+        for (size_t i = 0; i < 254 && i < rows; ++i) encoded_levels.insert(levels[i]);
+    }
+
+    HospitalFilterTable Build() const {
+        return HospitalFilterTable(levels.size(), [this](size_t i) {
+            HospitalFilterRow row;
+            row.level = levels[i];
+            row.type = types[i];
+            row.status = statuses[i];
+            row.opening_hours = opening_hours[i];
+            row.elderly_friendly = elderly[i] != 0;
+            row.available_quota = quota[i];
+            row.latitude = 31.0 + 0.001 * static_cast<double>(i % 100);
+            row.longitude = 121.0 + 0.001 * static_cast<double>(i / 100);
+            return row;
+        });
+    }
+
+    // 逐行按字符串判断（溢出码的取值不能作为筛选条件）
+    std::vector<uint64_t> Expected(const HospitalFilter& filter) const {
+        auto in = [](const std::vector<std::string>& values, const std::string& value) {
+            return values.empty() || std::find(values.begin(), values.end(), value) != values.end();
+        };
+        std::vector<uint64_t> bits((levels.size() + 63) / 64, 0);
+        for (size_t i = 0; i < levels.size(); ++i) {
+            bool level_ok = filter.levels.empty() ||
+                            (encoded_levels.count(levels[i]) > 0 && in(filter.levels, levels[i]));
+            if (level_ok && in(filter.types, types[i]) && in(filter.statuses, statuses[i]) &&
+                (!filter.elderly_friendly_only || elderly[i]) && (!filter.available_only || quota[i] > 0)) {
+                bits[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        return bits;
+    }
+};
+
+std::vector<HospitalFilterTable::Kernel> Kernels() {
+    std::vector<HospitalFilterTable::Kernel> kernels = {HospitalFilterTable::Kernel::SCALAR};
+    if (HospitalFilterTable::ActiveKernel() >= HospitalFilterTable::Kernel::SSE2) {
+        kernels.push_back(HospitalFilterTable::Kernel::SSE2);
+    }
+    if (HospitalFilterTable::ActiveKernel() >= HospitalFilterTable::Kernel::AVX2) {
+        kernels.push_back(HospitalFilterTable::Kernel::AVX2);
+    }
+    return kernels;
+}
+
+size_t PopCount(const std::vector<uint64_t>& bits) {
+    size_t count = 0;
+    for (uint64_t word : bits) count += static_cast<size_t>(__builtin_popcountll(word));
+    return count;
+}
+
+// 各实现（标量/SSE2/AVX2）结果与逐行判断一致：覆盖单值、少量取值（SIMD 比较）、
+// 超过 8 个取值（查表）、布尔标志与多列组合；补齐行从不命中
+TEST(HospitalFilterTableTest, KernelsAgreeWithRowByRowEvaluation) {
+    const size_t rows = 1000;  // 15 个整字 + 40 行的尾字（24 个补齐行）
+    RandomTable data(rows, 7);
+    HospitalFilterTable table = data.Build();
+
+    std::vector<HospitalFilter> filters(8);
+    filters[1].types = {"综合医院"};
+    filters[2].types = {"综合医院", "中医医院", "妇幼保健院"};
+    filters[3].levels = {"L1", "L2", "L3", "L4", "L5", "L6", "L7", "L8", "L9", "L10", "L200"};  // 查表
+    filters[4].elderly_friendly_only = true;
+    filters[4].available_only = true;
+    filters[5].levels = {"L3", "L17"};
+    filters[5].statuses = {"enabled", "maintenance"};
+    filters[5].types = {"专科医院", "社区卫生服务中心"};
+    filters[5].elderly_friendly_only = true;
+    // 第 254 个之后的等级为溢出码：与可编码的取值混在一起时只按可编码的命中
+    filters[6].levels = {"L20", "L260", "L299"};
+    filters[7].levels = {"L0", "L1", "L2", "L3", "L4", "L5", "L6", "L7", "L8", "L9", "L260"};
+    filters[7].available_only = true;
+
+    for (size_t f = 0; f < filters.size(); ++f) {
+        std::vector<uint64_t> expected = data.Expected(filters[f]);
+        for (auto kernel : Kernels()) {
+            std::vector<uint64_t> bits;
+            size_t count = table.MatchWith(kernel, filters[f], bits);
+            EXPECT_EQ(bits, expected) << "filter " << f << " kernel " << static_cast<int>(kernel);
+            EXPECT_EQ(count, PopCount(expected)) << "filter " << f << " kernel " << static_cast<int>(kernel);
+            EXPECT_EQ(bits.back() >> (rows % 64), 0u) << "padding rows matched, filter " << f;
+        }
+    }
+}
+
+// 只包含溢出取值（或不存在的取值）的条件不会命中任何行，即使表中有编码为 255 的行
+TEST(HospitalFilterTableTest, OverflowValuesNeverMatch) {
+    RandomTable data(700, 11);
+    HospitalFilterTable table = data.Build();
+    EXPECT_EQ(table.Levels().size(), 254u);
+
+    HospitalFilter filter;
+    filter.levels = {"L254", "L299"};
+    for (auto kernel : Kernels()) {
+        std::vector<uint64_t> bits;
+        EXPECT_EQ(table.MatchWith(kernel, filter, bits), 0u);
+        EXPECT_EQ(PopCount(bits), 0u);
+    }
+    filter.levels = {"不存在的等级"};
+    std::vector<uint64_t> bits;
+    EXPECT_EQ(table.Match(filter, bits), 0u);
+}
+
+// 行数为 64 的倍数与小于一个字时同样一致
+TEST(HospitalFilterTableTest, KernelsAgreeOnWordBoundaries) {
+    for (size_t rows : {1u, 63u, 64u, 65u, 128u}) {
+        RandomTable data(rows, static_cast<uint32_t>(rows));
+        HospitalFilterTable table = data.Build();
+        HospitalFilter filter;
+        filter.types = {"综合医院", "专科医院"};
+        filter.available_only = true;
+        std::vector<uint64_t> expected = data.Expected(filter);
+        for (auto kernel : Kernels()) {
+            std::vector<uint64_t> bits;
+            table.MatchWith(kernel, filter, bits);
+            EXPECT_EQ(bits, expected) << "rows " << rows << " kernel " << static_cast<int>(kernel);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,112 @@
+#include "service/hospital_geo_index.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+namespace {
+
+// 在 (lat, lon) 附近 span 度范围内随机撒点，行号为 row_base + i（模拟快照中不连续的行号）
+void RandomDepartment(double lat, double lon, double span, size_t n, uint32_t seed, uint32_t row_base,
+                      std::vector<uint32_t>& rows, GeoPointArray& points) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> offset(-span, span);
+    for (size_t i = 0; i < n; ++i) {
+        rows.push_back(row_base + static_cast<uint32_t>(i) * 3);
+        points.Add(lat + offset(rng), lon + offset(rng));
+    }
+}
+
+// 参考实现：全量计算距离后排序
+std::vector<HospitalGeoIndex::Hit> ScanAndSort(const std::vector<uint32_t>& rows, const GeoPointArray& points,
+                                                double lat, double lon) {
+    std::vector<double> distances;
+    GeoBatch::DistancesKm(lat, lon, points, distances);
+    std::vector<HospitalGeoIndex::Hit> hits(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) hits[i] = HospitalGeoIndex::Hit{rows[i], distances[i]};
+    std::sort(hits.begin(), hits.end(), [](const HospitalGeoIndex::Hit& a, const HospitalGeoIndex::Hit& b) {
+        return a.distance < b.distance;
+    });
+    return hits;
+}
+
+void ExpectSameHits(const std::vector<HospitalGeoIndex::Hit>& actual,
+                    const std::vector<HospitalGeoIndex::Hit>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_DOUBLE_EQ(actual[i].distance, expected[i].distance) << "i=" << i;
+        if (actual[i].distance != expected[i].distance) return;
+    }
+}
+
+// 环形扩展 + 下界剪枝的 k 近邻与全量排序一致：查询点覆盖网格内部、格子边界与网格外远处
+TEST(HospitalGeoIndexTest, NearestMatchesScanAndSort) {
+    std::vector<uint32_t> rows;
+    GeoPointArray points;
+    RandomDepartment(31.2, 121.4, 0.5, 2000, 7, 5, rows, points);
+    HospitalGeoIndex index(0.02);
+    index.AddDepartment("内科", rows, points);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> offset(-0.8, 0.8);
+    std::vector<std::pair<double, double>> origins = {
+        {31.2, 121.4}, {31.20, 121.42}, {31.0 + 1e-12, 121.0}, {29.0, 118.0}, {31.2, 125.0}};
+    for (int i = 0; i < 30; ++i) origins.emplace_back(31.2 + offset(rng), 121.4 + offset(rng));
+
+    for (const auto& origin : origins) {
+        auto expected = ScanAndSort(rows, points, origin.first, origin.second);
+        for (size_t k : {1u, 10u, 57u}) {
+            auto hits = index.QueryNearest("内科", origin.first, origin.second, k);
+            ExpectSameHits(hits, std::vector<HospitalGeoIndex::Hit>(expected.begin(), expected.begin() + k));
+        }
+    }
+}
+
+// 命中的是快照行号：与输入的 rows 对应，而不是索引内部的排序下标
+TEST(HospitalGeoIndexTest, HitsCarrySnapshotRows) {
+    std::vector<uint32_t> rows = {42, 7, 19};
+    GeoPointArray points;
+    points.Add(31.30, 121.40);
+    points.Add(31.20, 121.40);
+    points.Add(31.25, 121.40);
+    HospitalGeoIndex index;
+    index.AddDepartment("内科", rows, points);
+
+    auto hits = index.QueryNearest("内科", 31.20, 121.40, 3);
+    ASSERT_EQ(hits.size(), 3u);
+    EXPECT_EQ(hits[0].row, 7u);
+    EXPECT_EQ(hits[1].row, 19u);
+    EXPECT_EQ(hits[2].row, 42u);
+    EXPECT_THROW(index.AddDepartment("外科", {1, 2}, points), std::invalid_argument);
+}
+
+// k 超过科室医院数时返回全部；未知科室与 k == 0 返回空
+TEST(HospitalGeoIndexTest, NearestEdgeCases) {
+    std::vector<uint32_t> rows;
+    GeoPointArray points;
+    RandomDepartment(39.9, 116.4, 0.2, 20, 3, 0, rows, points);
+    HospitalGeoIndex index;
+    index.AddDepartment("儿科", rows, points);
+
+    ExpectSameHits(index.QueryNearest("儿科", 39.9, 116.4, 100), ScanAndSort(rows, points, 39.9, 116.4));
+    EXPECT_TRUE(index.QueryNearest("儿科", 39.9, 116.4, 0).empty());
+    EXPECT_TRUE(index.QueryNearest("眼科", 39.9, 116.4, 5).empty());
+}
+
+// 半径查询与全量过滤一致
+TEST(HospitalGeoIndexTest, WithinRadiusMatchesScan) {
+    std::vector<uint32_t> rows;
+    GeoPointArray points;
+    RandomDepartment(31.2, 121.4, 0.5, 2000, 5, 0, rows, points);
+    HospitalGeoIndex index(0.02);
+    index.AddDepartment("内科", rows, points);
+
+    for (double radius : {0.5, 3.0, 20.0, 200.0}) {
+        auto expected = ScanAndSort(rows, points, 31.21, 121.39);
+        expected.erase(std::find_if(expected.begin(), expected.end(),
+                           [radius](const HospitalGeoIndex::Hit& hit) { return hit.distance > radius; }),
+                       expected.end());
+        ExpectSameHits(index.QueryWithinRadius("内科", 31.21, 121.39, radius), expected);
+    }
+}
+
+} // namespace
@@ -0,0 +1,156 @@
+#include "service/hospital_filter_table.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+
+namespace {
+
+// 目录中 H0/H1 的 available_quota > 0（近似值），实时号源中只有 H1、H2 在查询日期有号
+class HospitalSearchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        hospitals_.resize(3);
+        for (size_t i = 0; i < hospitals_.size(); ++i) {
+            hospitals_[i].id = "H" + std::to_string(i);
+            hospitals_[i].latitude = 31.20 + 0.01 * i;
+            hospitals_[i].longitude = 121.40;
+            hospitals_[i].departments = {"内科"};
+            hospitals_[i].available_quota = i < 2 ? 10 : 0;
+            rows_.push_back(static_cast<uint32_t>(i));
+            points_.Add(hospitals_[i].latitude, hospitals_[i].longitude);
+        }
+        options_.available_only = true;
+        has_quota_ = [this](uint32_t row) { return hospitals_[row].id != "H0"; };
+        catalog_quota_ = [this](uint32_t row) { return hospitals_[row].available_quota > 0; };
+    }
+
+    auto IdAt() const {
+        return [this](uint32_t row) { return std::string_view(hospitals_[row].id); };
+    }
+
+    std::set<std::string> Ids(const std::vector<HospitalSearchHit>& hits) const {
+        std::set<std::string> ids;
+        for (const auto& hit : hits) ids.insert(hospitals_[hit.row].id);
+        return ids;
+    }
+
+    std::vector<Hospital> hospitals_;
+    std::vector<uint32_t> rows_;
+    GeoPointArray points_;
+    HospitalSearchOptions options_;
+    HospitalQuotaPredicate has_quota_;       // 实时号源
+    HospitalQuotaPredicate catalog_quota_;   // 目录中的近似值
+};
+
+TEST_F(HospitalSearchTest, SearchUsesQuotaPredicateWhenGiven) {
+    std::vector<HospitalSearchHit> hits;
+    std::string cursor;
+    EXPECT_EQ(HospitalSearcher::Search(rows_, points_, 31.2, 121.4, options_, IdAt(), hits, cursor,
+                                       catalog_quota_), 2u);
+    EXPECT_EQ(Ids(hits), (std::set<std::string>{"H0", "H1"}));
+
+    EXPECT_EQ(HospitalSearcher::Search(rows_, points_, 31.2, 121.4, options_, IdAt(), hits, cursor, has_quota_), 2u);
+    EXPECT_EQ(Ids(hits), (std::set<std::string>{"H1", "H2"}));
+
+    // 只看有号源却不提供判断属于调用错误
+    EXPECT_THROW(HospitalSearcher::Search(rows_, points_, 31.2, 121.4, options_, IdAt(), hits, cursor),
+                 std::invalid_argument);
+}
+
+TEST_F(HospitalSearchTest, FilterTableUsesQuotaPredicateWhenGiven) {
+    HospitalFilterTable table(hospitals_);
+    HospitalFilter filter;
+    filter.department = "内科";
+    filter.available_only = true;
+    std::vector<HospitalSearchHit> hits;
+    std::string cursor;
+    EXPECT_EQ(table.Search(filter, 31.2, 121.4, options_, IdAt(), hits, cursor), 2u);
+    EXPECT_EQ(Ids(hits), (std::set<std::string>{"H0", "H1"}));
+
+    EXPECT_EQ(table.Search(filter, 31.2, 121.4, options_, IdAt(), hits, cursor, has_quota_), 2u);
+    EXPECT_EQ(Ids(hits), (std::set<std::string>{"H1", "H2"}));
+}
+
+// 距离相同的医院按ID排序，逐页翻完每家恰好出现一次（游标为 (距离, ID)，严格大于上一页最后一条）
+TEST(HospitalSearcherTest, CursorBreaksDistanceTiesById) {
+    std::vector<Hospital> hospitals(7);
+    std::vector<uint32_t> rows;
+    GeoPointArray points;
+    for (size_t i = 0; i < hospitals.size(); ++i) {
+        hospitals[i].id = "T" + std::to_string((i * 5) % 7); // 乱序写入
+        hospitals[i].latitude = i < 5 ? 31.21 : 31.25;        // 前 5 家距离完全相同
+        hospitals[i].longitude = 121.40;
+        rows.push_back(static_cast<uint32_t>(i));
+        points.Add(hospitals[i].latitude, hospitals[i].longitude);
+    }
+    HospitalSearchOptions options;
+    options.limit = 2;
+    std::vector<std::string> seen;
+    std::vector<size_t> totals;
+    std::vector<HospitalSearchHit> hits;
+    std::string next_cursor;
+    auto id_at = [&hospitals](uint32_t row) { return std::string_view(hospitals[row].id); };
+    do {
+        totals.push_back(HospitalSearcher::Search(rows, points, 31.2, 121.4, options, id_at, hits, next_cursor));
+        for (const auto& hit : hits) seen.push_back(hospitals[hit.row].id);
+        options.cursor = next_cursor;
+    } while (!next_cursor.empty());
+
+    // 同距离的 5 家按 ID 升序，之后是较远的 2 家
+    std::vector<std::string> tied(seen.begin(), seen.begin() + 5);
+    EXPECT_TRUE(std::is_sorted(tied.begin(), tied.end()));
+    EXPECT_EQ(std::set<std::string>(seen.begin(), seen.end()).size(), 7u);
+    EXPECT_EQ(seen.size(), 7u);
+    EXPECT_EQ(totals, (std::vector<size_t>{7, 5, 3, 1}));
+}
+
+// 超出 max_distance_km 的医院既不返回也不计入总数
+TEST_F(HospitalSearchTest, MaxDistanceExcludesFartherHospitals) {
+    options_.available_only = false;
+    options_.max_distance_km = 1.5; // H0 0km，H1 约 1.1km，H2 约 2.2km
+    std::vector<HospitalSearchHit> hits;
+    std::string cursor;
+    EXPECT_EQ(HospitalSearcher::Search(rows_, points_, 31.2, 121.4, options_, IdAt(), hits, cursor), 2u);
+    EXPECT_EQ(Ids(hits), (std::set<std::string>{"H0", "H1"}));
+    EXPECT_TRUE(cursor.empty());
+}
+
+// limit == 0：只统计总数，不返回命中，也不生成游标
+TEST_F(HospitalSearchTest, ZeroLimitOnlyCounts) {
+    options_.available_only = false;
+    options_.limit = 0;
+    std::vector<HospitalSearchHit> hits;
+    std::string cursor;
+    EXPECT_EQ(HospitalSearcher::Search(rows_, points_, 31.2, 121.4, options_, IdAt(), hits, cursor), 3u);
+    EXPECT_TRUE(hits.empty());
+    EXPECT_TRUE(cursor.empty());
+}
+
+// 号源判断在距离与游标过滤之后：翻页时游标之前、距离上限之外的医院不再调用 has_quota
+TEST_F(HospitalSearchTest, QuotaPredicateRunsAfterDistanceAndCursor) {
+    std::vector<std::string> asked;
+    auto has_quota = [this, &asked](uint32_t row) {
+        asked.push_back(hospitals_[row].id);
+        return true;
+    };
+    options_.limit = 1;
+    options_.max_distance_km = 1.5;
+    std::vector<HospitalSearchHit> hits;
+    std::string cursor;
+    EXPECT_EQ(HospitalSearcher::Search(rows_, points_, 31.2, 121.4, options_, IdAt(), hits, cursor, has_quota), 2u);
+    EXPECT_EQ(asked, (std::vector<std::string>{"H0", "H1"}));
+
+    asked.clear();
+    options_.cursor = cursor;
+    EXPECT_EQ(HospitalSearcher::Search(rows_, points_, 31.2, 121.4, options_, IdAt(), hits, cursor, has_quota), 1u);
+    EXPECT_EQ(asked, (std::vector<std::string>{"H1"}));
+
+    asked.clear();
+    HospitalFilterTable table(hospitals_);
+    HospitalFilter filter;
+    filter.available_only = true;
+    EXPECT_EQ(table.Search(filter, 31.2, 121.4, options_, IdAt(), hits, cursor, has_quota), 1u);
+    EXPECT_EQ(asked, (std::vector<std::string>{"H1"}));
+}
+
+} // namespace
@@ -0,0 +1,117 @@
+#include "util/id_generator.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+namespace {
+
+constexpr int64_t kStartMs = 1790000000000LL;  // 2026-09 前后
+
+// 多线程发号无重复；同一线程内严格递增；节点号写入每个ID
+TEST(IdGeneratorTest, NoDuplicatesAcrossThreads) {
+    IdGenerator generator(37, nullptr);
+    const int threads = 8;
+    const size_t per_thread = 100000;
+    std::vector<std::vector<uint64_t>> ids(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            ids[t].reserve(per_thread);
+            for (size_t i = 0; i < per_thread; ++i) ids[t].push_back(generator.Next());
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    std::vector<uint64_t> all;
+    for (const auto& values : ids) {
+        EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+    EXPECT_EQ(IdGenerator::NodeIdOf(all.front()), 37u);
+    EXPECT_EQ(IdGenerator::NodeIdOf(all.back()), 37u);
+}
+
+// 时钟回拨：继续沿用已发出的最大时间递增，不重号；时钟追上后ID时间随墙钟前进
+TEST(IdGeneratorTest, ClockSkewNeverRepeatsIds) {
+    std::atomic<int64_t> now{kStartMs};
+    IdGenerator generator(1, [&] { return now.load(); });
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < 5000; ++i) {
+        ids.push_back(generator.Next());
+        now += 1;
+    }
+    now -= 60000;  // 回拨 1 分钟
+    for (int i = 0; i < 5000; ++i) {
+        ids.push_back(generator.Next());
+        now += 20;
+    }
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+    EXPECT_EQ(std::adjacent_find(ids.begin(), ids.end()), ids.end());
+    EXPECT_LE(IdGenerator::TimestampMsOf(ids.back()), now.load() + IdGenerator::kMaxAheadMs);
+
+    // 墙钟追上后，新租用的序号块从当前时间开始（线程局部块最多 256 个序号）
+    now += 10000;
+    uint64_t last = 0;
+    for (int i = 0; i <= 256; ++i) last = generator.Next();
+    EXPECT_GT(last, ids.back());
+    EXPECT_GE(IdGenerator::TimestampMsOf(last), now.load());
+}
+
+// 同一毫秒内超过上限：借用未来时间到 kMaxAheadMs 后等待时钟前进，不重号
+TEST(IdGeneratorTest, WaitsForClockWhenAheadLimitIsReached) {
+    std::atomic<int64_t> now{kStartMs};
+    IdGenerator generator(1, [&] { return now.load(); });
+    // 启动时从 当前时间 + kMaxAheadMs 开始发号，时钟不动时只剩 1 毫秒的序号
+    const size_t per_ms = size_t(1) << IdGenerator::kSequenceBits;
+    uint64_t last = 0;
+    for (size_t i = 0; i < per_ms; ++i) last = generator.Next();
+
+    std::atomic<bool> issued{false};
+    uint64_t next = 0;
+    std::thread waiter([&] {
+        next = generator.Next();
+        issued = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(issued.load());
+    now += 1;
+    waiter.join();
+    EXPECT_GT(next, last);
+    EXPECT_EQ(IdGenerator::TimestampMsOf(next), kStartMs + IdGenerator::kMaxAheadMs + 1);
+}
+
+// 多个实例在同一线程交替发号：线程局部区间按实例区分，不会用另一个实例租到的序号
+TEST(IdGeneratorTest, ThreadLocalBlocksAreOwnedByInstance) {
+    std::atomic<int64_t> now{kStartMs};
+    IdGenerator a(1, [&] { return now.load(); });
+    IdGenerator b(1, [&] { return now.load(); });
+    std::vector<uint64_t> from_a, from_b;
+    for (int i = 0; i < 10; ++i) {
+        from_a.push_back(a.Next());
+        from_b.push_back(b.Next());
+    }
+    EXPECT_TRUE(std::is_sorted(from_a.begin(), from_a.end()));
+    EXPECT_EQ(std::adjacent_find(from_a.begin(), from_a.end()), from_a.end());
+    EXPECT_TRUE(std::is_sorted(from_b.begin(), from_b.end()));
+}
+
+TEST(IdGeneratorTest, RejectsOutOfRangeNodeId) {
+    EXPECT_THROW(IdGenerator(256, nullptr), std::invalid_argument);
+    EXPECT_NO_THROW(IdGenerator(255, nullptr));
+}
+
+// 全局实例在启动检查时解析 NODE_ID：非法值让 Init 失败（不留下实例），修正后 Init 成功
+TEST(IdGeneratorTest, InitValidatesNodeIdFromEnvironment) {
+    setenv("NODE_ID", "12x", 1);
+    EXPECT_THROW(IdGenerator::Init(), std::invalid_argument);
+    setenv("NODE_ID", "300", 1);
+    EXPECT_THROW(IdGenerator::Init(), std::invalid_argument);
+    setenv("NODE_ID", "42", 1);
+    EXPECT_NO_THROW(IdGenerator::Init(true));
+    EXPECT_EQ(IdGenerator::GetInstance().NodeId(), 42u);
+    EXPECT_EQ(IdGenerator::NodeIdOf(IdGenerator::GetInstance().Next()), 42u);
+    unsetenv("NODE_ID");
+}
+
+} // namespace
@@ -0,0 +1,82 @@
+#include "util/money.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+Money Parsed(const std::string& text) {
+    Money money = Money::FromCents(-1);
+    EXPECT_TRUE(Money::Parse(text, money)) << text;
+    return money;
+}
+
+// 整数、一位/两位小数、正负号
+TEST(MoneyTest, ParsesSignAndFractionDigits) {
+    EXPECT_EQ(Parsed("12").Cents(), 1200);
+    EXPECT_EQ(Parsed("12.5").Cents(), 1250);
+    EXPECT_EQ(Parsed("12.05").Cents(), 1205);
+    EXPECT_EQ(Parsed("0.30").Cents(), 30);
+    EXPECT_EQ(Parsed("-0.30").Cents(), -30);
+    EXPECT_EQ(Parsed("-0.05").Cents(), -5);
+    EXPECT_EQ(Parsed("+7.1").Cents(), 710);
+    EXPECT_EQ(Parsed("-0").Cents(), 0);
+    EXPECT_EQ(Parsed("007.00").Cents(), 700);
+}
+
+// 格式错误返回 false，out 保持不变
+TEST(MoneyTest, RejectsMalformedText) {
+    for (const char* text : {"", "-", "+", ".5", "-.5", "1.234", "1.2.3", "12a", " 12", "12 ", "1,000", "1e3",
+                             "--1", "0x10", "¥12"}) {
+        Money money = Money::FromCents(42);
+        EXPECT_FALSE(Money::Parse(text, money)) << text;
+        EXPECT_EQ(money.Cents(), 42) << text;
+    }
+}
+
+// 元部分上限 (INT64_MAX - 99) / 100：上限内（含两位小数）可解析，超出一位即拒绝，不发生整数溢出
+TEST(MoneyTest, RejectsOverflow) {
+    EXPECT_EQ(Parsed("92233720368547757.99").Cents(), INT64_MAX - 8);
+    EXPECT_EQ(Parsed("-92233720368547757.99").Cents(), -(INT64_MAX - 8));
+    for (const char* text : {"92233720368547758", "92233720368547759", "-92233720368547758.00",
+                             "100000000000000000", "99999999999999999999999"}) {
+        Money money = Money::FromCents(42);
+        EXPECT_FALSE(Money::Parse(text, money)) << text;
+        EXPECT_EQ(money.Cents(), 42) << text;
+    }
+}
+
+// 单价 × 比例四舍五入到分，.5 远离零
+TEST(MoneyTest, MulRatioRoundsHalfAwayFromZero) {
+    EXPECT_EQ(Money::FromCents(230).MulRatio(12345, 1000).Cents(), 2839);  // 2.30 元/km × 12.345km = 28.3935
+    EXPECT_EQ(Money::FromCents(230).MulRatio(12346, 1000).Cents(), 2840);  // 28.3958
+    EXPECT_EQ(Money::FromCents(5).MulRatio(1, 2).Cents(), 3);              // 2.5 分
+    EXPECT_EQ(Money::FromCents(-5).MulRatio(1, 2).Cents(), -3);
+    EXPECT_EQ(Money::FromCents(3).MulRatio(1, 2).Cents(), 2);              // 1.5 分
+    EXPECT_EQ(Money::FromCents(100).MulRatio(1, 3).Cents(), 33);           // 33.33
+    EXPECT_EQ(Money::FromCents(200).MulRatio(1, 3).Cents(), 67);           // 66.67
+    EXPECT_EQ(Money::FromCents(-200).MulRatio(1, 3).Cents(), -67);
+    EXPECT_EQ(Money::FromCents(50).MulRatio(-3, 1).Cents(), -150);
+    EXPECT_EQ(Money::FromCents(999).MulRatio(0, 7).Cents(), 0);
+    EXPECT_EQ(Money::FromCents(1234).MulRatio(1000, 1000).Cents(), 1234);
+}
+
+// 两位小数格式；与 Parse 往返一致
+TEST(MoneyTest, ToStringFormatsTwoDecimals) {
+    EXPECT_EQ(Money().ToString(), "0.00");
+    EXPECT_EQ(Money::FromCents(5).ToString(), "0.05");
+    EXPECT_EQ(Money::FromCents(-5).ToString(), "-0.05");
+    EXPECT_EQ(Money::FromCents(30).ToString(), "0.30");
+    EXPECT_EQ(Money::FromCents(1230).ToString(), "12.30");
+    EXPECT_EQ(Money::FromCents(-123456).ToString(), "-1234.56");
+    EXPECT_EQ(Money::FromCents(INT64_MAX).ToString(), "92233720368547758.07");
+    EXPECT_EQ(Money::FromCents(INT64_MIN).ToString(), "-92233720368547758.08");
+    EXPECT_EQ(fmt::format("{}元", Money::FromYuan(10)), "10.00元");
+
+    std::mt19937_64 rng(2026);
+    for (int i = 0; i < 10000; ++i) {
+        Money money = Money::FromCents(static_cast<int64_t>(rng() % 2000000001) - 1000000000);
+        EXPECT_EQ(Parsed(money.ToString()), money) << money.ToString();
+    }
+}
+
+} // namespace
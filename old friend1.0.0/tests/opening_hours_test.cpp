@@ -0,0 +1,133 @@
+#include "util/opening_hours.h"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <ctime>
+
+namespace {
+
+constexpr int kDay = OpeningHours::kMinutesPerDay;
+
+// 周内第 day 天（周一为 0）的 h:m
+constexpr int At(int day, int hour, int minute = 0) { return day * kDay + hour * 60 + minute; }
+
+using Intervals = std::vector<std::pair<int, int>>;
+
+// 每天同一时段
+Intervals Daily(std::initializer_list<int> days, int begin, int end) {
+    Intervals result;
+    for (int day : days) result.emplace_back(day * kDay + begin, day * kDay + end);
+    return result;
+}
+
+Intervals Concat(std::initializer_list<Intervals> parts) {
+    Intervals result;
+    for (const auto& part : parts) result.insert(result.end(), part.begin(), part.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+Intervals IntervalsOf(const OpeningHours& hours) {
+    Intervals result;
+    for (const auto& item : hours.Intervals()) result.emplace_back(item.begin, item.end);
+    return result;
+}
+
+// 北京时间 yyyy-mm-dd hh:mm 对应的秒级时间戳
+int64_t Beijing(int year, int month, int day, int hour, int minute) {
+    std::tm tm = {};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    return static_cast<int64_t>(timegm(&tm)) - OpeningHours::kUtcOffsetSeconds;
+}
+
+struct Case {
+    const char* text;
+    Intervals expected;
+};
+
+TEST(OpeningHoursTest, CompilesTextToIntervals) {
+    const Intervals weekdays = Daily({0, 1, 2, 3, 4}, 8 * 60, 17 * 60);
+    const Case cases[] = {
+        {"周一至周五 8:00-17:00，周六 8:00-12:00",
+         Concat({weekdays, Daily({5}, 8 * 60, 12 * 60)})},
+        {"星期一到星期五 08：30-17：00", Daily({0, 1, 2, 3, 4}, 8 * 60 + 30, 17 * 60)},
+        {"每天 8:00-12:00，14:00-17:30",
+         Concat({Daily({0, 1, 2, 3, 4, 5, 6}, 8 * 60, 12 * 60), Daily({0, 1, 2, 3, 4, 5, 6}, 14 * 60, 17 * 60 + 30)})},
+        {"周一至周五 上午8点-12点 下午2点-5点半",
+         Concat({Daily({0, 1, 2, 3, 4}, 8 * 60, 12 * 60), Daily({0, 1, 2, 3, 4}, 14 * 60, 17 * 60 + 30)})},
+        {"周一、周三 8点30分-11点30分", Daily({0, 2}, 8 * 60 + 30, 11 * 60 + 30)},
+        {"工作日 8:00-17:00；周末休息", weekdays},
+        {"每天 8:00-17:00，周日休息", Daily({0, 1, 2, 3, 4, 5}, 8 * 60, 17 * 60)},
+        {"周一至周五 8:00-17:00，节假日 9:00-12:00", weekdays},
+        {"周六至周一 9:00-10:00", Daily({0, 5, 6}, 9 * 60, 10 * 60)},
+        {"晚上 7点-9点", Daily({0, 1, 2, 3, 4, 5, 6}, 19 * 60, 21 * 60)},
+        // 跨夜拆到次日，周日跨夜回绕到周一
+        {"周五 22:00-2:00", {{At(4, 22), At(5, 2)}}},
+        {"周日 22:00-2:00", {{0, At(0, 2)}, {At(6, 22), OpeningHours::kMinutesPerWeek}}},
+        // 全天相邻区间合并为一段
+        {"24小时", {{0, OpeningHours::kMinutesPerWeek}}},
+        {"全天", {{0, OpeningHours::kMinutesPerWeek}}},
+    };
+    for (const auto& item : cases) {
+        OpeningHours hours = OpeningHours::Compile(item.text);
+        EXPECT_TRUE(hours.IsKnown()) << item.text;
+        EXPECT_EQ(IntervalsOf(hours), item.expected) << item.text;
+    }
+}
+
+TEST(OpeningHoursTest, UnrecognizedTextIsUnknown) {
+    for (const char* text : {"", "欢迎来电咨询", "节假日 9:00-12:00"}) {
+        OpeningHours hours = OpeningHours::Compile(text);
+        EXPECT_FALSE(hours.IsKnown()) << text;
+        EXPECT_EQ(hours.NextOpeningTime(Beijing(2026, 10, 16, 10, 0)), -1) << text;
+    }
+}
+
+TEST(OpeningHoursTest, IntervalBoundsAreHalfOpen) {
+    OpeningHours hours = OpeningHours::Compile("周一至周五 8:00-17:00");
+    EXPECT_FALSE(hours.IsOpenAtMinute(At(0, 7, 59)));
+    EXPECT_TRUE(hours.IsOpenAtMinute(At(0, 8)));
+    EXPECT_TRUE(hours.IsOpenAtMinute(At(4, 16, 59)));
+    EXPECT_FALSE(hours.IsOpenAtMinute(At(4, 17)));
+    EXPECT_FALSE(hours.IsOpenAtMinute(At(5, 10)));
+}
+
+// 2026-10-19 为周一；周内分钟按北京时间计算，与进程时区无关
+TEST(OpeningHoursTest, MinuteOfWeekUsesBeijingTimeRegardlessOfTimezone) {
+    const char* saved = std::getenv("TZ");
+    std::string saved_tz = saved ? saved : "";
+    for (const char* tz : {"UTC", "America/New_York", "Asia/Shanghai"}) {
+        setenv("TZ", tz, 1);
+        tzset();
+        EXPECT_EQ(OpeningHours::MinuteOfWeek(Beijing(2026, 10, 19, 0, 0)), 0) << tz;
+        EXPECT_EQ(OpeningHours::MinuteOfWeek(Beijing(2026, 10, 16, 9, 30)), At(4, 9, 30)) << tz;
+        EXPECT_EQ(OpeningHours::MinuteOfWeek(Beijing(2026, 10, 18, 23, 59)), At(6, 23, 59)) << tz;
+        EXPECT_EQ(OpeningHours::MinuteOfWeek(Beijing(1970, 1, 1, 0, 0)), At(3, 0)) << tz;
+    }
+    if (saved) setenv("TZ", saved_tz.c_str(), 1); else unsetenv("TZ");
+    tzset();
+}
+
+TEST(OpeningHoursTest, NextOpeningTimeWrapsToNextWeek) {
+    OpeningHours hours = OpeningHours::Compile("周一至周五 8:00-17:00");
+    // 营业中返回原时刻
+    int64_t open = Beijing(2026, 10, 16, 9, 30) + 15;
+    EXPECT_EQ(hours.NextOpeningTime(open), open);
+    // 周五下班后、周六、周日深夜都回绕到下周一 8:00
+    const int64_t monday = Beijing(2026, 10, 19, 8, 0);
+    EXPECT_EQ(hours.NextOpeningTime(Beijing(2026, 10, 16, 17, 0)), monday);
+    EXPECT_EQ(hours.NextOpeningTime(Beijing(2026, 10, 17, 10, 0) + 42), monday);
+    EXPECT_EQ(hours.NextOpeningTime(Beijing(2026, 10, 18, 23, 59)), monday);
+    // 当天开门前
+    EXPECT_EQ(hours.NextOpeningTime(Beijing(2026, 10, 19, 6, 0)), monday);
+
+    // 最后一个区间之后、第一个区间从周一 0:00 开始
+    OpeningHours midnight = OpeningHours::Compile("周一 0:00-1:00");
+    EXPECT_EQ(midnight.NextOpeningTime(Beijing(2026, 10, 18, 23, 30)), Beijing(2026, 10, 19, 0, 0));
+    EXPECT_EQ(midnight.NextOpeningTime(Beijing(2026, 10, 19, 1, 0)), Beijing(2026, 10, 26, 0, 0));
+}
+
+} // namespace
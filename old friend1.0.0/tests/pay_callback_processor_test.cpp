@@ -0,0 +1,111 @@
+#include "service/pay_callback_processor.h"
+#include <gtest/gtest.h>
+#include <map>
+
+namespace {
+
+// 模拟订单表：未支付订单可被任意回调推进；SUCCESS 另可覆盖支付失败（测试去重，不模拟冲突）
+std::mutex g_mutex;
+std::map<std::string, std::string> g_orders;     // out_trade_no → 状态
+std::vector<std::string> g_applied;              // 落库的 out_trade_no:trade_state
+bool g_reconcile = true;                         // 批量落库时是否把订单不存在的回调写入对账表
+
+PayCallbackApplyResult ApplyOne(const PayCallbackNotice& notice) {
+    PayCallbackApplyResult result;
+    auto it = g_orders.find(notice.out_trade_no);
+    if (it == g_orders.end()) {
+        result.code = PayCallbackApplyResult::Code::NOT_FOUND;
+        return result;
+    }
+    if (it->second == notice.trade_state) {
+        result.code = PayCallbackApplyResult::Code::ALREADY_PROCESSED;
+        return result;
+    }
+    it->second = notice.trade_state;
+    g_applied.push_back(notice.out_trade_no + ":" + notice.trade_state);
+    result.code = PayCallbackApplyResult::Code::APPLIED;
+    result.order_id = notice.out_trade_no;
+    return result;
+}
+
+PayCallbackNotice Notice(const std::string& out_trade_no, const std::string& trade_state) {
+    PayCallbackNotice notice;
+    notice.out_trade_no = out_trade_no;
+    notice.trade_state = trade_state;
+    return notice;
+}
+
+class PayCallbackProcessorTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        PayCallbackProcessor& processor = PayCallbackProcessor::GetInstance();
+        processor.Start(
+            [](const PayCallbackNotice& notice, int64_t) {
+                std::lock_guard<std::mutex> lock(g_mutex);
+                return ApplyOne(notice);
+            },
+            nullptr, [] { return static_cast<int64_t>(0); });
+        processor.SetBatchApply([](const std::vector<PayCallbackNotice>& notices, int64_t,
+                                   std::vector<PayCallbackApplyResult>& results) {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            for (const auto& notice : notices) {
+                results.push_back(ApplyOne(notice));
+                results.back().reconciled = g_reconcile &&
+                    results.back().code == PayCallbackApplyResult::Code::NOT_FOUND;
+            }
+            return true;
+        });
+    }
+
+    static void TearDownTestSuite() { PayCallbackProcessor::GetInstance().Stop(); }
+
+    void SetUp() override {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_orders.clear();
+        g_applied.clear();
+        g_reconcile = true;
+    }
+};
+
+// 已落库的失败通知不会让之后的 SUCCESS 被当作重复回调
+TEST_F(PayCallbackProcessorTest, SuccessAfterFailureIsNotDuplicate) {
+    PayCallbackProcessor& processor = PayCallbackProcessor::GetInstance();
+    g_orders["P1"] = "NOTPAY";
+    EXPECT_EQ(processor.Process(Notice("P1", "PAYERROR")), PayCallbackOutcome::APPLIED);
+    EXPECT_EQ(processor.Process(Notice("P1", "PAYERROR")), PayCallbackOutcome::DUPLICATE);
+    EXPECT_EQ(processor.Process(Notice("P1", "SUCCESS")), PayCallbackOutcome::APPLIED);
+    EXPECT_EQ(processor.Process(Notice("P1", "SUCCESS")), PayCallbackOutcome::DUPLICATE);
+    EXPECT_EQ(g_orders["P1"], "SUCCESS");
+}
+
+// 同一批内同一订单的失败通知与 SUCCESS：只落库 SUCCESS；同状态的重复通知只落库一次
+TEST_F(PayCallbackProcessorTest, BatchKeepsTerminalSuccess) {
+    PayCallbackProcessor& processor = PayCallbackProcessor::GetInstance();
+    g_orders["P2"] = "NOTPAY";
+    g_orders["P3"] = "NOTPAY";
+    ASSERT_TRUE(processor.ProcessBatch({Notice("P2", "PAYERROR"), Notice("P2", "SUCCESS"),
+                                        Notice("P3", "PAYERROR"), Notice("P3", "PAYERROR")}));
+    EXPECT_EQ(g_orders["P2"], "SUCCESS");
+    EXPECT_EQ(g_orders["P3"], "PAYERROR");
+    EXPECT_EQ(g_applied, (std::vector<std::string>{"P2:SUCCESS", "P3:PAYERROR"}));
+
+    // 之后到达的 SUCCESS 不被 P3 的失败通知挡住
+    ASSERT_TRUE(processor.ProcessBatch({Notice("P3", "SUCCESS")}));
+    EXPECT_EQ(g_orders["P3"], "SUCCESS");
+}
+
+// 已确认的回调找不到订单：未写入对账表时整批失败（留在队列），写入后才算处理完
+TEST_F(PayCallbackProcessorTest, BatchKeepsUnreconciledNotices) {
+    PayCallbackProcessor& processor = PayCallbackProcessor::GetInstance();
+    uint64_t reconciled = processor.GetStats().reconciled;
+    g_reconcile = false;
+    EXPECT_FALSE(processor.ProcessBatch({Notice("P4", "SUCCESS")}));
+    EXPECT_EQ(processor.GetStats().reconciled, reconciled);
+
+    g_reconcile = true;
+    EXPECT_TRUE(processor.ProcessBatch({Notice("P4", "SUCCESS")}));
+    EXPECT_EQ(processor.GetStats().reconciled, reconciled + 1);
+    EXPECT_TRUE(processor.IsRecent(Notice("P4", "SUCCESS")));
+}
+
+} // namespace
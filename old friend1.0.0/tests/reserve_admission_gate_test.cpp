@@ -0,0 +1,48 @@
+#include "service/reserve_admission_gate.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// 请求全部离开后准入队列被移除，逐日放号不会让表无限增长
+TEST(ReserveAdmissionGateTest, IdleGatesAreRemoved) {
+    ReserveAdmissionGate& gate = ReserveAdmissionGate::GetInstance();
+    ReserveAdmissionOptions options;
+    options.max_concurrent = 2;
+    options.wait_timeout_ms = 5000;
+    gate.SetOptions(options);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> admitted{0};
+    for (int day = 0; day < 50; ++day) {
+        for (int k = 0; k < 4; ++k) {
+            threads.emplace_back([&, day] {
+                ReserveAdmissionGate::Ticket ticket;
+                if (gate.Enter("H1", "内科", "2026-11-" + std::to_string(day), ticket) == AdmissionResult::ADMITTED) {
+                    ++admitted;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+        }
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(admitted, 200);
+    EXPECT_EQ(gate.GetStats().gates, 0u);
+
+    // 持有令牌期间队列保留，离开后移除
+    {
+        ReserveAdmissionGate::Ticket ticket;
+        ASSERT_EQ(gate.Enter("H1", "内科", "2026-12-01", ticket), AdmissionResult::ADMITTED);
+        EXPECT_EQ(gate.GetStats().gates, 1u);
+    }
+    EXPECT_EQ(gate.GetStats().gates, 0u);
+}
+
+// 被拒绝（已满）的请求也不会留下队列
+TEST(ReserveAdmissionGateTest, RejectedRequestsLeaveNoGate) {
+    ReserveQuotaEngine::GetInstance().Reconcile({ReserveQuota{"H2", "外科", "2026-12-02", 1, 1}});
+    ReserveAdmissionGate::Ticket ticket;
+    EXPECT_EQ(ReserveAdmissionGate::GetInstance().Enter("H2", "外科", "2026-12-02", ticket), AdmissionResult::SOLD_OUT);
+    EXPECT_EQ(ReserveAdmissionGate::GetInstance().GetStats().gates, 0u);
+}
+
+} // namespace
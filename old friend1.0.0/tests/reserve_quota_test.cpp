@@ -0,0 +1,321 @@
+#include "service/reserve_quota_engine.h"
+#include "service/reserve_order_committer.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+namespace {
+
+// 模拟 HOSPITAL_QUOTA 表：多个实例共享，条件更新 used_quota + delta <= total_quota
+struct FakeQuotaTable {
+    std::mutex mutex;
+    ReserveQuota quota;
+
+    ReserveCommitResult Commit(const std::vector<ReserveQuotaDelta>& deltas) {
+        std::lock_guard<std::mutex> lock(mutex);
+        int delta = 0;
+        for (const auto& item : deltas) delta += item.used_delta;
+        if (quota.used_quota + delta > quota.total_quota) {
+            return ReserveCommitResult::QUOTA_EXCEEDED;
+        }
+        quota.used_quota += delta;
+        return ReserveCommitResult::COMMITTED;
+    }
+};
+
+ReserveOrder MakeOrder(int i) {
+    ReserveOrder order;
+    order.order_id = "RES" + std::to_string(i);
+    order.hospital_id = "H1";
+    order.department = "内科";
+    order.reserve_date = "2026-10-20";
+    return order;
+}
+
+// 模拟多个科室/时段共享的号源表：一个事务内执行全部增量，任一超出时整体回滚；
+// report 为 true 时与 HospitalDao 一致报告超出的增量下标，为 false 时模拟不报告的实现
+struct FakeBatchTable {
+    std::map<std::string, int> quota_free;  // 科室 → 剩余号源
+    std::map<std::string, int> slot_free;   // 时段 → 剩余容量
+    bool report = true;
+    int transactions = 0;
+
+    ReserveCommitResult Commit(const std::vector<ReserveQuotaDelta>& deltas,
+                               const std::vector<ReserveSlotDelta>& slot_deltas, ReserveCommitOverflow& overflow) {
+        ++transactions;
+        std::vector<size_t> quota, slots;
+        for (size_t i = 0; i < deltas.size(); ++i) {
+            if (deltas[i].used_delta > quota_free[deltas[i].department]) quota.push_back(i);
+        }
+        for (size_t i = 0; i < slot_deltas.size(); ++i) {
+            if (slot_deltas[i].used_delta > slot_free[slot_deltas[i].period]) slots.push_back(i);
+        }
+        if (!quota.empty() || !slots.empty()) {
+            if (report) {
+                overflow.quota = quota;
+                overflow.slots = slots;
+            }
+            return quota.empty() ? ReserveCommitResult::SLOT_FULL : ReserveCommitResult::QUOTA_EXCEEDED;
+        }
+        for (const auto& delta : deltas) quota_free[delta.department] -= delta.used_delta;
+        for (const auto& delta : slot_deltas) slot_free[delta.period] -= delta.used_delta;
+        return ReserveCommitResult::COMMITTED;
+    }
+};
+
+ReserveOrder MakeOrder(int i, const std::string& department, const std::string& period = "") {
+    ReserveOrder order = MakeOrder(i);
+    order.department = department;
+    order.reserve_period = period;
+    return order;
+}
+
+// 全部订单攒成一批提交（max_batch 等于订单数，提交间隔足够长），返回每单结果
+std::vector<ReserveCommitResult> CommitAsOneBatch(FakeBatchTable& table, const std::vector<ReserveOrder>& orders,
+                                                  bool slotted = false) {
+    ReserveOrderCommitter& committer = ReserveOrderCommitter::GetInstance();
+    committer.Start(
+        [&](const std::vector<ReserveOrder>&, const std::vector<ReserveQuotaDelta>& deltas,
+            const std::vector<ReserveSlotDelta>& slot_deltas, ReserveCommitOverflow& overflow) {
+            return table.Commit(deltas, slot_deltas, overflow);
+        },
+        ReserveCommitOptions{orders.size(), 10000});
+    std::vector<std::future<ReserveCommitResult>> futures;
+    for (const auto& order : orders) futures.push_back(committer.Submit(order, slotted));
+    std::vector<ReserveCommitResult> results;
+    for (auto& future : futures) results.push_back(future.get());
+    committer.Stop();
+    return results;
+}
+
+int Count(const std::vector<ReserveCommitResult>& results, ReserveCommitResult result) {
+    return static_cast<int>(std::count(results.begin(), results.end(), result));
+}
+
+// 本实例内存计数器认为还有 10 个号，另一实例已在数据库中约走 6 个：只能成功 4 单，数据库不超卖
+TEST(ReserveQuotaTest, CommitRejectsOrdersBeyondDatabaseQuota) {
+    FakeQuotaTable table;
+    table.quota = ReserveQuota{"H1", "内科", "2026-10-20", 10, 0};
+
+    ReserveQuotaEngine& engine = ReserveQuotaEngine::GetInstance();
+    engine.Configure(
+        [&](const std::string&, const std::string&, const std::string&, ReserveQuota& out) {
+            std::lock_guard<std::mutex> lock(table.mutex);
+            out = table.quota;
+            return true;
+        },
+        [](const std::vector<ReserveQuotaDelta>&) { return true; });
+    ReserveOrderCommitter& committer = ReserveOrderCommitter::GetInstance();
+    committer.Start([&](const std::vector<ReserveOrder>&, const std::vector<ReserveQuotaDelta>& deltas,
+                        const std::vector<ReserveSlotDelta>&, ReserveCommitOverflow&) {
+        return table.Commit(deltas);
+    });
+
+    ASSERT_EQ(engine.TryAcquire("H1", "内科", "2026-10-20", false), QuotaAcquireResult::OK);
+    engine.Release("H1", "内科", "2026-10-20", false);
+    {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        table.quota.used_quota = 6;  // 另一实例的提交
+    }
+
+    // 与 CreateReserveOrder 相同的流程：内存占用 → 组提交 → 被拒时归还并按数据库刷新
+    std::vector<std::thread> threads;
+    std::atomic<int> committed{0};
+    std::atomic<int> exceeded{0};
+    for (int i = 0; i < 10; ++i) {
+        threads.emplace_back([&, i] {
+            ASSERT_EQ(engine.TryAcquire("H1", "内科", "2026-10-20", false), QuotaAcquireResult::OK);
+            ReserveCommitResult result = committer.Submit(MakeOrder(i)).get();
+            if (result == ReserveCommitResult::COMMITTED) {
+                ++committed;
+                return;
+            }
+            engine.Release("H1", "内科", "2026-10-20", false);
+            if (result == ReserveCommitResult::QUOTA_EXCEEDED) {
+                ++exceeded;
+                engine.Refresh("H1", "内科", "2026-10-20");
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    committer.Stop();
+
+    EXPECT_EQ(committed, 4);
+    EXPECT_EQ(exceeded, 6);
+    EXPECT_EQ(table.quota.used_quota, 10);
+    EXPECT_EQ(committer.GetStats().quota_exceeded, 6u);
+    // 刷新后本实例的计数器与数据库一致，后续请求在内存中直接约满
+    engine.Refresh("H1", "内科", "2026-10-20");
+    EXPECT_EQ(engine.Remaining("H1", "内科", "2026-10-20"), 0);
+    EXPECT_EQ(engine.TryAcquire("H1", "内科", "2026-10-20", false), QuotaAcquireResult::SOLD_OUT);
+}
+
+// 一批 64 单分属 4 个科室，其中儿科只剩 3 个号：数据库报告超出的科室后，其余 48 单重新成批一次提交，
+// 儿科的 16 单二分定位，先入队的 3 单成功；事务数约为 log(n) 而不是逐单 64 个
+TEST(ReserveQuotaTest, GroupCommitSplitsOutOnlyOverflowedKeys) {
+    const std::vector<std::string> departments = {"内科", "外科", "儿科", "眼科"};
+    FakeBatchTable table;
+    for (const auto& department : departments) table.quota_free[department] = 100;
+    table.quota_free["儿科"] = 3;
+    std::vector<ReserveOrder> orders;
+    for (int i = 0; i < 64; ++i) orders.push_back(MakeOrder(i, departments[i % 4]));
+    ReserveCommitStats before = ReserveOrderCommitter::GetInstance().GetStats();
+
+    std::vector<ReserveCommitResult> results = CommitAsOneBatch(table, orders);
+
+    EXPECT_EQ(Count(results, ReserveCommitResult::COMMITTED), 51);
+    EXPECT_EQ(Count(results, ReserveCommitResult::QUOTA_EXCEEDED), 13);
+    int hot_committed = 0;
+    for (int i = 0; i < 64; ++i) {
+        if (orders[i].department != "儿科") {
+            EXPECT_EQ(results[i], ReserveCommitResult::COMMITTED) << i;
+        } else if (hot_committed < 3) {
+            EXPECT_EQ(results[i], ReserveCommitResult::COMMITTED) << i;  // 先入队的优先
+            ++hot_committed;
+        } else {
+            EXPECT_EQ(results[i], ReserveCommitResult::QUOTA_EXCEEDED) << i;
+        }
+    }
+    EXPECT_EQ(table.quota_free["儿科"], 0);
+    EXPECT_EQ(table.quota_free["内科"], 84);
+    EXPECT_LE(table.transactions, 12);
+    ReserveCommitStats after = ReserveOrderCommitter::GetInstance().GetStats();
+    EXPECT_EQ(after.orders - before.orders, 51u);
+    EXPECT_EQ(after.quota_exceeded - before.quota_exceeded, 13u);
+}
+
+// 单个热门号源：256 单抢剩余 10 个号，二分后恰好前 10 单成功，确认约满后其余订单不再开事务
+TEST(ReserveQuotaTest, GroupCommitBisectsHotKey) {
+    FakeBatchTable table;
+    table.quota_free["内科"] = 10;
+    std::vector<ReserveOrder> orders;
+    for (int i = 0; i < 256; ++i) orders.push_back(MakeOrder(i, "内科"));
+
+    std::vector<ReserveCommitResult> results = CommitAsOneBatch(table, orders);
+
+    for (int i = 0; i < 256; ++i) {
+        EXPECT_EQ(results[i], i < 10 ? ReserveCommitResult::COMMITTED : ReserveCommitResult::QUOTA_EXCEEDED) << i;
+    }
+    EXPECT_EQ(table.quota_free["内科"], 0);
+    EXPECT_LE(table.transactions, 20);
+}
+
+// 数据库不报告超出键时整批二分，结果与报告时一致，事务数仍远少于逐单提交
+TEST(ReserveQuotaTest, GroupCommitWithoutOverflowReportStillConverges) {
+    const std::vector<std::string> departments = {"内科", "外科", "儿科", "眼科"};
+    FakeBatchTable table;
+    table.report = false;
+    for (const auto& department : departments) table.quota_free[department] = 100;
+    table.quota_free["儿科"] = 3;
+    std::vector<ReserveOrder> orders;
+    for (int i = 0; i < 64; ++i) orders.push_back(MakeOrder(i, departments[i % 4]));
+
+    std::vector<ReserveCommitResult> results = CommitAsOneBatch(table, orders);
+
+    EXPECT_EQ(Count(results, ReserveCommitResult::COMMITTED), 51);
+    EXPECT_EQ(Count(results, ReserveCommitResult::QUOTA_EXCEEDED), 13);
+    EXPECT_EQ(table.quota_free["儿科"], 0);
+    EXPECT_EQ(table.quota_free["内科"], 84);
+    EXPECT_LE(table.transactions, 24);
+}
+
+// 时段超出同样只拆出该时段的订单：上午时段剩 2 个，下午时段的订单一次提交
+TEST(ReserveQuotaTest, GroupCommitSplitsOutOnlyFullSlots) {
+    FakeBatchTable table;
+    table.quota_free["内科"] = 100;
+    table.slot_free["上午 8:00-9:00"] = 2;
+    table.slot_free["下午 14:00-15:00"] = 20;
+    std::vector<ReserveOrder> orders;
+    for (int i = 0; i < 16; ++i) {
+        orders.push_back(MakeOrder(i, "内科", i % 2 == 0 ? "上午 8:00-9:00" : "下午 14:00-15:00"));
+    }
+
+    std::vector<ReserveCommitResult> results = CommitAsOneBatch(table, orders, true);
+
+    EXPECT_EQ(Count(results, ReserveCommitResult::COMMITTED), 10);
+    EXPECT_EQ(Count(results, ReserveCommitResult::SLOT_FULL), 6);
+    EXPECT_EQ(results[0], ReserveCommitResult::COMMITTED);
+    EXPECT_EQ(results[2], ReserveCommitResult::COMMITTED);
+    EXPECT_EQ(results[4], ReserveCommitResult::SLOT_FULL);
+    EXPECT_EQ(table.slot_free["上午 8:00-9:00"], 0);
+    EXPECT_EQ(table.slot_free["下午 14:00-15:00"], 12);
+    EXPECT_EQ(table.quota_free["内科"], 90);
+    EXPECT_LE(table.transactions, 8);
+}
+
+// 就诊日已过的计数器在增量写回后淘汰；尚有未写回增量的保留到写回成功，淘汰后再访问按需重新加载
+TEST(ReserveQuotaTest, EvictsPastDatesAfterDeltasAreFlushed) {
+    std::atomic<bool> flush_ok{false};
+    std::atomic<int> loads{0};
+    ReserveQuotaEngine& engine = ReserveQuotaEngine::GetInstance();
+    engine.Configure(
+        [&](const std::string& h, const std::string& d, const std::string& date, ReserveQuota& out) {
+            ++loads;
+            out = ReserveQuota{h, d, date, 5, 0};
+            return true;
+        },
+        [&](const std::vector<ReserveQuotaDelta>&) { return flush_ok.load(); });
+
+    ASSERT_EQ(engine.TryAcquire("H2", "内科", "2026-09-01", false), QuotaAcquireResult::OK);
+    ASSERT_EQ(engine.TryAcquire("H2", "外科", "2026-09-01"), QuotaAcquireResult::OK);
+    ASSERT_EQ(engine.TryAcquire("H2", "内科", "2026-09-02"), QuotaAcquireResult::OK);
+    engine.Flush();  // 写回失败，增量保留
+    uint64_t evicted_before = engine.GetStats().evicted;
+
+    EXPECT_EQ(engine.EvictBefore("2026-09-02"), 1u);
+    EXPECT_EQ(engine.Remaining("H2", "内科", "2026-09-01"), -1);
+    EXPECT_EQ(engine.Remaining("H2", "外科", "2026-09-01"), 4);
+    EXPECT_EQ(engine.Remaining("H2", "内科", "2026-09-02"), 4);
+
+    flush_ok = true;
+    EXPECT_EQ(engine.Flush(), 2u);
+    EXPECT_EQ(engine.EvictBefore("2026-09-02"), 1u);
+    EXPECT_EQ(engine.Remaining("H2", "外科", "2026-09-01"), -1);
+    EXPECT_EQ(engine.Remaining("H2", "内科", "2026-09-02"), 4);
+    EXPECT_EQ(engine.GetStats().evicted - evicted_before, 2u);
+
+    int loads_before = loads;
+    EXPECT_EQ(engine.TryAcquire("H2", "内科", "2026-09-01", false), QuotaAcquireResult::OK);
+    EXPECT_EQ(loads, loads_before + 1);
+    EXPECT_EQ(engine.Remaining("H2", "内科", "2026-09-01"), 4);
+}
+
+// 淘汰与并发占用/释放交错：进行中的调用持有的计数器不会悬空，增量不会丢失
+TEST(ReserveQuotaTest, EvictionKeepsInFlightCountersValid) {
+    std::mutex mutex;
+    int flushed = 0;
+    ReserveQuotaEngine& engine = ReserveQuotaEngine::GetInstance();
+    engine.Configure(
+        [](const std::string& h, const std::string& d, const std::string& date, ReserveQuota& out) {
+            out = ReserveQuota{h, d, date, 1000000, 0};
+            return true;
+        },
+        [&](const std::vector<ReserveQuotaDelta>& deltas) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& delta : deltas) flushed += delta.used_delta;
+            return true;
+        });
+
+    std::atomic<bool> stop{false};
+    std::thread evictor([&] {
+        while (!stop) {
+            engine.Flush();
+            engine.EvictBefore("2026-09-10");
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 20000; ++i) {
+                ASSERT_EQ(engine.TryAcquire("H3", "内科", "2026-09-05"), QuotaAcquireResult::OK);
+                if (i % 2 == 1) engine.Release("H3", "内科", "2026-09-05");
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    stop = true;
+    evictor.join();
+    engine.Flush();
+    EXPECT_EQ(flushed, 4 * 10000);
+}
+
+} // namespace
@@ -0,0 +1,188 @@
+#include "service/reserve_slot_inventory.h"
+#include "service/reserve_order_committer.h"
+#include <gtest/gtest.h>
+#include <map>
+
+namespace {
+
+/**
+ * 模拟 HOSPITAL_SLOT_TEMPLATE + RESERVE_ORDER 按时段计数：多个实例共享，
+ * 提交时校验 时段占用 + 增量 <= 容量
+ */
+struct FakeSlotTable {
+    std::mutex mutex;
+    std::vector<ReserveSlot> slots;
+
+    bool Load(const std::string& hospital_id, const std::string& department, const std::string& reserve_date,
+              std::vector<ReserveSlot>& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& slot : slots) {
+            if (slot.hospital_id == hospital_id && slot.department == department &&
+                slot.reserve_date == reserve_date) {
+                out.push_back(slot);
+            }
+        }
+        return !out.empty();
+    }
+
+    ReserveCommitResult Commit(const std::vector<ReserveSlotDelta>& deltas) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& delta : deltas) {
+            ReserveSlot* slot = Find(delta);
+            if (slot == nullptr || slot->used + delta.used_delta > slot->capacity) {
+                return ReserveCommitResult::SLOT_FULL;
+            }
+        }
+        for (const auto& delta : deltas) Find(delta)->used += delta.used_delta;
+        return ReserveCommitResult::COMMITTED;
+    }
+
+    ReserveSlot* Find(const ReserveSlotDelta& delta) {
+        for (auto& slot : slots) {
+            if (slot.hospital_id == delta.hospital_id && slot.department == delta.department &&
+                slot.reserve_date == delta.reserve_date && slot.period == delta.period) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// 单例在各用例间共享，每个用例使用不同的日期
+class ReserveSlotInventoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ReserveSlotInventory::GetInstance().Configure(
+            [this](const std::string& h, const std::string& d, const std::string& date, std::vector<ReserveSlot>& out) {
+                return table_.Load(h, d, date, out);
+            });
+    }
+
+    void AddDay(const std::string& date, const std::vector<std::pair<std::string, int>>& periods) {
+        std::lock_guard<std::mutex> lock(table_.mutex);
+        for (const auto& period : periods) {
+            table_.slots.push_back(ReserveSlot{"H1", "内科", date, period.first, period.second, 0});
+        }
+    }
+
+    ReserveSlotInventory& inventory_ = ReserveSlotInventory::GetInstance();
+    FakeSlotTable table_;
+};
+
+TEST_F(ReserveSlotInventoryTest, ClaimStopsAtCapacity) {
+    AddDay("2026-11-01", {{"上午 8:00-9:00", 2}, {"下午 14:00-15:00", 1}});
+    EXPECT_EQ(inventory_.Claim("H1", "内科", "2026-11-01", "上午 8:00-9:00"), SlotClaimResult::OK);
+    EXPECT_EQ(inventory_.Claim("H1", "内科", "2026-11-01", "上午 8:00-9:00"), SlotClaimResult::OK);
+    EXPECT_EQ(inventory_.Claim("H1", "内科", "2026-11-01", "上午 8:00-9:00"), SlotClaimResult::FULL);
+    EXPECT_EQ(inventory_.Claim("H1", "内科", "2026-11-01", "晚上 20:00-21:00"), SlotClaimResult::UNKNOWN_PERIOD);
+    EXPECT_EQ(inventory_.Claim("H1", "外科", "2026-11-01", "上午 8:00-9:00"), SlotClaimResult::NOT_SLOTTED);
+}
+
+TEST_F(ReserveSlotInventoryTest, ReleaseReturnsSlotAndNeverGoesNegative) {
+    AddDay("2026-11-02", {{"上午 8:00-9:00", 1}});
+    ASSERT_EQ(inventory_.Claim("H1", "内科", "2026-11-02", "上午 8:00-9:00"), SlotClaimResult::OK);
+    EXPECT_TRUE(inventory_.Release("H1", "内科", "2026-11-02", "上午 8:00-9:00"));
+    EXPECT_FALSE(inventory_.Release("H1", "内科", "2026-11-02", "上午 8:00-9:00"));
+    EXPECT_FALSE(inventory_.Release("H1", "内科", "2026-11-02", "下午 14:00-15:00"));
+    EXPECT_EQ(inventory_.Claim("H1", "内科", "2026-11-02", "上午 8:00-9:00"), SlotClaimResult::OK);
+}
+
+// 按模板顺序分配第一个未满的时段，全部约满后返回 FULL
+TEST_F(ReserveSlotInventoryTest, ClaimFirstFreeFollowsTemplateOrder) {
+    AddDay("2026-11-03", {{"上午 8:00-9:00", 1}, {"上午 9:00-10:00", 2}, {"下午 14:00-15:00", 1}});
+    std::vector<std::string> claimed;
+    std::string period;
+    while (inventory_.ClaimFirstFree("H1", "内科", "2026-11-03", period) == SlotClaimResult::OK) {
+        claimed.push_back(period);
+    }
+    EXPECT_EQ(claimed, (std::vector<std::string>{"上午 8:00-9:00", "上午 9:00-10:00", "上午 9:00-10:00",
+                                                 "下午 14:00-15:00"}));
+    // 中间时段归还后，下一次分配回到该时段
+    ASSERT_TRUE(inventory_.Release("H1", "内科", "2026-11-03", "上午 9:00-10:00"));
+    ASSERT_EQ(inventory_.ClaimFirstFree("H1", "内科", "2026-11-03", period), SlotClaimResult::OK);
+    EXPECT_EQ(period, "上午 9:00-10:00");
+}
+
+TEST_F(ReserveSlotInventoryTest, SlotsWithAtLeastFiltersByFreeCount) {
+    AddDay("2026-11-04", {{"上午 8:00-9:00", 3}, {"上午 9:00-10:00", 1}, {"下午 14:00-15:00", 2}});
+    ASSERT_EQ(inventory_.Claim("H1", "内科", "2026-11-04", "上午 8:00-9:00"), SlotClaimResult::OK);
+    ASSERT_EQ(inventory_.Claim("H1", "内科", "2026-11-04", "上午 9:00-10:00"), SlotClaimResult::OK);
+
+    auto slots = inventory_.SlotsWithAtLeast("H1", "内科", "2026-11-04", 2);
+    ASSERT_EQ(slots.size(), 2u);
+    EXPECT_EQ(slots[0].period, "上午 8:00-9:00");
+    EXPECT_EQ(slots[0].capacity, 3);
+    EXPECT_EQ(slots[0].free, 2);
+    EXPECT_EQ(slots[1].period, "下午 14:00-15:00");
+    EXPECT_EQ(slots[1].free, 2);
+    EXPECT_EQ(inventory_.SlotsWithAtLeast("H1", "内科", "2026-11-04", 0).size(), 3u);
+    EXPECT_TRUE(inventory_.SlotsWithAtLeast("H1", "内科", "2026-11-04", 3).empty());
+    EXPECT_TRUE(inventory_.SlotsWithAtLeast("H1", "外科", "2026-11-04", 0).empty());
+}
+
+// 两个实例各自的内存计数都认为时段还有空位：数据库侧按时段校验，合计不超出容量；
+// 被拒的实例归还时段并刷新后，内存计数与数据库一致
+TEST_F(ReserveSlotInventoryTest, CommitRejectsSlotBeyondDatabaseCapacity) {
+    AddDay("2026-11-05", {{"上午 8:00-9:00", 3}, {"下午 14:00-15:00", 5}});
+    const std::string period = "上午 8:00-9:00";
+    ASSERT_EQ(inventory_.SlotsWithAtLeast("H1", "内科", "2026-11-05", 0)[0].free, 3);
+    {
+        std::lock_guard<std::mutex> lock(table_.mutex);
+        table_.slots[table_.slots.size() - 2].used = 2;  // 另一实例已约走 2 个
+    }
+    ReserveOrderCommitter& committer = ReserveOrderCommitter::GetInstance();
+    committer.Start([&](const std::vector<ReserveOrder>&, const std::vector<ReserveQuotaDelta>&,
+                        const std::vector<ReserveSlotDelta>& slot_deltas, ReserveCommitOverflow&) {
+        return table_.Commit(slot_deltas);
+    });
+    ReserveCommitStats before = committer.GetStats();
+
+    std::vector<std::thread> threads;
+    std::atomic<int> committed{0};
+    std::atomic<int> slot_full{0};
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([&, i] {
+            ASSERT_EQ(inventory_.Claim("H1", "内科", "2026-11-05", period), SlotClaimResult::OK);
+            ReserveOrder order;
+            order.order_id = "RES" + std::to_string(i);
+            order.hospital_id = "H1";
+            order.department = "内科";
+            order.reserve_date = "2026-11-05";
+            order.reserve_period = period;
+            ReserveCommitResult result = committer.Submit(order, true).get();
+            if (result == ReserveCommitResult::COMMITTED) {
+                ++committed;
+                return;
+            }
+            inventory_.Release("H1", "内科", "2026-11-05", period);
+            if (result == ReserveCommitResult::SLOT_FULL) {
+                ++slot_full;
+                inventory_.Refresh("H1", "内科", "2026-11-05");
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    committer.Stop();
+
+    EXPECT_EQ(committed, 1);
+    EXPECT_EQ(slot_full, 2);
+    EXPECT_EQ(committer.GetStats().slot_full - before.slot_full, 2u);
+    EXPECT_EQ(inventory_.Claim("H1", "内科", "2026-11-05", period), SlotClaimResult::FULL);
+    EXPECT_EQ(inventory_.SlotsWithAtLeast("H1", "内科", "2026-11-05", 1).size(), 1u);
+}
+
+// 就诊日已过的日期被淘汰，之后再访问按数据库重新加载；淘汰前取得的占用照常归还
+TEST_F(ReserveSlotInventoryTest, EvictBeforeDropsPastDays) {
+    AddDay("2026-10-01", {{"上午 8:00-9:00", 2}});
+    AddDay("2026-10-02", {{"上午 8:00-9:00", 2}});
+    ASSERT_EQ(inventory_.Claim("H1", "内科", "2026-10-01", "上午 8:00-9:00"), SlotClaimResult::OK);
+    ASSERT_EQ(inventory_.Claim("H1", "内科", "2026-10-02", "上午 8:00-9:00"), SlotClaimResult::OK);
+
+    EXPECT_GE(inventory_.EvictBefore("2026-10-02"), 1u);
+    // 2026-10-02 未淘汰，内存占用保留
+    EXPECT_EQ(inventory_.SlotsWithAtLeast("H1", "内科", "2026-10-02", 0)[0].free, 1);
+    // 2026-10-01 重新加载：占用以数据库为准（本用例的模拟表中未落库）
+    EXPECT_EQ(inventory_.SlotsWithAtLeast("H1", "内科", "2026-10-01", 0)[0].free, 2);
+}
+
+} // namespace
@@ -0,0 +1,10 @@
+#ifndef TEST_SUPPORT_LOGGER_H
+#define TEST_SUPPORT_LOGGER_H
+
+// 测试用日志头：服务代码只使用 SPDLOG_* 宏，这里直接使用 spdlog 默认 logger
+#ifndef SPDLOG_ACTIVE_LEVEL
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_WARN
+#endif
+#include <spdlog/spdlog.h>
+
+#endif // TEST_SUPPORT_LOGGER_H
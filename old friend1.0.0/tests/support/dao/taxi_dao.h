@@ -0,0 +1,25 @@
+#ifndef TEST_SUPPORT_TAXI_DAO_H
+#define TEST_SUPPORT_TAXI_DAO_H
+
+// 测试用打车 DAO 接口：只声明派单引擎与订单状态机用到的方法，测试与基准以内存实现代替数据库
+#include "model/taxi_order.h"
+#include "model/taxi_driver.h"
+#include <string>
+#include <vector>
+
+struct TaxiOrderPatch;
+
+class ITaxiDao {
+public:
+    virtual ~ITaxiDao() = default;
+    virtual TaxiDriver QueryDriverById(const std::string& driver_id) = 0;
+    virtual bool UpdateDriver(const TaxiDriver& driver) = 0;
+    virtual TaxiOrder QueryTaxiOrderById(const std::string& order_id) = 0;
+    virtual bool CompareAndSetTaxiOrderStatus(const std::string& order_id, TaxiOrder::OrderStatus from,
+                                              TaxiOrder::OrderStatus to, const TaxiOrderPatch& patch) = 0;
+    virtual size_t BatchCompareAndSetTaxiOrderStatus(const std::vector<std::string>& order_ids,
+                                                     TaxiOrder::OrderStatus from, TaxiOrder::OrderStatus to,
+                                                     const TaxiOrderPatch& patch) = 0;
+};
+
+#endif // TEST_SUPPORT_TAXI_DAO_H
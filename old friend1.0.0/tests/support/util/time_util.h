@@ -0,0 +1,14 @@
+#ifndef TEST_SUPPORT_TIME_UTIL_H
+#define TEST_SUPPORT_TIME_UTIL_H
+
+// 测试用时间工具接口：只声明派单引擎用到的方法
+#include <cstdint>
+#include <ctime>
+
+class ITimeUtil {
+public:
+    virtual ~ITimeUtil() = default;
+    virtual int64_t GetCurrentTimestamp() { return static_cast<int64_t>(std::time(nullptr)); }
+};
+
+#endif // TEST_SUPPORT_TIME_UTIL_H
@@ -0,0 +1,165 @@
+#include "service/taxi_dispatcher.h"
+#include <gtest/gtest.h>
+#include <map>
+
+namespace {
+
+// 内存 DAO：记录司机查询次数，可模拟查询异常
+class FakeTaxiDao : public ITaxiDao {
+public:
+    TaxiDriver QueryDriverById(const std::string& driver_id) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++driver_queries;
+        if (fail_queries) throw std::runtime_error("db down");
+        auto it = drivers.find(driver_id);
+        return it == drivers.end() ? TaxiDriver() : it->second;
+    }
+    bool UpdateDriver(const TaxiDriver& driver) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        drivers[driver.driver_id] = driver;
+        return true;
+    }
+    TaxiOrder QueryTaxiOrderById(const std::string& order_id) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        return orders[order_id];
+    }
+    bool CompareAndSetTaxiOrderStatus(const std::string& order_id, TaxiOrder::OrderStatus from,
+                                      TaxiOrder::OrderStatus to, const TaxiOrderPatch&) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        TaxiOrder& order = orders[order_id];
+        if (order.status != from) return false;
+        order.status = to;
+        return true;
+    }
+    size_t BatchCompareAndSetTaxiOrderStatus(const std::vector<std::string>& order_ids, TaxiOrder::OrderStatus from,
+                                             TaxiOrder::OrderStatus to, const TaxiOrderPatch& patch) override {
+        size_t updated = 0;
+        for (const auto& order_id : order_ids) updated += CompareAndSetTaxiOrderStatus(order_id, from, to, patch);
+        return updated;
+    }
+
+    void AddDriver(const std::string& driver_id, TaxiDriver::DriverStatus status) {
+        TaxiDriver driver;
+        driver.driver_id = driver_id;
+        driver.status = status;
+        drivers[driver_id] = driver;
+    }
+
+    std::mutex mutex;
+    std::map<std::string, TaxiDriver> drivers;
+    std::map<std::string, TaxiOrder> orders;
+    int driver_queries = 0;
+    bool fail_queries = false;
+};
+
+TaxiLocation At(double latitude, double longitude) {
+    TaxiLocation location;
+    location.latitude = latitude;
+    location.longitude = longitude;
+    return location;
+}
+
+class TaxiDispatcherTest : public ::testing::Test {
+protected:
+    FakeTaxiDao dao_;
+    ITimeUtil time_util_;
+    TaxiDispatcher dispatcher_{&dao_, &time_util_};
+};
+
+// 只有首次见到的司机查库；服务中/离线司机之后的上报不再访问 DAO
+TEST_F(TaxiDispatcherTest, QueriesDaoOnlyOnFirstSight) {
+    dao_.AddDriver("D1", TaxiDriver::DriverStatus::AVAILABLE);
+    dao_.AddDriver("D2", TaxiDriver::DriverStatus::BUSY);
+    for (int i = 0; i < 5; ++i) {
+        dispatcher_.UpdateDriverLocation("D1", At(31.2, 121.4 + 0.001 * i));
+        dispatcher_.UpdateDriverLocation("D2", At(31.2, 121.4));
+    }
+    EXPECT_EQ(dao_.driver_queries, 2);
+    EXPECT_EQ(dispatcher_.AvailableDriverCount(), 1u);
+
+    // 未注册的司机不缓存，每次都以数据库为准
+    dispatcher_.UpdateDriverLocation("D404", At(31.2, 121.4));
+    dispatcher_.UpdateDriverLocation("D404", At(31.2, 121.4));
+    EXPECT_EQ(dao_.driver_queries, 4);
+}
+
+// 查库异常不向上抛出，本次上报被忽略，下次上报重试
+TEST_F(TaxiDispatcherTest, DaoFailureIsContained) {
+    dao_.AddDriver("D1", TaxiDriver::DriverStatus::AVAILABLE);
+    dao_.fail_queries = true;
+    EXPECT_NO_THROW(dispatcher_.UpdateDriverLocation("D1", At(31.2, 121.4)));
+    EXPECT_EQ(dispatcher_.AvailableDriverCount(), 0u);
+    dao_.fail_queries = false;
+    dispatcher_.UpdateDriverLocation("D1", At(31.2, 121.4));
+    EXPECT_EQ(dispatcher_.AvailableDriverCount(), 1u);
+}
+
+// 派单后司机为服务中，上报被忽略；送达后置为空闲重新进入索引；下线后移出
+TEST_F(TaxiDispatcherTest, TracksAssignCompleteAndOffline) {
+    dao_.AddDriver("D1", TaxiDriver::DriverStatus::AVAILABLE);
+    dispatcher_.UpdateDriverLocation("D1", At(31.2, 121.4));
+    TaxiOrder order;
+    order.order_id = "O1";
+    order.start_location = At(31.201, 121.401);
+    dao_.orders["O1"] = order;
+    ASSERT_TRUE(dispatcher_.Dispatch(order));
+    EXPECT_EQ(order.driver_id, "D1");
+    EXPECT_EQ(dao_.drivers["D1"].status, TaxiDriver::DriverStatus::BUSY);
+
+    int queries = dao_.driver_queries;
+    dispatcher_.UpdateDriverLocation("D1", At(31.3, 121.5));
+    EXPECT_EQ(dispatcher_.AvailableDriverCount(), 0u);
+    EXPECT_EQ(dao_.driver_queries, queries);
+
+    dispatcher_.SetDriverAvailable("D1", At(31.3, 121.5));
+    EXPECT_EQ(dispatcher_.AvailableDriverCount(), 1u);
+    dispatcher_.SetDriverOffline("D1");
+    dispatcher_.UpdateDriverLocation("D1", At(31.3, 121.5));
+    EXPECT_EQ(dispatcher_.AvailableDriverCount(), 0u);
+    EXPECT_EQ(dao_.driver_queries, queries);
+
+    // 状态不确定时丢弃内存状态，下次上报重新查库
+    dispatcher_.ForgetDriver("D1");
+    dao_.AddDriver("D1", TaxiDriver::DriverStatus::AVAILABLE);
+    dispatcher_.UpdateDriverLocation("D1", At(31.3, 121.5));
+    EXPECT_EQ(dao_.driver_queries, queries + 1);
+    EXPECT_EQ(dispatcher_.AvailableDriverCount(), 1u);
+}
+
+// 批量模式：两个相距很远的区域各自求解，区域内按总接驾距离最优指派（而不是逐单抢最近司机）
+TEST(TaxiDispatcherBatchTest, SolvesEachAreaForMinimumTotalDistance) {
+    FakeTaxiDao dao;
+    ITimeUtil time_util;
+    TaxiDispatchOptions options;
+    options.mode = TaxiDispatchOptions::Mode::BATCH;
+    TaxiDispatcher dispatcher(&dao, &time_util, options);
+    // 每个区域：第一单最近的是 A（0.005°），但 A 离第二单更近（0.003°）；
+    // 逐单派单时第一单抢走 A，第二单只能用 0.014° 外的 B，整体最优是第一单用 B（0.006°）、第二单用 A
+    const double area_longitudes[] = {121.40, 121.80};
+    for (int area = 0; area < 2; ++area) {
+        double lon = area_longitudes[area];
+        std::string suffix = std::to_string(area);
+        dao.AddDriver("A" + suffix, TaxiDriver::DriverStatus::AVAILABLE);
+        dao.AddDriver("B" + suffix, TaxiDriver::DriverStatus::AVAILABLE);
+        dispatcher.UpdateDriverLocation("A" + suffix, At(31.2000, lon + 0.005));
+        dispatcher.UpdateDriverLocation("B" + suffix, At(31.2000, lon - 0.006));
+        for (int k = 0; k < 2; ++k) {
+            TaxiOrder order;
+            order.order_id = "O" + suffix + std::to_string(k);
+            order.start_location = At(31.2000, lon + 0.008 * k);
+            dao.orders[order.order_id] = order;
+            EXPECT_FALSE(dispatcher.Dispatch(order)); // 批量模式只入队
+        }
+    }
+    EXPECT_EQ(dispatcher.RunBatchTick(), 4u);
+    EXPECT_EQ(dispatcher.PendingOrderCount(), 0u);
+    for (int area = 0; area < 2; ++area) {
+        std::string suffix = std::to_string(area);
+        EXPECT_EQ(dao.orders["O" + suffix + "0"].status, TaxiOrder::OrderStatus::DISPATCHED);
+        EXPECT_EQ(dao.orders["O" + suffix + "1"].status, TaxiOrder::OrderStatus::DISPATCHED);
+    }
+    // 北纬31.2°处经度 0.001° 约 0.095km：最优平均接驾距离约 (0.57 + 0.29) / 2，逐单派单约 (0.48 + 1.33) / 2
+    EXPECT_NEAR(dispatcher.GetStats().AvgPickupDistance(), (0.571 + 0.286) / 2, 0.02);
+}
+
+} // namespace
@@ -0,0 +1,144 @@
+#include "util/timing_wheel.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace {
+
+// 起点不对齐到任何层边界，级联路径与线上一致
+constexpr int64_t kStart = 1760000000 + 12345;
+constexpr int64_t kLevel1 = int64_t(1) << 6;
+constexpr int64_t kLevel2 = int64_t(1) << 12;
+constexpr int64_t kLevel3 = int64_t(1) << 18;
+constexpr int64_t kRange = int64_t(1) << 24;  // 时间轮覆盖范围（约194天）
+
+// 推进到 expire_at 前一秒不触发，推进到 expire_at 恰好触发这一个
+void ExpectFiresExactlyAt(TimingWheel& wheel, const std::string& key, int64_t expire_at) {
+    std::vector<TimingWheel::Expired> early = wheel.Advance(expire_at - 1);
+    EXPECT_TRUE(early.empty()) << key << " 提前 " << (early.empty() ? 0 : expire_at - early[0].expire_at) << " 秒触发";
+    std::vector<TimingWheel::Expired> fired = wheel.Advance(expire_at);
+    ASSERT_EQ(fired.size(), 1u) << key;
+    EXPECT_EQ(fired[0].key, key);
+    EXPECT_EQ(fired[0].expire_at, expire_at);
+}
+
+// 落在每层边界前后的定时器都在到期那一秒触发（经过 1~3 次级联）
+TEST(TimingWheelTest, CascadesAcrossLevelBoundaries) {
+    TimingWheel wheel(kStart);
+    std::map<int64_t, std::string> timers;
+    for (int64_t boundary : {kLevel1, kLevel2, kLevel3, kRange}) {
+        for (int64_t offset : {-1, 0, 1}) {
+            // 相对当前时刻的边界，以及绝对时间对齐到层边界的时刻
+            int64_t relative = kStart + boundary + offset - 1;
+            int64_t aligned = (kStart / boundary + 1) * boundary + offset;
+            for (int64_t expire_at : {relative, aligned}) {
+                if (expire_at <= kStart || timers.count(expire_at)) continue;
+                timers[expire_at] = "T" + std::to_string(expire_at);
+                wheel.Schedule(timers[expire_at], expire_at);
+            }
+        }
+    }
+    EXPECT_EQ(wheel.Size(), timers.size());
+    for (const auto& timer : timers) {
+        ExpectFiresExactlyAt(wheel, timer.second, timer.first);
+    }
+    EXPECT_EQ(wheel.Size(), 0u);
+}
+
+// 随机定时器 + 随机步长推进：每个定时器只触发一次，且在到期时刻所在的那次推进中触发
+TEST(TimingWheelTest, RandomTimersFireInTheirStep) {
+    std::mt19937_64 rng(2026);
+    TimingWheel wheel(kStart);
+    std::map<std::string, int64_t> pending;
+    for (int i = 0; i < 20000; ++i) {
+        int64_t expire_at = kStart + static_cast<int64_t>(rng() % (kLevel3 * 2));
+        pending["K" + std::to_string(i)] = expire_at;
+        wheel.Schedule("K" + std::to_string(i), expire_at);
+    }
+    int64_t now = kStart - 1;
+    while (!pending.empty()) {
+        int64_t previous = now;
+        now += 1 + static_cast<int64_t>(rng() % 5000);
+        for (const auto& item : wheel.Advance(now)) {
+            auto it = pending.find(item.key);
+            ASSERT_NE(it, pending.end()) << item.key << " 重复触发";
+            EXPECT_EQ(item.expire_at, it->second);
+            EXPECT_GT(item.expire_at, previous);
+            EXPECT_LE(item.expire_at, now);
+            pending.erase(it);
+        }
+        for (const auto& item : pending) {
+            ASSERT_GT(item.second, now) << item.first << " 已到期未触发";
+        }
+    }
+}
+
+// 超出约194天的定时器先挂在最高层，级联时按真实到期时间重新定位，不会提前触发
+TEST(TimingWheelTest, ClampsTimersBeyondRange) {
+    TimingWheel wheel(kStart);
+    const int64_t far = kStart + kRange * 2 + 777;  // 约388天后
+    wheel.Schedule("FAR", far);
+    wheel.Schedule("EDGE", kStart + kRange - 1);
+    ExpectFiresExactlyAt(wheel, "EDGE", kStart + kRange - 1);
+    ExpectFiresExactlyAt(wheel, "FAR", far);
+}
+
+// 重复注册覆盖到期时间与类型（提前或推后都只触发一次）
+TEST(TimingWheelTest, RescheduleReplacesTimer) {
+    TimingWheel wheel(kStart);
+    wheel.Schedule("A", kStart + 5000, 1);
+    wheel.Schedule("A", kStart + 100, 2);   // 提前（第 2 层 → 第 1 层）
+    wheel.Schedule("B", kStart + 10);
+    wheel.Schedule("B", kStart + 300000);   // 推后（第 0 层 → 第 3 层）
+    EXPECT_EQ(wheel.Size(), 2u);
+
+    std::vector<TimingWheel::Expired> fired = wheel.Advance(kStart + 5000);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].key, "A");
+    EXPECT_EQ(fired[0].kind, 2);
+    EXPECT_EQ(fired[0].expire_at, kStart + 100);
+    ExpectFiresExactlyAt(wheel, "B", kStart + 300000);
+}
+
+// 取消后不再触发；不存在或已触发的定时器取消返回 false；节点回收后可复用
+TEST(TimingWheelTest, CancelRemovesTimer) {
+    TimingWheel wheel(kStart);
+    wheel.Schedule("A", kStart + 10);
+    wheel.Schedule("B", kStart + 10);
+    wheel.Schedule("C", kStart + 70000);
+    EXPECT_TRUE(wheel.Cancel("A"));
+    EXPECT_FALSE(wheel.Cancel("A"));
+    EXPECT_FALSE(wheel.Cancel("NOPE"));
+    EXPECT_TRUE(wheel.Cancel("C"));  // 高层槽位中的定时器
+
+    std::vector<TimingWheel::Expired> fired = wheel.Advance(kStart + 100000);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].key, "B");
+    EXPECT_FALSE(wheel.Cancel("B"));
+    EXPECT_EQ(wheel.Size(), 0u);
+
+    wheel.Schedule("A", kStart + 100005);
+    ExpectFiresExactlyAt(wheel, "A", kStart + 100005);
+}
+
+// 已过期的定时器（到期时间早于当前进度）在下一次推进时立即触发，保留原到期时间
+TEST(TimingWheelTest, AlreadyExpiredFiresOnNextAdvance) {
+    TimingWheel wheel(kStart);
+    EXPECT_TRUE(wheel.Advance(kStart + 1000).empty());
+    wheel.Schedule("LATE", kStart + 10);
+    wheel.Schedule("OLD", kStart - 86400);
+    EXPECT_TRUE(wheel.Advance(kStart + 1000).empty());  // 没有推进到新的时刻
+
+    std::vector<TimingWheel::Expired> fired = wheel.Advance(kStart + 1001);
+    ASSERT_EQ(fired.size(), 2u);
+    std::sort(fired.begin(), fired.end(), [](const TimingWheel::Expired& a, const TimingWheel::Expired& b) {
+        return a.expire_at < b.expire_at;
+    });
+    EXPECT_EQ(fired[0].key, "OLD");
+    EXPECT_EQ(fired[0].expire_at, kStart - 86400);
+    EXPECT_EQ(fired[1].key, "LATE");
+    EXPECT_EQ(fired[1].expire_at, kStart + 10);
+}
+
+} // namespace
@@ -0,0 +1,116 @@
+#include "service/trip_estimator.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// 两个相距约 5.6km 的点（网格边长 0.02°，起终点各在一个网格内）
+constexpr double kStartLat = 31.2305, kStartLon = 121.4737;
+constexpr double kEndLat = 31.2705, kEndLon = 121.5137;
+
+double Straight() { return GeoUtil::HaversineKm(kStartLat, kStartLon, kEndLat, kEndLon); }
+
+// 冷启动：没有样本时使用全局默认系数（绕行 1.3，每公里 2.4 分钟）
+TEST(TripEstimatorTest, ColdStartUsesGlobalDefaults) {
+    TripEstimator estimator;
+    TripEstimate estimate = estimator.Estimate(kStartLat, kStartLon, kEndLat, kEndLon);
+    EXPECT_EQ(estimate.samples, 0u);
+    EXPECT_NEAR(estimate.distance_km, Straight() * 1.3, 1e-9);
+    EXPECT_NEAR(estimate.duration_min, Straight() * 1.3 * 2.4, 1e-9);
+    // 起终点重合时时长不低于 1 分钟
+    EXPECT_DOUBLE_EQ(estimator.Estimate(kStartLat, kStartLon, kStartLat, kStartLon).duration_min, 1.0);
+}
+
+// 学习收敛：样本少时向全局系数收缩，样本增多后接近网格对的真实系数；路况变化后按滑动平均跟上
+TEST(TripEstimatorTest, LearningConvergesToPairFactors) {
+    TripEstimator estimator;
+    const double straight = Straight();
+    estimator.Learn(kStartLat, kStartLon, kEndLat, kEndLon, straight * 2.0, straight * 2.0 * 4.0);
+    TripEstimate one = estimator.Estimate(kStartLat, kStartLon, kEndLat, kEndLon);
+    EXPECT_EQ(one.samples, 1u);
+    // 1 个样本权重 1/6：绕行系数介于全局 1.3 与样本 2.0 之间，更接近全局
+    EXPECT_GT(one.distance_km, straight * 1.3);
+    EXPECT_LT(one.distance_km, straight * 1.5);
+
+    for (int i = 0; i < 200; ++i) {
+        estimator.Learn(kStartLat, kStartLon, kEndLat, kEndLon, straight * 2.0, straight * 2.0 * 4.0);
+    }
+    // 201 个样本时网格对权重 201/206，仍保留约 2.4% 的全局系数
+    TripEstimate many = estimator.Estimate(kStartLat, kStartLon, kEndLat, kEndLon);
+    EXPECT_NEAR(many.distance_km / straight, 2.0, 0.03);
+    EXPECT_NEAR(many.duration_min / many.distance_km, 4.0, 0.05);
+
+    // 路况好转（每公里 2 分钟）：最小权重 0.05，约 100 单后基本跟上
+    for (int i = 0; i < 100; ++i) {
+        estimator.Learn(kStartLat, kStartLon, kEndLat, kEndLon, straight * 2.0, straight * 2.0 * 2.0);
+    }
+    TripEstimate after = estimator.Estimate(kStartLat, kStartLon, kEndLat, kEndLon);
+    EXPECT_NEAR(after.duration_min / after.distance_km, 2.0, 0.05);
+
+    // 反方向是另一个网格对，仍只用全局系数
+    EXPECT_EQ(estimator.Estimate(kEndLat, kEndLon, kStartLat, kStartLon).samples, 0u);
+}
+
+// 异常样本（过短行程、绕行系数或每公里耗时超出合理范围）直接丢弃，不影响网格对与全局系数
+TEST(TripEstimatorTest, OutliersAreIgnored) {
+    TripEstimator estimator;
+    const double straight = Straight();
+    TripEstimate before = estimator.Estimate(kStartLat, kStartLon, kEndLat, kEndLon);
+    struct Sample { double distance_km, duration_min; } outliers[] = {
+        {straight * 0.9, straight * 2.0},        // 绕行系数 < 1（里程短于直线距离）
+        {straight * 4.1, straight * 8.0},        // 绕行系数 > 4
+        {straight * 1.5, straight * 1.5 * 0.4},  // 每公里 0.4 分钟（150km/h）
+        {straight * 1.5, straight * 1.5 * 21},   // 每公里 21 分钟（堵死/忘记结束行程）
+        {straight * 1.5, 0.0},                   // 时长为 0
+        {0.2, 5.0},                              // 实际里程过短
+    };
+    for (const Sample& sample : outliers) {
+        estimator.Learn(kStartLat, kStartLon, kEndLat, kEndLon, sample.distance_km, sample.duration_min);
+    }
+    // 起终点距离过短（< 0.3km）的行程不学习
+    estimator.Learn(kStartLat, kStartLon, kStartLat + 0.001, kStartLon, 3.0, 10.0);
+
+    TripEstimate after = estimator.Estimate(kStartLat, kStartLon, kEndLat, kEndLon);
+    EXPECT_EQ(after.samples, 0u);
+    EXPECT_DOUBLE_EQ(after.distance_km, before.distance_km);
+    EXPECT_DOUBLE_EQ(after.duration_min, before.duration_min);
+    EXPECT_EQ(estimator.PairCount(), 0u);
+
+    // 边界值在合理范围内，正常学习
+    estimator.Learn(kStartLat, kStartLon, kEndLat, kEndLon, straight * 4.0, straight * 4.0 * 20);
+    EXPECT_EQ(estimator.Estimate(kStartLat, kStartLon, kEndLat, kEndLon).samples, 1u);
+}
+
+// 组相联淘汰：容量 4 时只有一组，第 5 个网格对淘汰组内样本最少的一项，样本多的网格对保留
+TEST(TripEstimatorTest, EvictsLeastSampledPairInSet) {
+    TripEstimator estimator(0.02, 4);
+    auto learn = [&](int pair, int times) {
+        double end_lat = kStartLat + 0.02 * (pair + 1);
+        double straight = GeoUtil::HaversineKm(kStartLat, kStartLon, end_lat, kStartLon);
+        for (int i = 0; i < times; ++i) {
+            estimator.Learn(kStartLat, kStartLon, end_lat, kStartLon, straight * 1.5, straight * 1.5 * 3.0);
+        }
+    };
+    auto samples = [&](int pair) {
+        return estimator.Estimate(kStartLat, kStartLon, kStartLat + 0.02 * (pair + 1), kStartLon).samples;
+    };
+    learn(0, 5);
+    learn(1, 2);
+    learn(2, 7);
+    learn(3, 3);
+    EXPECT_EQ(estimator.PairCount(), 4u);
+
+    learn(4, 1);  // 淘汰样本最少的网格对 1
+    EXPECT_EQ(estimator.PairCount(), 4u);
+    EXPECT_EQ(samples(1), 0u);
+    EXPECT_EQ(samples(0), 5u);
+    EXPECT_EQ(samples(2), 7u);
+    EXPECT_EQ(samples(3), 3u);
+    EXPECT_EQ(samples(4), 1u);
+
+    learn(5, 1);  // 新网格对 4 只有 1 个样本，被淘汰
+    EXPECT_EQ(samples(4), 0u);
+    EXPECT_EQ(samples(5), 1u);
+    EXPECT_EQ(samples(2), 7u);
+}
+
+} // namespace
@@ -0,0 +1,78 @@
+#include "util/write_behind_buffer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+
+namespace {
+
+using Buffer = WriteBehindBuffer<std::string>;
+
+// 数据库持续故障：刷新按指数退避，不会因待写条数已满而空转
+TEST(WriteBehindBufferTest, BacksOffWhileFlushFails) {
+    std::atomic<int> calls{0};
+    WriteBehindOptions options;
+    options.max_pending = 1;
+    options.flush_interval_ms = 10;
+    options.max_backoff_ms = 80;
+    {
+        Buffer buffer([&](const Buffer::Batch&) {
+            ++calls;
+            return false;
+        }, options);
+        for (int i = 0; i < 100; ++i) {
+            buffer.Touch("addr" + std::to_string(i), i + 1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        // 退避序列 10, 20, 40, 80, 80 ms…：200 ms 内至多 5 次
+        EXPECT_LE(calls.load(), 6);
+        EXPECT_GE(calls.load(), 2);
+        EXPECT_EQ(buffer.PendingCount(), 100u);
+        int64_t ts = 0;
+        ASSERT_TRUE(buffer.Get("addr7", ts));
+        EXPECT_EQ(ts, 8);
+    }
+}
+
+// 故障期间待写 key 数有上限：已有 key 照常合并，新 key 被丢弃
+TEST(WriteBehindBufferTest, CapsPendingKeysDuringOutage) {
+    WriteBehindOptions options;
+    options.flush_interval_ms = 60000;
+    options.max_pending = 1u << 20;
+    options.max_keys = 10;
+    Buffer buffer([](const Buffer::Batch&) { return false; }, options);
+    for (int i = 0; i < 20; ++i) {
+        buffer.Touch("addr" + std::to_string(i), 1);
+    }
+    buffer.Touch("addr3", 5);
+    EXPECT_EQ(buffer.PendingCount(), 10u);
+    EXPECT_EQ(buffer.DroppedCount(), 10u);
+    int64_t ts = 0;
+    ASSERT_TRUE(buffer.Get("addr3", ts));
+    EXPECT_EQ(ts, 5);
+    EXPECT_FALSE(buffer.Get("addr15", ts));
+
+    // 失败的刷新把数据并回待写表，不超过上限
+    EXPECT_EQ(buffer.Flush(), 0u);
+    EXPECT_EQ(buffer.PendingCount(), 10u);
+    EXPECT_EQ(buffer.FailedFlushCount(), 1u);
+}
+
+// 恢复后按 key 合并（保留最大时间戳）一次写入
+TEST(WriteBehindBufferTest, FlushesMergedMaxTimestamp) {
+    Buffer::Batch written;
+    WriteBehindOptions options;
+    options.flush_interval_ms = 60000;
+    Buffer buffer([&](const Buffer::Batch& batch) {
+        written = batch;
+        return true;
+    }, options);
+    buffer.Touch("a", 3);
+    buffer.Touch("a", 9);
+    buffer.Touch("a", 4);
+    EXPECT_EQ(buffer.Flush(), 1u);
+    ASSERT_EQ(written.size(), 1u);
+    EXPECT_EQ(written[0].second, 9);
+    EXPECT_EQ(buffer.PendingCount(), 0u);
+}
+
+} // namespace
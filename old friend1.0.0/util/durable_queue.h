@@ -0,0 +1,542 @@
+#ifndef DURABLE_QUEUE_H
+#define DURABLE_QUEUE_H
+
+#include "core/logger.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+/**
+ * 本地持久化队列参数
+ */
+struct DurableQueueOptions {
+    size_t segment_bytes = 64u << 20;   // 单个段文件大小上限，超过后切换到新段
+    size_t max_batch = 256;             // 每个消费线程一次处理的最大条数
+    size_t workers = 2;                 // 消费线程数（一批记录按分区键切成 workers 份并行处理）
+    bool sync_before_ack = false;       // Append 返回前 fdatasync（多个并发写入合并为一次），新建段文件时同步目录，
+                                        // 可防断电丢失；关闭时写入页缓存即返回，只防进程崩溃。确认即不再重发的场景必须开启
+    int retry_initial_ms = 200;         // 处理失败后的首次重试延迟
+    int retry_max_ms = 30000;           // 重试延迟上限（指数退避）
+};
+
+/**
+ * 本地持久化队列统计
+ */
+struct DurableQueueStats {
+    uint64_t appended = 0;      // 本次启动后写入的记录数
+    uint64_t recovered = 0;     // 启动时从磁盘恢复的未处理记录数
+    uint64_t delivered = 0;     // 已处理并提交消费位置的记录数
+    uint64_t batches = 0;       // 已提交的批次数
+    uint64_t retries = 0;       // 批次处理失败后的重试次数
+    uint64_t truncated = 0;     // 启动时截掉的残缺尾部记录数
+    uint64_t pending = 0;       // 当前未处理的记录数
+};
+
+/**
+ * 本地持久化队列：追加写段文件 + 消费位置文件
+ * - 记录格式：[u32 长度][u32 FNV-1a 校验][数据]，段文件名为 16 位十进制段号（<段号>.seg）
+ * - Append 写入后即可确认；后台线程按顺序读出一批，按分区键哈希切分给多个消费线程并行处理，
+ *   同一分区键的记录在同一线程内保持追加顺序；全部成功后先写消费位置（临时文件 + rename）再删除已消费完的段
+ * - 处理失败时整批按指数退避重试，不越过失败的记录；进程崩溃后从消费位置重放，
+ *   同一记录可能被处理多次（至少一次），消费方需要幂等
+ * - 启动时校验未消费的记录，截掉写到一半的尾部记录
+ */
+class DurableQueue {
+public:
+    // 处理一批记录（同一批由一个事务落库），返回 false 表示需要重试
+    using DrainFn = std::function<bool(const std::vector<std::string>& records)>;
+    // 记录的分区键哈希（如支付回调的商户订单号），同一分区键的记录由同一消费线程按顺序处理
+    using PartitionFn = std::function<size_t(const std::string& record)>;
+
+    /**
+     * 打开（不存在时逐级创建）队列目录并恢复未处理的记录
+     * @throw std::runtime_error 目录或段文件无法打开
+     */
+    explicit DurableQueue(const std::string& dir, DurableQueueOptions options = DurableQueueOptions())
+        : dir_(dir), options_(options) {
+        if (options_.workers == 0) options_.workers = 1;
+        if (options_.max_batch == 0) options_.max_batch = 1;
+        if (!MakeDirs(dir_)) {
+            throw std::runtime_error("无法创建队列目录: " + dir_);
+        }
+        Recover();
+    }
+
+    ~DurableQueue() {
+        Stop();
+        if (write_fd_ >= 0) ::close(write_fd_);
+        if (read_fd_ >= 0) ::close(read_fd_);
+    }
+
+    DurableQueue(const DurableQueue&) = delete;
+    DurableQueue& operator=(const DurableQueue&) = delete;
+
+    /**
+     * 追加一条记录
+     * @return true=已持久化（sync_before_ack 时已落盘），可以向调用方确认
+     */
+    bool Append(const std::string& record) {
+        if (record.size() > kMaxRecordBytes) {
+            return false;
+        }
+        std::string buf(kHeaderBytes + record.size(), '\0');
+        uint32_t header[2] = {static_cast<uint32_t>(record.size()), Checksum(record.data(), record.size())};
+        std::memcpy(&buf[0], header, kHeaderBytes);
+        std::memcpy(&buf[kHeaderBytes], record.data(), record.size());
+
+        Position end;
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            if (write_fd_ < 0) {
+                return false;
+            }
+            if (write_pos_.offset > 0 && write_pos_.offset + buf.size() > options_.segment_bytes && !Roll()) {
+                return false;
+            }
+            if (!WriteAll(write_fd_, buf.data(), buf.size())) {
+                SPDLOG_ERROR("Durable queue append failed (dir={}, errno={})", dir_, errno);
+                // 丢弃可能写了一半的记录，保持段文件可解析
+                if (::ftruncate(write_fd_, static_cast<off_t>(write_pos_.offset)) != 0 ||
+                    ::lseek(write_fd_, static_cast<off_t>(write_pos_.offset), SEEK_SET) < 0) {
+                    ::close(write_fd_);
+                    write_fd_ = -1;
+                }
+                return false;
+            }
+            write_pos_.offset += buf.size();
+            end = write_pos_;
+            pending_.fetch_add(1, std::memory_order_relaxed);
+        }
+        appended_.fetch_add(1, std::memory_order_relaxed);
+        if (options_.sync_before_ack && !SyncTo(end)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(read_mutex_); // 与消费线程的等待条件检查串行，避免漏唤醒
+        }
+        read_cv_.notify_one();
+        return true;
+    }
+
+    /**
+     * 启动后台消费（启动前已在磁盘上的记录会先被处理）
+     * @param partition_fn 未设置时整批由一个线程处理（workers 不生效），记录间的先后完全保持
+     */
+    void Start(DrainFn drain_fn, PartitionFn partition_fn = nullptr) {
+        std::lock_guard<std::mutex> lock(read_mutex_);
+        if (running_) {
+            return;
+        }
+        drain_fn_ = std::move(drain_fn);
+        partition_fn_ = std::move(partition_fn);
+        running_ = true;
+        worker_ = std::thread([this] { DrainLoop(); });
+    }
+
+    /**
+     * 停止后台消费（未处理的记录留在磁盘上，下次启动继续）
+     */
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(read_mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        read_cv_.notify_all();
+        worker_.join();
+    }
+
+    DurableQueueStats GetStats() const {
+        DurableQueueStats stats;
+        stats.appended = appended_.load(std::memory_order_relaxed);
+        stats.recovered = recovered_;
+        stats.delivered = delivered_.load(std::memory_order_relaxed);
+        stats.batches = batches_.load(std::memory_order_relaxed);
+        stats.retries = retries_.load(std::memory_order_relaxed);
+        stats.truncated = truncated_;
+        stats.pending = pending_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static constexpr size_t kHeaderBytes = 8;
+    static constexpr size_t kMaxRecordBytes = 1u << 20;
+
+    struct Position {
+        uint64_t segment = 0;
+        uint64_t offset = 0;
+        bool operator<(const Position& other) const {
+            return segment != other.segment ? segment < other.segment : offset < other.offset;
+        }
+    };
+
+    static uint32_t Checksum(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    static bool WriteAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = ::write(fd, data, size);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // 逐级创建目录（mkdir -p）
+    static bool MakeDirs(const std::string& dir) {
+        for (size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+            std::string prefix = dir.substr(0, pos);
+            if (!prefix.empty() && ::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+            if (pos == std::string::npos) {
+                return true;
+            }
+        }
+    }
+
+    std::string SegmentPath(uint64_t segment) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%016" PRIu64 ".seg", segment);
+        return dir_ + name;
+    }
+
+    std::string CursorPath() const { return dir_ + "/cursor"; }
+
+    // 读取一条记录：成功时返回记录总长度，残缺或校验失败返回 0
+    static size_t ReadRecord(int fd, uint64_t offset, std::string& out) {
+        uint32_t header[2];
+        if (::pread(fd, header, kHeaderBytes, static_cast<off_t>(offset)) != static_cast<ssize_t>(kHeaderBytes) ||
+            header[0] > kMaxRecordBytes) {
+            return 0;
+        }
+        out.resize(header[0]);
+        if (header[0] > 0 &&
+            ::pread(fd, &out[0], header[0], static_cast<off_t>(offset + kHeaderBytes)) != static_cast<ssize_t>(header[0])) {
+            return 0;
+        }
+        if (Checksum(out.data(), out.size()) != header[1]) {
+            return 0;
+        }
+        return kHeaderBytes + header[0];
+    }
+
+    void Recover() {
+        std::vector<uint64_t> segments;
+        if (DIR* dir = ::opendir(dir_.c_str())) {
+            while (dirent* entry = ::readdir(dir)) {
+                const char* name = entry->d_name;
+                size_t len = std::strlen(name);
+                if (len == 20 && std::strcmp(name + 16, ".seg") == 0) {
+                    segments.push_back(std::strtoull(name, nullptr, 10));
+                }
+            }
+            ::closedir(dir);
+        }
+        std::sort(segments.begin(), segments.end());
+
+        // 消费位置：[u64 段号][u64 偏移]
+        Position cursor;
+        if (FILE* file = std::fopen(CursorPath().c_str(), "rb")) {
+            uint64_t value[2];
+            if (std::fread(value, sizeof(value), 1, file) == 1) {
+                cursor.segment = value[0];
+                cursor.offset = value[1];
+            }
+            std::fclose(file);
+        } else if (!segments.empty()) {
+            cursor.segment = segments.front();
+        }
+
+        // 校验未消费的段，截掉残缺的尾部
+        std::string record;
+        uint64_t pending = 0;
+        for (uint64_t segment : segments) {
+            if (segment < cursor.segment) {
+                std::remove(SegmentPath(segment).c_str());
+                continue;
+            }
+            int fd = ::open(SegmentPath(segment).c_str(), O_RDWR | O_CLOEXEC);
+            if (fd < 0) {
+                throw std::runtime_error("无法打开队列段文件: " + SegmentPath(segment));
+            }
+            struct stat st;
+            uint64_t size = ::fstat(fd, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+            uint64_t offset = segment == cursor.segment ? std::min<uint64_t>(cursor.offset, size) : 0;
+            while (offset < size) {
+                size_t n = ReadRecord(fd, offset, record);
+                if (n == 0) break;
+                offset += n;
+                ++pending;
+            }
+            if (offset < size) {
+                SPDLOG_WARN("Durable queue truncated damaged tail (segment={}, offset={}, size={})", segment, offset, size);
+                ++truncated_;
+                if (::ftruncate(fd, static_cast<off_t>(offset)) != 0) {
+                    ::close(fd);
+                    throw std::runtime_error("无法修复队列段文件: " + SegmentPath(segment));
+                }
+            }
+            if (segment == segments.back()) {
+                write_fd_ = fd;
+                write_pos_ = Position{segment, offset};
+            } else {
+                ::close(fd);
+            }
+        }
+        if (write_fd_ < 0) {
+            write_pos_ = Position{cursor.segment, 0};
+            write_fd_ = ::open(SegmentPath(write_pos_.segment).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (write_fd_ < 0) {
+                throw std::runtime_error("无法创建队列段文件: " + SegmentPath(write_pos_.segment));
+            }
+            if (options_.sync_before_ack) {
+                SyncDir();
+            }
+        }
+        if (write_pos_ < cursor) {
+            cursor = write_pos_;
+        }
+        ::lseek(write_fd_, static_cast<off_t>(write_pos_.offset), SEEK_SET);
+        read_pos_ = cursor;
+        synced_ = write_pos_;
+        recovered_ = pending;
+        pending_.store(pending, std::memory_order_relaxed);
+        if (pending > 0) {
+            SPDLOG_INFO("Durable queue recovered {} pending records (dir={})", pending, dir_);
+        }
+    }
+
+    // 切换到新段（持有 write_mutex_）
+    bool Roll() {
+        if (options_.sync_before_ack) {
+            ::fdatasync(write_fd_);
+        }
+        int fd = ::open(SegmentPath(write_pos_.segment + 1).c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            SPDLOG_ERROR("Durable queue roll segment failed (dir={}, errno={})", dir_, errno);
+            return false;
+        }
+        if (options_.sync_before_ack && !SyncDir()) {
+            ::close(fd);
+            return false;
+        }
+        ::close(write_fd_);
+        write_fd_ = fd;
+        write_pos_ = Position{write_pos_.segment + 1, 0};
+        return true;
+    }
+
+    // 同步目录项（新建的段文件断电后仍可见）
+    bool SyncDir() const {
+        int fd = ::open(dir_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = ::fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+    }
+
+    // 组提交：等待到 end 为止的数据落盘，并发调用方共用一次 fdatasync
+    bool SyncTo(const Position& end) {
+        std::lock_guard<std::mutex> lock(sync_mutex_);
+        if (!(synced_ < end)) {
+            return true;
+        }
+        Position target;
+        int fd;
+        {
+            std::lock_guard<std::mutex> write_lock(write_mutex_);
+            target = write_pos_;
+            fd = write_fd_ >= 0 ? ::dup(write_fd_) : -1; // 切段时旧段已在 Roll 中落盘
+        }
+        bool ok = fd >= 0 && ::fdatasync(fd) == 0;
+        if (fd >= 0) ::close(fd);
+        if (ok) {
+            synced_ = target;
+        }
+        return ok;
+    }
+
+    // 从 read_pos_ 起读出至多 limit 条已写入的记录，返回读完后的位置
+    Position ReadBatch(size_t limit, std::vector<std::string>& out) {
+        Position pos = read_pos_;
+        Position end;
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            end = write_pos_;
+        }
+        std::string record;
+        while (out.size() < limit && pos < end) {
+            if (read_fd_ < 0 || read_segment_ != pos.segment) {
+                if (read_fd_ >= 0) ::close(read_fd_);
+                read_fd_ = ::open(SegmentPath(pos.segment).c_str(), O_RDONLY | O_CLOEXEC);
+                read_segment_ = pos.segment;
+                if (read_fd_ < 0) {
+                    break;
+                }
+            }
+            size_t n = ReadRecord(read_fd_, pos.offset, record);
+            if (n == 0) {
+                if (pos.segment < end.segment) {
+                    pos = Position{pos.segment + 1, 0}; // 段已读完
+                    continue;
+                }
+                break;
+            }
+            out.push_back(record);
+            pos.offset += n;
+        }
+        return pos;
+    }
+
+    bool SaveCursor(const Position& pos) {
+        std::string tmp = CursorPath() + ".tmp";
+        FILE* file = std::fopen(tmp.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        uint64_t value[2] = {pos.segment, pos.offset};
+        bool ok = std::fwrite(value, sizeof(value), 1, file) == 1;
+        ok = std::fflush(file) == 0 && ok;
+        if (options_.sync_before_ack) {
+            ok = ::fdatasync(fileno(file)) == 0 && ok;
+        }
+        std::fclose(file);
+        return ok && std::rename(tmp.c_str(), CursorPath().c_str()) == 0;
+    }
+
+    bool Deliver(const std::vector<std::string>& records) {
+        size_t chunks = std::min(options_.workers, (records.size() + options_.max_batch - 1) / options_.max_batch);
+        if (chunks <= 1 || !partition_fn_) {
+            return TryDrain(records);
+        }
+        std::vector<std::vector<std::string>> parts(chunks);
+        for (const auto& record : records) {
+            size_t hash = 0;
+            try {
+                hash = partition_fn_(record);
+            } catch (const std::exception& e) {
+                SPDLOG_WARN("Durable queue partition error, use partition 0: {}", e.what());
+            }
+            parts[hash % chunks].push_back(record);
+        }
+        std::vector<std::future<bool>> futures;
+        for (size_t i = 1; i < chunks; ++i) {
+            if (parts[i].empty()) continue;
+            futures.push_back(std::async(std::launch::async, [this, &parts, i] { return TryDrain(parts[i]); }));
+        }
+        bool ok = parts[0].empty() || TryDrain(parts[0]);
+        for (auto& future : futures) {
+            ok = future.get() && ok;
+        }
+        return ok;
+    }
+
+    bool TryDrain(const std::vector<std::string>& records) {
+        try {
+            return drain_fn_(records);
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("Durable queue drain error (count={}): {}", records.size(), e.what());
+            return false;
+        }
+    }
+
+    void DrainLoop() {
+        std::vector<std::string> batch;
+        int delay_ms = options_.retry_initial_ms;
+        std::unique_lock<std::mutex> lock(read_mutex_);
+        while (running_) {
+            read_cv_.wait(lock, [this] {
+                return !running_ || pending_.load(std::memory_order_relaxed) > 0;
+            });
+            if (!running_) break;
+            lock.unlock();
+
+            batch.clear();
+            Position next = ReadBatch(options_.max_batch * (partition_fn_ ? options_.workers : 1), batch);
+            bool ok = batch.empty() || Deliver(batch);
+            if (ok && read_pos_ < next) {
+                if (!SaveCursor(next)) {
+                    SPDLOG_WARN("Durable queue save cursor failed (dir={})", dir_);
+                }
+                for (uint64_t segment = read_pos_.segment; segment < next.segment; ++segment) {
+                    std::remove(SegmentPath(segment).c_str());
+                }
+                read_pos_ = next;
+                pending_.fetch_sub(batch.size(), std::memory_order_relaxed);
+                delivered_.fetch_add(batch.size(), std::memory_order_relaxed);
+                batches_.fetch_add(1, std::memory_order_relaxed);
+                delay_ms = options_.retry_initial_ms;
+            }
+
+            lock.lock();
+            if (!ok) {
+                retries_.fetch_add(1, std::memory_order_relaxed);
+                read_cv_.wait_for(lock, std::chrono::milliseconds(delay_ms), [this] { return !running_; });
+                delay_ms = std::min(delay_ms * 2, options_.retry_max_ms);
+            } else if (batch.empty()) {
+                // 记录已计数但尚未读到（段切换中），稍后再读
+                read_cv_.wait_for(lock, std::chrono::milliseconds(1), [this] { return !running_; });
+            }
+        }
+    }
+
+    std::string dir_;
+    DurableQueueOptions options_;
+
+    std::mutex write_mutex_;
+    int write_fd_ = -1;
+    Position write_pos_;                // 下一条记录的写入位置
+
+    std::mutex sync_mutex_;
+    Position synced_;                   // 已落盘位置
+
+    std::mutex read_mutex_;
+    std::condition_variable read_cv_;
+    DrainFn drain_fn_;
+    PartitionFn partition_fn_;
+    bool running_ = false;
+    std::thread worker_;
+    Position read_pos_;                 // 已提交的消费位置（仅消费线程访问）
+    int read_fd_ = -1;
+    uint64_t read_segment_ = 0;
+
+    std::atomic<uint64_t> pending_{0};
+    std::atomic<uint64_t> appended_{0};
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> retries_{0};
+    uint64_t recovered_ = 0;
+    uint64_t truncated_ = 0;
+};
+
+#endif // DURABLE_QUEUE_H
@@ -0,0 +1,244 @@
+#ifndef GEO_BATCH_H
+#define GEO_BATCH_H
+
+#include "util/geo_util.h"
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GEO_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * 候选点集合（结构数组）：经纬度按列存放，并预先换算为单位球面坐标 (x, y, z)
+ * 候选点（医院、司机等）的三角函数只在加入时计算一次，批量求距离时只剩乘加与一次 asin
+ */
+struct GeoPointArray {
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+
+    void Reserve(size_t n) {
+        latitude.reserve(n);
+        longitude.reserve(n);
+        x.reserve(n);
+        y.reserve(n);
+        z.reserve(n);
+    }
+
+    void Add(double lat, double lon) {
+        double lat_rad = lat * GeoUtil::kDegToRad;
+        double lon_rad = lon * GeoUtil::kDegToRad;
+        latitude.push_back(lat);
+        longitude.push_back(lon);
+        x.push_back(std::cos(lat_rad) * std::cos(lon_rad));
+        y.push_back(std::cos(lat_rad) * std::sin(lon_rad));
+        z.push_back(std::sin(lat_rad));
+    }
+
+    void Clear() {
+        latitude.clear();
+        longitude.clear();
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    size_t Size() const { return latitude.size(); }
+};
+
+/**
+ * 批量球面距离计算：一个原点对一组候选点
+ * 与 Haversine 公式等价：hav(θ) = (弦长/2)²，距离 = 2R·asin(弦长/2)，弦长由单位向量之差求得
+ * - x86-64 下运行时选择 AVX2（4路）或 SSE2（2路），其余平台走标量实现
+ * - asin 在弦长较小时（约600km以内）用展开到11次的级数，误差低于1e-15；更远的点逐个回退到 std::asin
+ */
+class GeoBatch {
+public:
+    enum class Kernel {
+        SCALAR = 0,
+        SSE2 = 1,
+        AVX2 = 2
+    };
+
+    /**
+     * 计算原点到 points[begin, end) 的距离（km，不取整），写入 out[0, end-begin)
+     */
+    static void DistancesKm(double origin_lat, double origin_lon, const GeoPointArray& points,
+                            size_t begin, size_t end, double* out) {
+        Origin origin = MakeOrigin(origin_lat, origin_lon);
+        Run(ActiveKernel(), origin, points, begin, end, out);
+    }
+
+    /**
+     * 计算原点到全部候选点的距离
+     */
+    static void DistancesKm(double origin_lat, double origin_lon, const GeoPointArray& points,
+                            std::vector<double>& out) {
+        out.resize(points.Size());
+        DistancesKm(origin_lat, origin_lon, points, 0, points.Size(), out.data());
+    }
+
+    /**
+     * 指定实现计算（用于精度校验与性能对比；CPU 不支持时退化为可用的最高实现）
+     */
+    static void DistancesKmWith(Kernel kernel, double origin_lat, double origin_lon,
+                                const GeoPointArray& points, std::vector<double>& out) {
+        out.resize(points.Size());
+        Kernel best = ActiveKernel();
+        Run(kernel > best ? best : kernel, MakeOrigin(origin_lat, origin_lon), points, 0, points.Size(), out.data());
+    }
+
+    /**
+     * 当前CPU可用的最高实现
+     */
+    static Kernel ActiveKernel() {
+#ifdef GEO_BATCH_X86
+        static const Kernel kernel = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+            ? Kernel::AVX2 : Kernel::SSE2;
+        return kernel;
+#else
+        return Kernel::SCALAR;
+#endif
+    }
+
+private:
+    struct Origin {
+        double x, y, z;
+    };
+
+    // asin 级数适用上限（半弦长），超过时回退到 std::asin
+    static constexpr double kSeriesLimit = 0.05;
+    // asin(h) = h + h³/6 + 3h⁵/40 + 5h⁷/112 + 35h⁹/1152 + 63h¹¹/2816
+    static constexpr double kC3 = 1.0 / 6.0;
+    static constexpr double kC5 = 3.0 / 40.0;
+    static constexpr double kC7 = 5.0 / 112.0;
+    static constexpr double kC9 = 35.0 / 1152.0;
+    static constexpr double kC11 = 63.0 / 2816.0;
+    static constexpr double kTwoR = 2.0 * GeoUtil::kEarthRadiusKm;
+
+    static Origin MakeOrigin(double lat, double lon) {
+        double lat_rad = lat * GeoUtil::kDegToRad;
+        double lon_rad = lon * GeoUtil::kDegToRad;
+        return Origin{std::cos(lat_rad) * std::cos(lon_rad), std::cos(lat_rad) * std::sin(lon_rad), std::sin(lat_rad)};
+    }
+
+    static void Run(Kernel kernel, const Origin& origin, const GeoPointArray& points,
+                    size_t begin, size_t end, double* out) {
+#ifdef GEO_BATCH_X86
+        if (kernel == Kernel::AVX2) {
+            RunAvx2(origin, points, begin, end, out);
+            return;
+        }
+        if (kernel == Kernel::SSE2) {
+            RunSse2(origin, points, begin, end, out);
+            return;
+        }
+#endif
+        RunScalar(origin, points, begin, end, out);
+    }
+
+    static double HalfChordToKm(double h) {
+        if (h > kSeriesLimit) {
+            return kTwoR * std::asin(h > 1.0 ? 1.0 : h);
+        }
+        double h2 = h * h;
+        double p = kC11;
+        p = p * h2 + kC9;
+        p = p * h2 + kC7;
+        p = p * h2 + kC5;
+        p = p * h2 + kC3;
+        return kTwoR * (h + h * h2 * p);
+    }
+
+    static void RunScalar(const Origin& origin, const GeoPointArray& points,
+                          size_t begin, size_t end, double* out) {
+        for (size_t i = begin; i < end; ++i) {
+            double dx = points.x[i] - origin.x;
+            double dy = points.y[i] - origin.y;
+            double dz = points.z[i] - origin.z;
+            out[i - begin] = HalfChordToKm(0.5 * std::sqrt(dx * dx + dy * dy + dz * dz));
+        }
+    }
+
+#ifdef GEO_BATCH_X86
+    static void RunSse2(const Origin& origin, const GeoPointArray& points,
+                        size_t begin, size_t end, double* out) {
+        const __m128d ox = _mm_set1_pd(origin.x);
+        const __m128d oy = _mm_set1_pd(origin.y);
+        const __m128d oz = _mm_set1_pd(origin.z);
+        const __m128d half = _mm_set1_pd(0.5);
+        const __m128d limit = _mm_set1_pd(kSeriesLimit);
+        size_t i = begin;
+        for (; i + 2 <= end; i += 2) {
+            __m128d dx = _mm_sub_pd(_mm_loadu_pd(&points.x[i]), ox);
+            __m128d dy = _mm_sub_pd(_mm_loadu_pd(&points.y[i]), oy);
+            __m128d dz = _mm_sub_pd(_mm_loadu_pd(&points.z[i]), oz);
+            __m128d c2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+            __m128d h = _mm_mul_pd(half, _mm_sqrt_pd(c2));
+            __m128d h2 = _mm_mul_pd(h, h);
+            __m128d p = _mm_set1_pd(kC11);
+            p = _mm_add_pd(_mm_mul_pd(p, h2), _mm_set1_pd(kC9));
+            p = _mm_add_pd(_mm_mul_pd(p, h2), _mm_set1_pd(kC7));
+            p = _mm_add_pd(_mm_mul_pd(p, h2), _mm_set1_pd(kC5));
+            p = _mm_add_pd(_mm_mul_pd(p, h2), _mm_set1_pd(kC3));
+            __m128d dist = _mm_mul_pd(_mm_set1_pd(kTwoR), _mm_add_pd(h, _mm_mul_pd(_mm_mul_pd(h, h2), p)));
+            _mm_storeu_pd(&out[i - begin], dist);
+            int far_mask = _mm_movemask_pd(_mm_cmpgt_pd(h, limit));
+            if (far_mask != 0) {
+                FixFarLanes(h, far_mask, &out[i - begin], 2);
+            }
+        }
+        RunScalar(origin, points, i, end, out + (i - begin));
+    }
+
+    __attribute__((target("avx2,fma")))
+    static void RunAvx2(const Origin& origin, const GeoPointArray& points,
+                        size_t begin, size_t end, double* out) {
+        const __m256d ox = _mm256_set1_pd(origin.x);
+        const __m256d oy = _mm256_set1_pd(origin.y);
+        const __m256d oz = _mm256_set1_pd(origin.z);
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d limit = _mm256_set1_pd(kSeriesLimit);
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(&points.x[i]), ox);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(&points.y[i]), oy);
+            __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(&points.z[i]), oz);
+            __m256d c2 = _mm256_fmadd_pd(dz, dz, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx)));
+            __m256d h = _mm256_mul_pd(half, _mm256_sqrt_pd(c2));
+            __m256d h2 = _mm256_mul_pd(h, h);
+            __m256d p = _mm256_set1_pd(kC11);
+            p = _mm256_fmadd_pd(p, h2, _mm256_set1_pd(kC9));
+            p = _mm256_fmadd_pd(p, h2, _mm256_set1_pd(kC7));
+            p = _mm256_fmadd_pd(p, h2, _mm256_set1_pd(kC5));
+            p = _mm256_fmadd_pd(p, h2, _mm256_set1_pd(kC3));
+            __m256d dist = _mm256_mul_pd(_mm256_set1_pd(kTwoR), _mm256_fmadd_pd(_mm256_mul_pd(h, h2), p, h));
+            _mm256_storeu_pd(&out[i - begin], dist);
+            int far_mask = _mm256_movemask_pd(_mm256_cmp_pd(h, limit, _CMP_GT_OQ));
+            if (far_mask != 0) {
+                alignas(32) double lanes[4];
+                _mm256_store_pd(lanes, h);
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (far_mask & (1 << lane)) out[i - begin + lane] = HalfChordToKm(lanes[lane]);
+                }
+            }
+        }
+        RunScalar(origin, points, i, end, out + (i - begin));
+    }
+
+    static void FixFarLanes(__m128d h, int far_mask, double* out, int width) {
+        alignas(16) double lanes[2];
+        _mm_store_pd(lanes, h);
+        for (int lane = 0; lane < width; ++lane) {
+            if (far_mask & (1 << lane)) out[lane] = HalfChordToKm(lanes[lane]);
+        }
+    }
+#endif
+};
+
+#endif // GEO_BATCH_H
@@ -0,0 +1,45 @@
+#ifndef GEO_UTIL_H
+#define GEO_UTIL_H
+
+#include <cmath>
+
+/**
+ * 地理计算工具类：统一的地球半径/π常量与Haversine距离，供医院、打车等模块共用
+ */
+class GeoUtil {
+public:
+    static constexpr double kEarthRadiusKm = 6371.0;            // 地球半径（km）
+    static constexpr double kPi = 3.14159265358979323846;       // 圆周率（不再使用 3.14 近似值）
+    static constexpr double kDegToRad = kPi / 180.0;            // 角度 → 弧度
+    static constexpr double kKmPerDegreeLat = kEarthRadiusKm * kDegToRad; // 每度纬度对应的公里数（约111.19km）
+
+    /**
+     * 计算两点间球面距离（Haversine公式，单位：km，不做取整）
+     */
+    static double HaversineKm(double lat1, double lon1, double lat2, double lon2) {
+        double dLat = (lat2 - lat1) * kDegToRad;
+        double dLon = (lon2 - lon1) * kDegToRad;
+        double sin_lat = std::sin(dLat / 2);
+        double sin_lon = std::sin(dLon / 2);
+        double a = sin_lat * sin_lat +
+                   std::cos(lat1 * kDegToRad) * std::cos(lat2 * kDegToRad) * sin_lon * sin_lon;
+        double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+        return kEarthRadiusKm * c;
+    }
+
+    /**
+     * 距离保留1位小数（适配老年人认知习惯，与原有显示规则一致）
+     */
+    static double RoundDistance(double distance_km) {
+        return std::round(distance_km * 10) / 10;
+    }
+
+    /**
+     * 指定纬度处每度经度对应的公里数（用于网格划分和范围估算）
+     */
+    static double KmPerDegreeLon(double latitude) {
+        return kKmPerDegreeLat * std::cos(latitude * kDegToRad);
+    }
+};
+
+#endif // GEO_UTIL_H
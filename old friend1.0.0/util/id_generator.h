@@ -0,0 +1,228 @@
+#ifndef ID_GENERATOR_H
+#define ID_GENERATOR_H
+
+#include "core/logger.h"
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cerrno>
+#include <stdexcept>
+#include <functional>
+#include <inttypes.h>
+
+/**
+ * 64 位分布式唯一ID生成器（Snowflake 布局）
+ * - 布局：[0][41 位毫秒时间戳（自 2025-01-01 起，可用约 69 年）][8 位节点号][14 位序号]，ID 随时间递增，可直接作为 BIGINT 主键
+ * - 发号上限：每个节点每毫秒 16384 个序号（约 1638 万/秒），与线程数无关；持续超出时先借用未来时间，
+ *   领先墙钟 kMaxAheadMs 后 Next 等待时钟前进（表现为发号变慢，不会重号）。需要更高吞吐时应增加节点
+ * - 节点内各线程从一个原子计数器按块（256 个）租用 (毫秒, 序号)，块内发号只访问线程局部状态，不加锁、无原子操作
+ * - 某毫秒的序号用完后进位到下一毫秒（借用未来时间），领先墙钟的幅度不超过 kMaxAheadMs，超出时等待时钟追上
+ * - 时钟回拨时沿用已发出的最大时间继续递增，不会产生重复ID；回拨超过 kMaxAheadMs 时记录告警
+ * - 启动时从“当前时间 + kMaxAheadMs”开始发号，上一次运行借用的未来时间不会与本次重叠
+ * - NODE_ID 在服务启动时由 Init 校验，配置错误让启动失败，而不是在第一次下单时抛出
+ */
+class IdGenerator {
+public:
+    static constexpr int kTimestampBits = 41;
+    static constexpr int kNodeBits = 8;
+    static constexpr int kSequenceBits = 14;
+    static constexpr uint64_t kMaxNodeId = (1ull << kNodeBits) - 1;
+    static constexpr int64_t kEpochMs = 1735660800000LL;     // 2025-01-01 00:00:00 +08:00
+    static constexpr int64_t kMaxAheadMs = 1000;             // 允许领先墙钟的最大毫秒数
+
+    // 时钟：返回 Unix 毫秒时间戳
+    using Clock = std::function<int64_t()>;
+
+    static IdGenerator& GetInstance() {
+        static IdGenerator instance;
+        return instance;
+    }
+
+    /**
+     * 启动检查（服务启动时调用一次）：创建全局实例并解析 NODE_ID
+     * @param require_node_id true 时 NODE_ID 未设置也视为配置错误（多实例部署应为 true）
+     * @throws std::invalid_argument NODE_ID 非法，或要求配置而未配置
+     */
+    static void Init(bool require_node_id = false) {
+        IdGenerator& generator = GetInstance();
+        if (require_node_id && !generator.NodeIdConfigured()) {
+            throw std::invalid_argument("IdGenerator NODE_ID is not set");
+        }
+        SPDLOG_INFO("IdGenerator node_id={}", generator.NodeId());
+    }
+
+    /**
+     * 独立实例（不读 NODE_ID；用于测试或注入时钟）
+     */
+    IdGenerator(uint64_t node_id, Clock clock) : clock_(std::move(clock)) {
+        SetNodeId(node_id);
+        StartTicks();
+    }
+
+    IdGenerator(const IdGenerator&) = delete;
+    IdGenerator& operator=(const IdGenerator&) = delete;
+
+    /**
+     * 设置节点号（多实例部署时每个实例唯一，0~255；需在首次发号前调用）
+     * 未设置时取环境变量 NODE_ID；NODE_ID 也未设置时节点号为 0 并记录错误日志（多实例下ID会重复）
+     * @throws std::invalid_argument 节点号超出范围（截断会与其他节点重号）
+     */
+    void SetNodeId(uint64_t node_id) {
+        if (node_id > kMaxNodeId) {
+            throw std::invalid_argument("IdGenerator node_id " + std::to_string(node_id) + " out of range [0, " +
+                                        std::to_string(kMaxNodeId) + "]");
+        }
+        node_bits_.store(node_id << kSequenceBits, std::memory_order_relaxed);
+        node_configured_.store(true, std::memory_order_relaxed);
+    }
+
+    uint64_t NodeId() const {
+        return node_bits_.load(std::memory_order_relaxed) >> kSequenceBits;
+    }
+
+    /**
+     * 节点号是否显式配置过（NODE_ID 或 SetNodeId）；多实例部署的启动检查应要求为 true
+     */
+    bool NodeIdConfigured() const {
+        return node_configured_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * 生成一个 64 位ID（超过每毫秒 16384 个的上限且已领先墙钟 kMaxAheadMs 时等待时钟前进）
+     */
+    uint64_t Next() {
+        LocalBlock& block = Local();
+        if (block.owner != instance_id_ || block.next == block.end) {
+            Lease(block);
+        }
+        uint64_t tick = block.next++;
+        return ((tick >> kSequenceBits) << (kNodeBits + kSequenceBits)) |
+               node_bits_.load(std::memory_order_relaxed) |
+               (tick & ((1ull << kSequenceBits) - 1));
+    }
+
+    /**
+     * 生成带前缀的字符串ID（前缀 + 十进制ID，如 "PAY123456789012345678"）
+     */
+    std::string NextString(const char* prefix = "") {
+        char digits[20];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        uint64_t value = Next();
+        do {
+            *--p = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        std::string result(prefix);
+        result.append(p, end);
+        return result;
+    }
+
+    /**
+     * 从ID中取出生成时间（毫秒时间戳，借用未来时间时会略大于实际时间）
+     */
+    static int64_t TimestampMsOf(uint64_t id) {
+        return static_cast<int64_t>(id >> (kNodeBits + kSequenceBits)) + kEpochMs;
+    }
+
+    static uint64_t NodeIdOf(uint64_t id) {
+        return (id >> kSequenceBits) & kMaxNodeId;
+    }
+
+private:
+    static constexpr uint64_t kBlockSize = 256;           // 每次租用的序号数（16384 的约数，块与毫秒边界对齐）
+
+    // 线程局部的已租用区间 [next, end)，以 (毫秒 << 14 | 序号) 计；owner 为租用该区间的实例
+    struct LocalBlock {
+        uint64_t owner = 0;
+        uint64_t next = 0;
+        uint64_t end = 0;
+    };
+
+    IdGenerator() {
+        const char* env = std::getenv("NODE_ID");
+        if (env != nullptr && *env != '\0') {
+            SetNodeId(ParseNodeId(env));
+        } else {
+            SPDLOG_ERROR("IdGenerator NODE_ID is not set, node_id defaults to 0; "
+                         "every instance of a multi-instance deployment must set a distinct NODE_ID or IDs will collide");
+        }
+        StartTicks();
+    }
+
+    void StartTicks() {
+        int64_t now = NowMs();
+        wall_high_ms_.store(now, std::memory_order_relaxed);
+        ticks_.store(static_cast<uint64_t>(now + kMaxAheadMs) << kSequenceBits, std::memory_order_relaxed);
+    }
+
+    // 实例编号（线程局部区间据此区分所属实例，实例销毁后地址复用也不会误用旧区间）
+    static uint64_t NextInstanceId() {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 解析 NODE_ID（必须是 0~255 的十进制整数，非法值直接失败，不回退为 0）
+    static uint64_t ParseNodeId(const char* text) {
+        char* end = nullptr;
+        errno = 0;
+        unsigned long long value = std::strtoull(text, &end, 10);
+        if (errno != 0 || end == text || *end != '\0' || text[0] == '-') {
+            throw std::invalid_argument(std::string("IdGenerator invalid NODE_ID: ") + text);
+        }
+        return value;
+    }
+
+    static LocalBlock& Local() {
+        static thread_local LocalBlock block;
+        return block;
+    }
+
+    int64_t NowMs() const {
+        int64_t ms = clock_ ? clock_() : std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        return ms - kEpochMs;
+    }
+
+    // 租用一个序号块：起点不早于当前毫秒，领先墙钟（取见过的最大值）不超过 kMaxAheadMs
+    void Lease(LocalBlock& block) {
+        while (true) {
+            int64_t now = NowMs();
+            int64_t high = wall_high_ms_.load(std::memory_order_relaxed);
+            if (now > high) {
+                wall_high_ms_.compare_exchange_weak(high, now, std::memory_order_relaxed);
+                high = now;
+            } else if (now + kMaxAheadMs < high && !skew_warned_.exchange(true, std::memory_order_relaxed)) {
+                SPDLOG_WARN("IdGenerator clock moved backwards by {} ms, keep issuing from last timestamp", high - now);
+            }
+            uint64_t floor = static_cast<uint64_t>(high) << kSequenceBits;
+            uint64_t limit = static_cast<uint64_t>(high + kMaxAheadMs + 1) << kSequenceBits;
+            uint64_t current = ticks_.load(std::memory_order_relaxed);
+            while (true) {
+                uint64_t start = current < floor ? floor : current;
+                if (start + kBlockSize > limit) {
+                    break; // 借用已到上限，等待时钟前进
+                }
+                if (ticks_.compare_exchange_weak(current, start + kBlockSize, std::memory_order_relaxed)) {
+                    block.owner = instance_id_;
+                    block.next = start;
+                    block.end = start + kBlockSize;
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    Clock clock_;                               // 为空时取系统时钟
+    const uint64_t instance_id_ = NextInstanceId();
+    std::atomic<uint64_t> ticks_{0};            // 下一个可租用的 (毫秒 << 14 | 序号)
+    std::atomic<int64_t> wall_high_ms_{0};      // 见过的最大墙钟时间（相对 kEpochMs）
+    std::atomic<uint64_t> node_bits_{0};        // 节点号（已移位）
+    std::atomic<bool> skew_warned_{false};
+    std::atomic<bool> node_configured_{false};  // 节点号是否显式配置
+};
+
+#endif // ID_GENERATOR_H
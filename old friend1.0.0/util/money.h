@@ -0,0 +1,127 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <fmt/format.h>
+
+/**
+ * 金额（定点数，以分为单位的 64 位整数）
+ * - 加减、比较、乘整数数量均为精确整数运算，不再需要 round(x*100)/100 和误差比较
+ * - 按单价乘非整数数量（如里程）用 MulRatio：分子分母均为整数，结果四舍五入到分（远离零）
+ * - 与数据库 DECIMAL(10,2)、微信支付“分”单位之间按字符串/整数精确转换
+ */
+class Money {
+public:
+    constexpr Money() = default;
+
+    static constexpr Money FromCents(int64_t cents) { return Money(cents); }
+    static constexpr Money FromYuan(int64_t yuan) { return Money(yuan * 100); }
+
+    /**
+     * 解析十进制金额字符串（如 "12"、"12.5"、"-0.30"），最多两位小数
+     * @return false=格式错误或超出范围（out 不变）
+     */
+    static bool Parse(const std::string& text, Money& out) {
+        const char* p = text.c_str();
+        bool negative = *p == '-';
+        if (*p == '-' || *p == '+') ++p;
+        if (*p < '0' || *p > '9') return false;
+        // 元部分上限：yuan * 100 + 99 不超过 INT64_MAX
+        constexpr int64_t kMaxYuan = (INT64_MAX - 99) / 100;
+        int64_t yuan = 0;
+        while (*p >= '0' && *p <= '9') {
+            int digit = *p++ - '0';
+            if (yuan > (kMaxYuan - digit) / 10) return false;
+            yuan = yuan * 10 + digit;
+        }
+        int64_t fraction = 0;
+        if (*p == '.') {
+            ++p;
+            int digits = 0;
+            while (*p >= '0' && *p <= '9') {
+                if (++digits > 2) return false;
+                fraction = fraction * 10 + (*p++ - '0');
+            }
+            if (digits == 1) fraction *= 10;
+        }
+        if (*p != '\0') return false;
+        int64_t cents = yuan * 100 + fraction;
+        out = Money(negative ? -cents : cents);
+        return true;
+    }
+
+    /**
+     * 从浮点元换算（只用于对接仍以浮点表示金额的外部数据，四舍五入到分）
+     */
+    static Money FromYuanDouble(double yuan) { return Money(std::llround(yuan * 100)); }
+
+    constexpr int64_t Cents() const { return cents_; }
+    constexpr double ToYuan() const { return static_cast<double>(cents_) / 100; }
+    constexpr bool IsZero() const { return cents_ == 0; }
+    constexpr bool IsPositive() const { return cents_ > 0; }
+
+    /**
+     * 单价 × (numerator / denominator)，四舍五入到分（远离零）
+     * 例：2.30 元/km × 12345 m / 1000 = 28.39 元
+     */
+    constexpr Money MulRatio(int64_t numerator, int64_t denominator) const {
+        int64_t product = cents_ * numerator;
+        int64_t sign = (product > 0) - (product < 0);
+        return Money((product + sign * (denominator / 2)) / denominator);
+    }
+
+    /**
+     * 格式化为两位小数的元（如 "12.30"、"-0.05"）
+     */
+    std::string ToString() const {
+        char buf[32];
+        uint64_t abs = cents_ < 0 ? 0 - static_cast<uint64_t>(cents_) : static_cast<uint64_t>(cents_);
+        char* end = buf + sizeof(buf);
+        char* p = end;
+        *--p = static_cast<char>('0' + abs % 10);
+        *--p = static_cast<char>('0' + abs / 10 % 10);
+        *--p = '.';
+        abs /= 100;
+        do {
+            *--p = static_cast<char>('0' + abs % 10);
+            abs /= 10;
+        } while (abs != 0);
+        if (cents_ < 0) *--p = '-';
+        return std::string(p, end);
+    }
+
+    constexpr Money operator+(Money other) const { return Money(cents_ + other.cents_); }
+    constexpr Money operator-(Money other) const { return Money(cents_ - other.cents_); }
+    constexpr Money operator-() const { return Money(-cents_); }
+    constexpr Money operator*(int64_t quantity) const { return Money(cents_ * quantity); }
+    Money& operator+=(Money other) { cents_ += other.cents_; return *this; }
+    Money& operator-=(Money other) { cents_ -= other.cents_; return *this; }
+
+    constexpr bool operator==(Money other) const { return cents_ == other.cents_; }
+    constexpr bool operator!=(Money other) const { return cents_ != other.cents_; }
+    constexpr bool operator<(Money other) const { return cents_ < other.cents_; }
+    constexpr bool operator<=(Money other) const { return cents_ <= other.cents_; }
+    constexpr bool operator>(Money other) const { return cents_ > other.cents_; }
+    constexpr bool operator>=(Money other) const { return cents_ >= other.cents_; }
+
+private:
+    constexpr explicit Money(int64_t cents) : cents_(cents) {}
+
+    int64_t cents_ = 0;
+};
+
+/**
+ * fmt / spdlog 输出：fmt::format("{}元", money) → "12.30元"
+ */
+template <>
+struct fmt::formatter<Money> : fmt::formatter<std::string> {
+    template <typename FormatContext>
+    auto format(const Money& money, FormatContext& ctx) const -> decltype(ctx.out()) {
+        return fmt::formatter<std::string>::format(money.ToString(), ctx);
+    }
+};
+
+#endif // MONEY_H
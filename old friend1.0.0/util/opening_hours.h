@@ -0,0 +1,346 @@
+#ifndef OPENING_HOURS_H
+#define OPENING_HOURS_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * 编译后的门诊时间：把自由文本（如 "周一至周五 8:00-17:00，周六 8:00-12:00"）解析为一周内的营业区间
+ * - 时间轴为“周内分钟”：周一 0:00 为 0，周日 24:00 为 10080；区间已排序、合并，跨夜区间拆到次日
+ * - 门诊时间按北京时间（UTC+8，无夏令时）解释，时间戳换算不依赖服务器时区
+ * - 解析只在目录加载时做一次，查询只做一次二分（区间通常不超过十几个）
+ * 支持的写法：
+ * - 日期：周一/星期一/礼拜一、周日/周天、“至/到/-/~”表示范围、“、/”分隔列举、每天/每日、工作日、周末
+ * - 时间：8:00、08：30、8点、8点半、8点30分，上午/下午/晚上（12 小时制时自动换算）、24小时/全天
+ * - “周日休息”“周六停诊”等表示当天不营业；没有日期的时段沿用前一段的日期，第一段没有日期表示每天
+ * - 含“节假日”的段忽略（没有节假日历）
+ */
+class OpeningHours {
+public:
+    static constexpr int kMinutesPerDay = 24 * 60;
+    static constexpr int kMinutesPerWeek = 7 * kMinutesPerDay;
+    static constexpr int64_t kUtcOffsetSeconds = 8 * 3600;  // 北京时间
+
+    struct Interval {
+        int begin;  // 周内分钟，含
+        int end;    // 周内分钟，不含（跨夜时可能超过 kMinutesPerWeek，编译时拆分）
+    };
+
+    OpeningHours() = default;
+
+    /**
+     * 解析门诊时间文本（无法识别时 IsKnown() 为 false）
+     */
+    static OpeningHours Compile(const std::string& text) {
+        OpeningHours result;
+        Parser parser(text);
+        std::vector<Interval> intervals;
+        uint8_t closed_days = 0;
+        if (!parser.Parse(intervals, closed_days)) {
+            return result;
+        }
+        result.known_ = true;
+        // 跨夜区间拆成两段，超出一周的部分回绕到周一
+        std::vector<Interval> flat;
+        for (const auto& item : intervals) {
+            if (closed_days & (1u << (item.begin / kMinutesPerDay))) continue;
+            if (item.end <= kMinutesPerWeek) {
+                flat.push_back(item);
+            } else {
+                flat.push_back(Interval{item.begin, kMinutesPerWeek});
+                flat.push_back(Interval{0, item.end - kMinutesPerWeek});
+            }
+        }
+        std::sort(flat.begin(), flat.end(), [](const Interval& a, const Interval& b) { return a.begin < b.begin; });
+        for (const auto& item : flat) {
+            if (!result.intervals_.empty() && item.begin <= result.intervals_.back().end) {
+                result.intervals_.back().end = std::max(result.intervals_.back().end, item.end);
+            } else {
+                result.intervals_.push_back(item);
+            }
+        }
+        return result;
+    }
+
+    bool IsKnown() const { return known_; }
+
+    // 营业区间（周内分钟，已排序、合并）
+    const std::vector<Interval>& Intervals() const { return intervals_; }
+
+    /**
+     * 某周内分钟是否营业
+     */
+    bool IsOpenAtMinute(int minute_of_week) const {
+        auto it = std::upper_bound(intervals_.begin(), intervals_.end(), minute_of_week,
+            [](int minute, const Interval& item) { return minute < item.begin; });
+        return it != intervals_.begin() && minute_of_week < (it - 1)->end;
+    }
+
+    /**
+     * 某时刻（秒级时间戳，按北京时间）是否营业
+     */
+    bool IsOpenAt(int64_t timestamp) const {
+        return IsOpenAtMinute(MinuteOfWeek(timestamp));
+    }
+
+    /**
+     * 下一次开始营业的时间戳（当前正在营业返回 timestamp；从不营业或无法识别返回 -1）
+     */
+    int64_t NextOpeningTime(int64_t timestamp) const {
+        if (intervals_.empty()) {
+            return -1;
+        }
+        int minute = MinuteOfWeek(timestamp);
+        if (IsOpenAtMinute(minute)) {
+            return timestamp;
+        }
+        auto it = std::upper_bound(intervals_.begin(), intervals_.end(), minute,
+            [](int value, const Interval& item) { return value < item.begin; });
+        int wait = it != intervals_.end() ? it->begin - minute : kMinutesPerWeek - minute + intervals_.front().begin;
+        int64_t minute_start = timestamp - FloorMod(timestamp, 60);
+        return minute_start + static_cast<int64_t>(wait) * 60;
+    }
+
+    /**
+     * 时间戳对应的周内分钟（周一 0:00 为 0，北京时间）
+     * 纪元 1970-01-01 为周四（周内第 3 天），直接取模，不经过 localtime
+     */
+    static int MinuteOfWeek(int64_t timestamp) {
+        int64_t minutes = (timestamp + kUtcOffsetSeconds - FloorMod(timestamp + kUtcOffsetSeconds, 60)) / 60;
+        return static_cast<int>(FloorMod(minutes + 3 * kMinutesPerDay, kMinutesPerWeek));
+    }
+
+private:
+    static int64_t FloorMod(int64_t value, int64_t divisor) {
+        int64_t mod = value % divisor;
+        return mod < 0 ? mod + divisor : mod;
+    }
+
+    /**
+     * 门诊时间文本解析器（按 UTF-8 字节匹配关键字）
+     */
+    class Parser {
+    public:
+        explicit Parser(const std::string& text) : text_(text) {}
+
+        bool Parse(std::vector<Interval>& intervals, uint8_t& closed_days) {
+            uint8_t days = kAllDays;          // 当前段的日期（无日期的段沿用上一段）
+            bool any = false;
+            size_t pos = 0;
+            while (pos <= text_.size()) {
+                size_t end = FindSegmentEnd(pos);
+                Segment segment;
+                ParseSegment(text_.substr(pos, end - pos), segment);
+                if (segment.holiday) {
+                    // 节假日安排依赖节假日历，这里不处理
+                    pos = end + SeparatorLength(end);
+                    if (end >= text_.size()) break;
+                    continue;
+                }
+                if (segment.days != 0) {
+                    days = segment.days;
+                }
+                if (segment.closed && segment.days != 0) {
+                    closed_days |= segment.days;
+                    any = true;
+                }
+                for (const auto& range : segment.ranges) {
+                    for (int d = 0; d < 7; ++d) {
+                        if (days & (1u << d)) {
+                            intervals.push_back(Interval{d * kMinutesPerDay + range.first,
+                                                         d * kMinutesPerDay + range.second});
+                        }
+                    }
+                    any = true;
+                }
+                pos = end + SeparatorLength(end);
+                if (end >= text_.size()) break;
+            }
+            return any;
+        }
+
+    private:
+        static constexpr uint8_t kAllDays = 0x7F;
+
+        struct Segment {
+            uint8_t days = 0;
+            bool closed = false;
+            bool holiday = false;
+            std::vector<std::pair<int, int>> ranges;  // 当天分钟 [begin, end)，end 可能超过 1440（跨夜）
+        };
+
+        size_t FindSegmentEnd(size_t pos) const {
+            static const char* const separators[] = {"，", "；", "。", ",", ";", "\n"};
+            size_t best = text_.size();
+            for (const char* sep : separators) {
+                size_t found = text_.find(sep, pos);
+                if (found != std::string::npos) best = std::min(best, found);
+            }
+            return best;
+        }
+
+        size_t SeparatorLength(size_t pos) const {
+            if (pos >= text_.size()) return 0;
+            return static_cast<unsigned char>(text_[pos]) < 0x80 ? 1 : 3;
+        }
+
+        static bool StartsWith(const std::string& s, size_t pos, const char* prefix) {
+            size_t len = std::char_traits<char>::length(prefix);
+            return s.compare(pos, len, prefix) == 0;
+        }
+
+        static int WeekdayChar(const std::string& s, size_t pos) {
+            static const char* const names[] = {"一", "二", "三", "四", "五", "六", "日", "天", "七"};
+            static const int values[] = {0, 1, 2, 3, 4, 5, 6, 6, 6};
+            for (int i = 0; i < 9; ++i) {
+                if (StartsWith(s, pos, names[i])) return values[i];
+            }
+            return -1;
+        }
+
+        static uint8_t DayRange(int from, int to) {
+            uint8_t mask = 0;
+            for (int d = from;; d = (d + 1) % 7) {
+                mask |= static_cast<uint8_t>(1u << d);
+                if (d == to) break;
+            }
+            return mask;
+        }
+
+        static void ParseSegment(const std::string& s, Segment& segment) {
+            enum class Half { NONE, AM, PM };
+            Half half = Half::NONE;
+            int pending_day = -1;      // 已读到、可能作为范围起点的日期
+            bool day_range = false;    // 日期后出现了范围符
+            int pending_time = -1;     // 已读到、等待结束时间的开始时间
+            bool time_range = false;
+            size_t pos = 0;
+            while (pos < s.size()) {
+                // 日期
+                size_t prefix = 0;
+                if (StartsWith(s, pos, "星期") || StartsWith(s, pos, "礼拜")) prefix = 6;
+                else if (StartsWith(s, pos, "周") && !StartsWith(s, pos, "周末")) prefix = 3;
+                if (prefix != 0 && WeekdayChar(s, pos + prefix) >= 0) {
+                    int day = WeekdayChar(s, pos + prefix);
+                    if (day_range && pending_day >= 0) {
+                        segment.days |= DayRange(pending_day, day);
+                        pending_day = -1;
+                    } else {
+                        segment.days |= static_cast<uint8_t>(1u << day);
+                        pending_day = day;
+                    }
+                    day_range = false;
+                    pos += prefix + 3;
+                    continue;
+                }
+                if (StartsWith(s, pos, "周末")) { segment.days |= DayRange(5, 6); pos += 6; continue; }
+                if (StartsWith(s, pos, "工作日")) { segment.days |= DayRange(0, 4); pos += 9; continue; }
+                if (StartsWith(s, pos, "每天") || StartsWith(s, pos, "每日") || StartsWith(s, pos, "全周")) {
+                    segment.days |= kAllDays;
+                    pos += 6;
+                    continue;
+                }
+                if (StartsWith(s, pos, "节假日") || StartsWith(s, pos, "节日")) {
+                    segment.holiday = true;
+                    pos += StartsWith(s, pos, "节假日") ? 9 : 6;
+                    continue;
+                }
+                // 不营业
+                if (StartsWith(s, pos, "休息") || StartsWith(s, pos, "停诊") || StartsWith(s, pos, "闭诊") ||
+                    StartsWith(s, pos, "不开放")) {
+                    segment.closed = true;
+                    pos += StartsWith(s, pos, "不开放") ? 9 : 6;
+                    continue;
+                }
+                // 全天
+                if (StartsWith(s, pos, "24小时") || StartsWith(s, pos, "全天")) {
+                    segment.ranges.emplace_back(0, kMinutesPerDay);
+                    pos += StartsWith(s, pos, "24小时") ? 8 : 6;
+                    continue;
+                }
+                // 上午/下午/晚上
+                if (StartsWith(s, pos, "上午") || StartsWith(s, pos, "早上")) { half = Half::AM; pos += 6; continue; }
+                if (StartsWith(s, pos, "下午") || StartsWith(s, pos, "晚上")) { half = Half::PM; pos += 6; continue; }
+                // 范围符
+                if (s[pos] == '-' || s[pos] == '~' || StartsWith(s, pos, "至") || StartsWith(s, pos, "到") ||
+                    StartsWith(s, pos, "～") || StartsWith(s, pos, "—") || StartsWith(s, pos, "－") ||
+                    StartsWith(s, pos, "–")) {
+                    if (pending_time >= 0) time_range = true;
+                    else if (pending_day >= 0) day_range = true;
+                    pos += static_cast<unsigned char>(s[pos]) < 0x80 ? 1 : 3;
+                    continue;
+                }
+                // 时间
+                if (s[pos] >= '0' && s[pos] <= '9') {
+                    int minute = ReadTime(s, pos);
+                    if (minute < 0) continue;
+                    if (half == Half::PM && minute < 12 * 60) minute += 12 * 60;
+                    if (time_range && pending_time >= 0) {
+                        int end = minute;
+                        if (end <= pending_time) {
+                            // 下午时段写成 12 小时制（如 "下午2:00-5:00"）已在上面换算；其余视为跨夜
+                            end += kMinutesPerDay;
+                        }
+                        segment.ranges.emplace_back(pending_time, end);
+                        pending_time = -1;
+                        time_range = false;
+                    } else {
+                        pending_time = minute;
+                    }
+                    pending_day = -1;
+                    continue;
+                }
+                // 其他字符（空格、“门诊”等说明文字）跳过一个 UTF-8 字符
+                unsigned char c = static_cast<unsigned char>(s[pos]);
+                pos += c < 0x80 ? 1 : (c >= 0xF0 ? 4 : (c >= 0xE0 ? 3 : 2));
+            }
+        }
+
+        /**
+         * 读取 H[:MM] / H：MM / H点[半|MM分]，返回当天分钟；格式不对返回 -1（pos 已前进）
+         */
+        static int ReadTime(const std::string& s, size_t& pos) {
+            int hour = ReadNumber(s, pos);
+            int minute = 0;
+            if (pos < s.size() && s[pos] == ':') {
+                ++pos;
+                minute = ReadNumber(s, pos);
+            } else if (StartsWith(s, pos, "：")) {
+                pos += 3;
+                minute = ReadNumber(s, pos);
+            } else if (StartsWith(s, pos, "点") || StartsWith(s, pos, "时")) {
+                pos += 3;
+                if (StartsWith(s, pos, "半")) {
+                    minute = 30;
+                    pos += 3;
+                } else if (pos < s.size() && s[pos] >= '0' && s[pos] <= '9') {
+                    minute = ReadNumber(s, pos);
+                    if (StartsWith(s, pos, "分")) pos += 3;
+                }
+            }
+            if (hour < 0 || hour > 24 || minute < 0 || minute > 59 || (hour == 24 && minute != 0)) {
+                return -1;
+            }
+            return hour * 60 + minute;
+        }
+
+        static int ReadNumber(const std::string& s, size_t& pos) {
+            int value = 0;
+            size_t start = pos;
+            while (pos < s.size() && s[pos] >= '0' && s[pos] <= '9' && pos - start < 4) {
+                value = value * 10 + (s[pos] - '0');
+                ++pos;
+            }
+            return pos == start ? -1 : value;
+        }
+
+        const std::string& text_;
+    };
+
+    bool known_ = false;
+    std::vector<Interval> intervals_;
+};
+
+#endif // OPENING_HOURS_H
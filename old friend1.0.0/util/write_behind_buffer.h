@@ -0,0 +1,203 @@
+#ifndef WRITE_BEHIND_BUFFER_H
+#define WRITE_BEHIND_BUFFER_H
+
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+#include <inttypes.h>
+
+/**
+ * 写回参数
+ */
+struct WriteBehindOptions {
+    size_t max_pending = 1024;     // 待写条数达到该值时立即触发刷新
+    int flush_interval_ms = 1000;  // 定时刷新间隔
+    int max_backoff_ms = 30000;    // 刷新失败后的等待上限（从 flush_interval_ms 起指数退避）
+    size_t max_keys = 100000;      // 待写 + 落库中的 key 数上限，超出后丢弃新 key 的更新（已有 key 照常合并）
+};
+
+/**
+ * 时间戳写回缓冲：把高频的“最近使用时间”更新按 key 合并（只保留最大值），由后台线程批量落库
+ * - Touch 只写内存，不访问数据库
+ * - Get 可读到尚未落库（含正在落库）的最新值，供排序等读路径覆盖数据库中的旧值
+ * - 刷新失败时数据并回待写表，按指数退避等待后重试（期间不因待写条数触发刷新），数据库故障时不会被反复冲击；
+ *   故障期间待写 key 数受 max_keys 限制，超出的新 key 丢弃（只影响排序用的最近使用时间）
+ * - 析构时同步刷新剩余数据
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class WriteBehindBuffer {
+public:
+    using Batch = std::vector<std::pair<Key, int64_t>>;
+    using FlushFn = std::function<bool(const Batch& batch)>; // 返回 false 表示写入失败
+
+    explicit WriteBehindBuffer(FlushFn flush_fn, WriteBehindOptions options = WriteBehindOptions())
+        : flush_fn_(std::move(flush_fn)), options_(options) {
+        worker_ = std::thread([this] { FlushLoop(); });
+    }
+
+    ~WriteBehindBuffer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        cv_.notify_all();
+        worker_.join();
+        Flush();
+    }
+
+    WriteBehindBuffer(const WriteBehindBuffer&) = delete;
+    WriteBehindBuffer& operator=(const WriteBehindBuffer&) = delete;
+
+    /**
+     * 记录一次使用（同一 key 多次记录只保留最大时间戳）
+     */
+    void Touch(const Key& key, int64_t timestamp) {
+        bool full = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = pending_.find(key);
+            if (it == pending_.end()) {
+                if (pending_.size() + inflight_.size() >= options_.max_keys) {
+                    ++dropped_;
+                    return;
+                }
+                it = pending_.emplace(key, timestamp).first;
+            } else if (timestamp > it->second) {
+                it->second = timestamp;
+            }
+            full = pending_.size() >= options_.max_pending;
+        }
+        if (full) {
+            cv_.notify_one();
+        }
+    }
+
+    /**
+     * 读取尚未落库的最新时间戳
+     * @return true=存在内存中的值
+     */
+    bool Get(const Key& key, int64_t& timestamp) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(key);
+        if (it != pending_.end()) {
+            timestamp = it->second;
+            return true;
+        }
+        it = inflight_.find(key);
+        if (it != inflight_.end()) {
+            timestamp = it->second;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * 同步刷新一批待写数据
+     * @return 本次成功落库的条数
+     */
+    size_t Flush() {
+        size_t flushed = 0;
+        FlushBatch(flushed);
+        return flushed;
+    }
+
+    size_t PendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+    }
+
+    uint64_t FlushedCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return flushed_;
+    }
+
+    uint64_t FailedFlushCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return failed_flushes_;
+    }
+
+    uint64_t DroppedCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+private:
+    using Table = std::unordered_map<Key, int64_t, Hash>;
+
+    // 刷新一批待写数据，flushed 为成功落库的条数；落库失败返回 false（无数据时返回 true）
+    bool FlushBatch(size_t& flushed) {
+        std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+        Batch batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty()) {
+                return true;
+            }
+            inflight_.swap(pending_);
+            batch.assign(inflight_.begin(), inflight_.end());
+        }
+
+        bool ok = false;
+        try {
+            ok = flush_fn_(batch);
+        } catch (...) {
+            ok = false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ok) {
+            for (const auto& item : inflight_) {
+                int64_t& slot = pending_[item.first];
+                if (item.second > slot) slot = item.second;
+            }
+        }
+        inflight_.clear();
+        if (ok) {
+            flushed_ += batch.size();
+            flushed = batch.size();
+        } else {
+            ++failed_flushes_;
+        }
+        return ok;
+    }
+
+    void FlushLoop() {
+        int backoff_ms = 0; // 上次刷新失败后的等待时间，0 表示上次成功
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            if (backoff_ms > 0) {
+                cv_.wait_for(lock, std::chrono::milliseconds(backoff_ms), [this] { return !running_; });
+            } else {
+                cv_.wait_for(lock, std::chrono::milliseconds(options_.flush_interval_ms), [this] {
+                    return !running_ || pending_.size() >= options_.max_pending;
+                });
+            }
+            if (!running_) break;
+            lock.unlock();
+            size_t flushed = 0;
+            bool ok = FlushBatch(flushed);
+            lock.lock();
+            backoff_ms = ok ? 0 : std::min(std::max(backoff_ms * 2, options_.flush_interval_ms), options_.max_backoff_ms);
+        }
+    }
+
+    FlushFn flush_fn_;                   // 批量落库回调
+    WriteBehindOptions options_;         // 写回参数
+    mutable std::mutex mutex_;           // 保护 pending_ / inflight_
+    std::mutex flush_mutex_;             // 保证同一时刻只有一次刷新
+    std::condition_variable cv_;
+    Table pending_;                      // 待写：key → 最新时间戳
+    Table inflight_;                     // 正在落库的一批（落库完成前仍可被 Get 读到）
+    uint64_t flushed_ = 0;               // 累计落库条数
+    uint64_t failed_flushes_ = 0;        // 累计落库失败次数
+    uint64_t dropped_ = 0;               // 超出 max_keys 被丢弃的更新数
+    bool running_ = true;
+    std::thread worker_;
+};
+
+#endif // WRITE_BEHIND_BUFFER_H